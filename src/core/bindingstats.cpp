@@ -0,0 +1,332 @@
+#include "bindingstats.hpp"
+#include <algorithm>
+
+#include <private/qqmlengine_p.h>
+#include <private/qqmlprofiler_p.h>
+#include <private/qtqmlglobal_p.h>
+#include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qminmax.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtypes.h>
+#include <qurl.h>
+
+#include "generation.hpp"
+#include "logcat.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logBindingStats, "quickshell.bindingstats", QtInfoMsg);
+
+// Evaluations are buffered by the engine until flushed.
+constexpr int FLUSH_INTERVAL = 1000;
+constexpr int SUMMARY_INTERVAL = 30000;
+constexpr qsizetype SUMMARY_ENTRIES = 10;
+
+bool enabledOnLaunch = false;           // NOLINT
+BindingStats* statsInstance = nullptr; // NOLINT
+const int EXT_KEY = 0;
+
+} // namespace
+
+#if QT_CONFIG(qml_debug)
+
+namespace {
+
+constexpr quint64 PROFILER_FEATURES = (1ull << QQmlProfilerDefinitions::ProfileBinding)
+                                    | (1ull << QQmlProfilerDefinitions::ProfileHandlingSignal);
+
+QString describeLocation(const QQmlSourceLocation& location) {
+	auto url = QUrl(location.sourceFile);
+	auto path = url.path();
+
+	// Files in the config are loaded from qs:@/qs/<path>.
+	auto file = url.scheme() == "qs" && path.startsWith("@/qs/") ? path.sliced(5)
+	                                                              : location.sourceFile;
+
+	return QStringLiteral("%1:%2:%3").arg(file).arg(location.line).arg(location.column);
+}
+
+} // namespace
+
+// Owns the profiler attached to a generation's engine, and turns its event ranges into
+// per location stats.
+class BindingStatsExt: public EngineGenerationExt {
+public:
+	explicit BindingStatsExt(EngineGeneration* generation): generation(generation) {
+		BindingStats::instance()->attached.append(this);
+	}
+
+	~BindingStatsExt() override {
+		this->stop();
+		BindingStats::instance()->detach(this);
+	}
+
+	Q_DISABLE_COPY_MOVE(BindingStatsExt);
+
+	void start() {
+		if (this->profiler != nullptr) return;
+
+		this->timer.start();
+		this->profiler = new QQmlProfiler();
+		this->profiler->setTimer(this->timer);
+
+		QObject::connect(
+		    this->profiler,
+		    &QQmlProfiler::dataReady,
+		    this->profiler,
+		    [this](const QVector<QQmlProfilerData>& data, const QQmlProfiler::LocationHash& locations) {
+			    this->onDataReady(data, locations);
+		    }
+		);
+
+		this->profiler->startProfiling(PROFILER_FEATURES);
+		QQmlEnginePrivate::get(this->generation->engine)->profiler = this->profiler;
+	}
+
+	void stop() {
+		if (this->profiler == nullptr) return;
+
+		QQmlEnginePrivate::get(this->generation->engine)->profiler = nullptr;
+
+		// Reports anything left, and stops evaluations currently on the stack from
+		// recording their end.
+		this->profiler->stopProfiling();
+		QObject::disconnect(this->profiler, nullptr, nullptr, nullptr);
+
+		// Evaluations currently on the stack still hold the profiler.
+		this->profiler->deleteLater();
+		this->profiler = nullptr;
+
+		this->locations.clear();
+		this->openRanges.clear();
+	}
+
+	void flush() {
+		if (this->profiler != nullptr) this->profiler->reportData();
+	}
+
+private:
+	struct OpenRange {
+		quintptr locationId = 0;
+		int type = 0;
+		qint64 start = 0;
+	};
+
+	void onDataReady(
+	    const QVector<QQmlProfilerData>& data,
+	    const QQmlProfiler::LocationHash& locations
+	) {
+		// Locations are only reported the first time they are used.
+		for (auto [id, location]: locations.asKeyValueRange()) {
+			this->locations.insert(id, describeLocation(location.location));
+		}
+
+		auto* stats = BindingStats::instance();
+
+		for (const auto& event: data) {
+			if (event.messageType & (1 << QQmlProfilerDefinitions::RangeStart)) {
+				this->openRanges.append({
+				    .locationId = event.locationId,
+				    .type = event.detailType,
+				    .start = event.time,
+				});
+			} else if (event.messageType & (1 << QQmlProfilerDefinitions::RangeEnd)) {
+				// Ranges nest when a binding or handler causes another one to run, in which
+				// case the time of the inner range is also counted for the outer one.
+				if (this->openRanges.isEmpty()) continue;
+				auto range = this->openRanges.takeLast();
+
+				auto kind = range.type == QQmlProfilerDefinitions::HandlingSignal
+				              ? BindingStats::Kind::SignalHandler
+				              : BindingStats::Kind::Binding;
+
+				auto location = this->locations.value(range.locationId);
+				if (location.isEmpty()) location = QStringLiteral("<unknown>");
+
+				stats->record(kind, location, event.time - range.start);
+			}
+		}
+	}
+
+	EngineGeneration* generation;
+	QQmlProfiler* profiler = nullptr;
+	QElapsedTimer timer;
+	QHash<quintptr, QString> locations;
+	QList<OpenRange> openRanges;
+};
+
+#else
+
+class BindingStatsExt: public EngineGenerationExt {
+public:
+	explicit BindingStatsExt(EngineGeneration* /*generation*/) {}
+
+	void start() {}
+	void stop() {}
+	void flush() {}
+};
+
+#endif
+
+BindingStats::BindingStats() {
+	this->flushTimer.setInterval(FLUSH_INTERVAL);
+	this->summaryTimer.setInterval(SUMMARY_INTERVAL);
+
+	QObject::connect(&this->flushTimer, &QTimer::timeout, this, &BindingStats::flush);
+	QObject::connect(&this->summaryTimer, &QTimer::timeout, this, &BindingStats::logSummary);
+}
+
+BindingStats* BindingStats::instance() {
+	if (statsInstance == nullptr) statsInstance = new BindingStats();
+	return statsInstance;
+}
+
+bool BindingStats::isAvailable() {
+#if QT_CONFIG(qml_debug)
+	return true;
+#else
+	return false;
+#endif
+}
+
+void BindingStats::setEnabledOnLaunch(bool enabled) { enabledOnLaunch = enabled; }
+
+void BindingStats::attachIfEnabled(EngineGeneration* generation) {
+	if (enabledOnLaunch) {
+		enabledOnLaunch = false;
+		BindingStats::instance()->setEnabled(true);
+	}
+
+	if (statsInstance != nullptr && statsInstance->enabled) statsInstance->attach(generation);
+}
+
+void BindingStats::setEnabled(bool enabled) {
+	if (enabled == this->enabled) return;
+
+	if (enabled && !BindingStats::isAvailable()) {
+		qCWarning(logBindingStats) << "Binding stats are unavailable as Qt was built without "
+		                              "QML debugging support.";
+		return;
+	}
+
+	this->enabled = enabled;
+
+	if (enabled) {
+		// Generations created while enabled are attached as they are constructed.
+		if (auto* generation = EngineGeneration::currentGeneration()) this->attach(generation);
+
+		this->flushTimer.start();
+		this->summaryTimer.start();
+		this->summaryElapsed.start();
+
+		qCInfo(logBindingStats) << "Collecting binding stats.";
+	} else {
+		for (auto* ext: this->attached) {
+			ext->stop();
+		}
+
+		this->flushTimer.stop();
+		this->summaryTimer.stop();
+
+		qCInfo(logBindingStats) << "Stopped collecting binding stats.";
+	}
+}
+
+QString BindingStats::kindName(Kind kind) {
+	return kind == Kind::Binding ? QStringLiteral("binding") : QStringLiteral("handler");
+}
+
+bool BindingStats::isEnabled() const { return this->enabled; }
+
+void BindingStats::reset() {
+	this->flush();
+	this->bindings.clear();
+	this->handlers.clear();
+	if (this->enabled) this->summaryElapsed.start();
+}
+
+QList<BindingStats::Entry> BindingStats::topEntries(qsizetype count) {
+	this->flush();
+
+	auto entries = this->bindings.values() + this->handlers.values();
+	std::ranges::sort(entries, [](const Entry& a, const Entry& b) { return a.totalNs > b.totalNs; });
+
+	if (entries.length() > count) entries.resize(count);
+	return entries;
+}
+
+void BindingStats::attach(EngineGeneration* generation) {
+	auto* ext = static_cast<BindingStatsExt*>(generation->findExtension(&EXT_KEY));
+
+	if (ext == nullptr) {
+		ext = new BindingStatsExt(generation);
+		generation->registerExtension(&EXT_KEY, ext);
+	}
+
+	ext->start();
+}
+
+void BindingStats::detach(BindingStatsExt* ext) { this->attached.removeOne(ext); }
+
+void BindingStats::flush() {
+	for (auto* ext: this->attached) {
+		ext->flush();
+	}
+}
+
+void BindingStats::record(Kind kind, const QString& location, qint64 ns) {
+	auto& entry = (kind == Kind::Binding ? this->bindings : this->handlers)[location];
+
+	if (entry.count == 0) {
+		entry.kind = kind;
+		entry.location = location;
+	}
+
+	entry.count++;
+	entry.totalNs += ns;
+	entry.maxNs = qMax(entry.maxNs, ns);
+	entry.intervalCount++;
+	entry.intervalNs += ns;
+}
+
+void BindingStats::logSummary() {
+	this->flush();
+
+	auto seconds = static_cast<double>(this->summaryElapsed.restart()) / 1000.0;
+	auto entries = QList<Entry>();
+
+	for (auto* hash: {&this->bindings, &this->handlers}) {
+		for (auto& entry: *hash) {
+			if (entry.intervalCount != 0) entries.append(entry);
+			entry.intervalCount = 0;
+			entry.intervalNs = 0;
+		}
+	}
+
+	if (entries.isEmpty() || seconds <= 0) return;
+
+	std::ranges::sort(entries, [](const Entry& a, const Entry& b) {
+		return a.intervalCount > b.intervalCount;
+	});
+
+	if (entries.length() > SUMMARY_ENTRIES) entries.resize(SUMMARY_ENTRIES);
+
+	auto summary = QStringLiteral("Most evaluated over the last %1s (evaluations/s, total time):")
+	                   .arg(seconds, 0, 'f', 0);
+
+	for (const auto& entry: entries) {
+		summary += QStringLiteral("\n  %1 %2: %3/s, %4ms")
+		               .arg(BindingStats::kindName(entry.kind), entry.location)
+		               .arg(static_cast<double>(entry.intervalCount) / seconds, 0, 'f', 1)
+		               .arg(static_cast<double>(entry.intervalNs) / 1000000.0, 0, 'f', 2);
+	}
+
+	qCInfo(logBindingStats).noquote() << summary;
+}
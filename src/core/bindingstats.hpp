@@ -0,0 +1,80 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+class EngineGeneration;
+class BindingStatsExt;
+
+// Counts binding evaluations and signal handler invocations per source location, along with
+// the time spent in them, using the profiling hooks built into the QML engine.
+//
+// Stats are only collected once enabled with the BindingStats pragma or over IPC, as the
+// hooks record every evaluation. While enabled, a summary of the most frequently evaluated
+// locations is periodically logged under quickshell.bindingstats.
+class BindingStats: public QObject {
+	Q_OBJECT;
+
+public:
+	enum class Kind : quint8 {
+		Binding = 0,
+		SignalHandler = 1,
+	};
+
+	struct Entry {
+		Kind kind = Kind::Binding;
+		QString location;
+		quint64 count = 0;
+		qint64 totalNs = 0;
+		qint64 maxNs = 0;
+		// since the last logged summary
+		quint64 intervalCount = 0;
+		qint64 intervalNs = 0;
+	};
+
+	static BindingStats* instance();
+
+	// Returns false if Qt was built without the QML profiling hooks.
+	static bool isAvailable();
+	// Enables stats from the first generation on. Must be called before it is created.
+	static void setEnabledOnLaunch(bool enabled);
+	// Attaches to the generation's engine if stats are enabled.
+	static void attachIfEnabled(EngineGeneration* generation);
+	static QString kindName(Kind kind);
+
+	void setEnabled(bool enabled);
+	[[nodiscard]] bool isEnabled() const;
+	void reset();
+
+	// Returns up to count entries, ordered by total time spent.
+	QList<Entry> topEntries(qsizetype count);
+
+private slots:
+	void flush();
+	void logSummary();
+
+private:
+	BindingStats();
+
+	void attach(EngineGeneration* generation);
+	void detach(BindingStatsExt* ext);
+	void record(Kind kind, const QString& location, qint64 ns);
+
+	bool enabled = false;
+	QList<BindingStatsExt*> attached;
+	QHash<QString, Entry> bindings;
+	QHash<QString, Entry> handlers;
+	QTimer flushTimer;
+	QTimer summaryTimer;
+	QElapsedTimer summaryElapsed;
+
+	friend class BindingStatsExt;
+};
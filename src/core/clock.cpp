@@ -1,14 +1,32 @@
 #include "clock.hpp"
+#include <array>
+#include <cerrno>
 
 #include <qdatetime.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
 #include <qobject.h>
+#include <qqmlinfo.h>
+#include <qsocketnotifier.h>
 #include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
+#ifdef __linux__
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
 
-SystemClock::SystemClock(QObject* parent): QObject(parent) {
-	QObject::connect(&this->timer, &QTimer::timeout, this, &SystemClock::onTimeout);
-	this->update();
+#include "logcat.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logClock, "quickshell.clock", QtWarningMsg);
+}
+
+SystemClock::SystemClock(QObject* parent): QObject(parent) { this->update(); }
+
+SystemClock::~SystemClock() {
+	if (this->ticker) this->ticker->unsubscribe(this);
 }
 
 bool SystemClock::enabled() const { return this->mEnabled; }
@@ -23,66 +41,185 @@ void SystemClock::setEnabled(bool enabled) {
 SystemClock::Enum SystemClock::precision() const { return this->mPrecision; }
 
 void SystemClock::setPrecision(SystemClock::Enum precision) {
+	if (precision < SystemClock::Hours || precision > SystemClock::Seconds) {
+		qmlWarning(this) << "Invalid clock precision" << static_cast<int>(precision)
+		                 << "- keeping" << this->mPrecision;
+		return;
+	}
+
 	if (precision == this->mPrecision) return;
 	this->mPrecision = precision;
 	emit this->precisionChanged();
 	this->update();
 }
 
-void SystemClock::onTimeout() {
-	this->setTime(this->targetTime);
-	this->schedule(this->targetTime);
+void SystemClock::update() {
+	auto* ticker = this->mEnabled ? SystemClockTicker::forPrecision(this->mPrecision) : nullptr;
+	if (ticker == this->ticker) return;
+
+	if (this->ticker) this->ticker->unsubscribe(this);
+	this->ticker = ticker;
+
+	if (ticker) {
+		ticker->subscribe(this);
+		this->setTime(ticker->date());
+	}
 }
 
-void SystemClock::update() {
-	if (this->mEnabled) {
-		this->setTime(QDateTime::fromMSecsSinceEpoch(0));
-		this->schedule(QDateTime::fromMSecsSinceEpoch(0));
+void SystemClock::setTime(const QDateTime& time) {
+	this->currentTime = time;
+	emit this->dateChanged();
+}
+
+SystemClockTicker* SystemClockTicker::forPrecision(SystemClock::Enum precision) {
+	static auto tickers = std::array<SystemClockTicker*, 3>();
+
+	auto*& ticker = tickers.at(precision - 1);
+	if (!ticker) ticker = new SystemClockTicker(precision);
+	return ticker;
+}
+
+SystemClockTicker::SystemClockTicker(SystemClock::Enum precision): precision(precision) {
+#ifdef __linux__
+	this->timerFd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (this->timerFd == -1) {
+		qCWarning(logClock) << "Failed to create timerfd, falling back to QTimer:"
+		                    << qt_error_string(errno);
 	} else {
-		this->timer.stop();
+		this->notifier = new QSocketNotifier(this->timerFd, QSocketNotifier::Read, this);
+		this->notifier->setEnabled(false);
+
+		QObject::connect(
+		    this->notifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &SystemClockTicker::onTimerActivated
+		);
 	}
+#endif
+
+	this->timer.setSingleShot(true);
+	this->timer.setTimerType(Qt::PreciseTimer);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &SystemClockTicker::onTimeout);
 }
 
-void SystemClock::setTime(const QDateTime& targetTime) {
-	auto currentTime = QDateTime::currentDateTime();
-	auto offset = currentTime.msecsTo(targetTime);
-	this->currentTime = offset > -500 && offset < 500 ? targetTime : currentTime;
-
-	auto time = this->currentTime.time();
-	this->currentTime.setTime(QTime(
-	    this->mPrecision >= SystemClock::Hours ? time.hour() : 0,
-	    this->mPrecision >= SystemClock::Minutes ? time.minute() : 0,
-	    this->mPrecision >= SystemClock::Seconds ? time.second() : 0
-	));
+void SystemClockTicker::subscribe(SystemClock* clock) {
+	if (this->clocks.contains(clock)) return;
+	this->clocks.append(clock);
 
-	emit this->dateChanged();
+	if (this->clocks.length() == 1) {
+		this->targetTime = QDateTime();
+		this->currentTime = this->truncate(QDateTime::currentDateTime());
+		this->schedule();
+	}
+}
+
+void SystemClockTicker::unsubscribe(SystemClock* clock) {
+	this->clocks.removeOne(clock);
+	if (this->clocks.isEmpty()) this->stop();
+}
+
+void SystemClockTicker::onTimerActivated() {
+#ifdef __linux__
+	quint64 expirations = 0;
+
+	if (read(this->timerFd, &expirations, sizeof(expirations)) == -1) {
+		if (errno == EAGAIN) return;
+
+		// The clock was set discontinuously, which also covers resuming from suspend.
+		// The scheduled time no longer means anything, so take the current time instead.
+		if (errno == ECANCELED) this->targetTime = QDateTime();
+		else qCWarning(logClock) << "Failed to read timerfd:" << qt_error_string(errno);
+	}
+#endif
+
+	this->onTimeout();
 }
 
-void SystemClock::schedule(const QDateTime& targetTime) {
-	auto secondPrecision = this->mPrecision >= SystemClock::Seconds;
-	auto minutePrecision = this->mPrecision >= SystemClock::Minutes;
-	auto hourPrecision = this->mPrecision >= SystemClock::Hours;
+void SystemClockTicker::onTimeout() {
+	this->tick();
+	this->schedule();
+}
 
+void SystemClockTicker::tick() {
 	auto currentTime = QDateTime::currentDateTime();
 
-	auto offset = currentTime.msecsTo(targetTime);
+	// Prefer the scheduled time over the actual time to avoid timer skew causing
+	// a clock to display the same second twice.
+	if (this->targetTime.isValid()) {
+		auto offset = currentTime.msecsTo(this->targetTime);
+		if (offset > -500 && offset < 500) currentTime = this->targetTime;
+	}
 
-	// timer skew
-	auto nextTime = offset > 0 && offset < 500 ? targetTime : currentTime;
+	this->currentTime = this->truncate(currentTime);
 
-	auto baseTimeT = nextTime.time();
-	nextTime.setTime(QTime(
-	    hourPrecision ? baseTimeT.hour() : 0,
-	    minutePrecision ? baseTimeT.minute() : 0,
-	    secondPrecision ? baseTimeT.second() : 0
-	));
+	// clocks may be disabled or destroyed by the update of another clock
+	auto clocks = this->clocks;
+	for (auto* clock: clocks) {
+		if (this->clocks.contains(clock)) clock->setTime(this->currentTime);
+	}
+}
 
-	if (secondPrecision) nextTime = nextTime.addSecs(1);
-	else if (minutePrecision) nextTime = nextTime.addSecs(60);
-	else if (hourPrecision) nextTime = nextTime.addSecs(3600);
+void SystemClockTicker::schedule() {
+	// Computed in local time, as hour boundaries are not aligned in UTC for every timezone.
+	auto nextTime = this->currentTime;
 
-	auto delay = currentTime.msecsTo(nextTime);
+	switch (this->precision) {
+	case SystemClock::Seconds: nextTime = nextTime.addSecs(1); break;
+	case SystemClock::Minutes: nextTime = nextTime.addSecs(60); break;
+	case SystemClock::Hours: nextTime = nextTime.addSecs(3600); break;
+	}
 
-	this->timer.start(static_cast<qint32>(delay));
 	this->targetTime = nextTime;
+
+#ifdef __linux__
+	if (this->timerFd != -1) {
+		auto msecs = nextTime.toMSecsSinceEpoch();
+
+		auto spec = itimerspec();
+		spec.it_value.tv_sec = msecs / 1000;
+		spec.it_value.tv_nsec = (msecs % 1000) * 1000000;
+
+		auto flags = TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET;
+		if (timerfd_settime(this->timerFd, flags, &spec, nullptr) == 0) {
+			this->notifier->setEnabled(true);
+			return;
+		}
+
+		qCWarning(logClock) << "Failed to arm timerfd, falling back to QTimer:"
+		                    << qt_error_string(errno);
+
+		this->notifier->setEnabled(false);
+		close(this->timerFd);
+		this->timerFd = -1;
+	}
+#endif
+
+	auto delay = QDateTime::currentDateTime().msecsTo(nextTime);
+	this->timer.start(delay < 0 ? 0 : static_cast<qint32>(delay));
+}
+
+void SystemClockTicker::stop() {
+	this->timer.stop();
+
+#ifdef __linux__
+	if (this->timerFd != -1) {
+		auto spec = itimerspec();
+		timerfd_settime(this->timerFd, 0, &spec, nullptr);
+		this->notifier->setEnabled(false);
+	}
+#endif
+}
+
+QDateTime SystemClockTicker::truncate(QDateTime time) const {
+	auto clockTime = time.time();
+
+	time.setTime(QTime(
+	    clockTime.hour(),
+	    this->precision >= SystemClock::Minutes ? clockTime.minute() : 0,
+	    this->precision >= SystemClock::Seconds ? clockTime.second() : 0
+	));
+
+	return time;
 }
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <qcontainerfwd.h>
 #include <qdatetime.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
+#include <qsocketnotifier.h>
+#include <qtclasshelpermacros.h>
 #include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+class SystemClockTicker;
+
 ///! System clock accessor.
 /// SystemClock is a view into the system's clock.
 /// It updates at hour, minute, or second intervals depending on @@precision.
@@ -23,10 +29,12 @@
 /// }
 /// ```
 ///
-/// > [!WARNING] Clock updates will trigger within 50ms of the system clock changing,
-/// > however this can be either before or after the clock changes (+-50ms). If you
-/// > need a date object, use @@date instead of constructing a new one, or the time
-/// > of the constructed object could be off by up to a second.
+/// All clocks with the same precision update together, just after the system clock
+/// reaches the next second, minute or hour. Clocks also update immediately when the
+/// system clock is changed, or when the system resumes from suspend.
+///
+/// > [!WARNING] If you need a date object, use @@date instead of constructing a new one,
+/// > or the time of the constructed object may not match the clock.
 class SystemClock: public QObject {
 	Q_OBJECT;
 	/// If the clock should update. Defaults to true.
@@ -58,6 +66,8 @@ public:
 	Q_ENUM(Enum);
 
 	explicit SystemClock(QObject* parent = nullptr);
+	~SystemClock() override;
+	Q_DISABLE_COPY_MOVE(SystemClock);
 
 	[[nodiscard]] bool enabled() const;
 	void setEnabled(bool enabled);
@@ -75,17 +85,53 @@ signals:
 	void precisionChanged();
 	void dateChanged();
 
+private:
+	bool mEnabled = true;
+	SystemClock::Enum mPrecision = SystemClock::Seconds;
+	SystemClockTicker* ticker = nullptr;
+	QDateTime currentTime;
+
+	void update();
+	void setTime(const QDateTime& time);
+
+	friend class SystemClockTicker;
+};
+
+// Process wide tick source shared by all enabled SystemClocks of one precision.
+//
+// Ticks are scheduled against the wall clock with a timerfd, which also reports
+// discontinuous clock changes such as the clock being set or the system resuming
+// from suspend. Without timerfd support a QTimer is used instead.
+// The timer is stopped while no clocks are subscribed.
+class SystemClockTicker: public QObject {
+	Q_OBJECT;
+
+public:
+	static SystemClockTicker* forPrecision(SystemClock::Enum precision);
+
+	void subscribe(SystemClock* clock);
+	void unsubscribe(SystemClock* clock);
+
+	[[nodiscard]] QDateTime date() const { return this->currentTime; }
+
 private slots:
+	void onTimerActivated();
 	void onTimeout();
 
 private:
-	bool mEnabled = true;
-	SystemClock::Enum mPrecision = SystemClock::Seconds;
-	QTimer timer;
+	explicit SystemClockTicker(SystemClock::Enum precision);
+
+	void tick();
+	void schedule();
+	void stop();
+	[[nodiscard]] QDateTime truncate(QDateTime time) const;
+
+	SystemClock::Enum precision;
+	QList<SystemClock*> clocks;
 	QDateTime currentTime;
 	QDateTime targetTime;
 
-	void update();
-	void setTime(const QDateTime& targetTime);
-	void schedule(const QDateTime& targetTime);
+	int timerFd = -1;
+	QSocketNotifier* notifier = nullptr;
+	QTimer timer;
 };
@@ -2,11 +2,14 @@
 #include <algorithm>
 #include <utility>
 
+#include <qbytearray.h>
 #include <qcontainerfwd.h>
+#include <qdatastream.h>
 #include <qdebug.h>
 #include <qdir.h>
 #include <qfile.h>
 #include <qfileinfo.h>
+#include <qiodevice.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qnamespace.h>
@@ -25,6 +28,7 @@
 #include "logcat.hpp"
 #include "model.hpp"
 #include "qmlglobal.hpp"
+#include "recovery.hpp"
 
 namespace {
 QS_LOGGING_CATEGORY(logDesktopEntry, "quickshell.desktopentry", QtWarningMsg);
@@ -346,6 +350,34 @@ void DesktopAction::execute() const {
 	DesktopEntry::doExec(this->bCommand.value(), this->entry->bWorkingDirectory.value());
 }
 
+QDataStream& operator<<(QDataStream& stream, const DesktopActionData& data) {
+	stream << data.id << data.name << data.icon << data.execString << data.command << data.entries;
+	return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, DesktopActionData& data) {
+	stream >> data.id >> data.name >> data.icon >> data.execString >> data.command >> data.entries;
+	return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const ParsedDesktopEntryData& data) {
+	stream << data.id << data.name << data.genericName << data.startupClass << data.noDisplay
+	       << data.hidden << data.comment << data.icon << data.execString << data.command
+	       << data.workingDirectory << data.terminal << data.categories << data.keywords
+	       << data.entries << data.actions;
+
+	return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, ParsedDesktopEntryData& data) {
+	stream >> data.id >> data.name >> data.genericName >> data.startupClass >> data.noDisplay
+	    >> data.hidden >> data.comment >> data.icon >> data.execString >> data.command
+	    >> data.workingDirectory >> data.terminal >> data.categories >> data.keywords >> data.entries
+	    >> data.actions;
+
+	return stream;
+}
+
 DesktopEntryScanner::DesktopEntryScanner(DesktopEntryManager* manager): manager(manager) {
 	this->setAutoDelete(true);
 }
@@ -411,7 +443,36 @@ DesktopEntryManager::DesktopEntryManager(): monitor(new DesktopEntryMonitor(this
 	    &DesktopEntryManager::handleFileChanges
 	);
 
-	DesktopEntryScanner(this).run();
+	auto* recovery = RecoverySnapshot::instance();
+	auto recovered = QList<ParsedDesktopEntryData>();
+	auto stream = QDataStream(recovery->take("desktopEntries"));
+	stream >> recovered;
+
+	recovery->addSource("desktopEntries", [this]() { return this->recoverySection; });
+
+	if (recovered.isEmpty()) {
+		DesktopEntryScanner(this).run();
+	} else {
+		// Entries from before a crash are used until a full scan completes in the background.
+		this->onScanCompleted(recovered);
+		this->scanDesktopEntries();
+	}
+}
+
+QByteArray DesktopEntryManager::buildRecoverySection() const {
+	if (this->desktopEntries.isEmpty()) return QByteArray();
+
+	auto entries = QList<ParsedDesktopEntryData>();
+	entries.reserve(this->desktopEntries.size());
+
+	for (auto* entry: this->desktopEntries) {
+		entries.append(entry->state);
+	}
+
+	auto data = QByteArray();
+	auto stream = QDataStream(&data, QIODevice::WriteOnly);
+	stream << entries;
+	return data;
 }
 
 void DesktopEntryManager::scanDesktopEntries() {
@@ -582,6 +643,7 @@ void DesktopEntryManager::onScanCompleted(const QList<ParsedDesktopEntryData>& s
 		if (!entry->bNoDisplay) newApplications.append(entry);
 
 	this->mApplications.diffUpdate(newApplications);
+	this->recoverySection = this->buildRecoverySection();
 
 	emit this->applicationsChanged();
 
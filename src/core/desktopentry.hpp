@@ -3,6 +3,7 @@
 #include <utility>
 
 #include <qcontainerfwd.h>
+#include <qdatastream.h>
 #include <qdir.h>
 #include <qhash.h>
 #include <qobject.h>
@@ -13,6 +14,7 @@
 
 #include "desktopentrymonitor.hpp"
 #include "doc.hpp"
+#include "memorystats.hpp"
 #include "model.hpp"
 
 class DesktopAction;
@@ -46,6 +48,11 @@ struct ParsedDesktopEntryData {
 	QVector<DesktopActionData> actions;
 };
 
+QDataStream& operator<<(QDataStream& stream, const DesktopActionData& data);
+QDataStream& operator>>(QDataStream& stream, DesktopActionData& data);
+QDataStream& operator<<(QDataStream& stream, const ParsedDesktopEntryData& data);
+QDataStream& operator>>(QDataStream& stream, ParsedDesktopEntryData& data);
+
 /// A desktop entry. See @@DesktopEntries for details.
 class DesktopEntry: public QObject {
 	Q_OBJECT;
@@ -168,8 +175,10 @@ private:
 
 	ParsedDesktopEntryData state;
 	QVector<DesktopAction*> mActions;
+	LiveObjectCount<"DesktopEntry"> liveCount;
 
 	friend class DesktopAction;
+	friend class DesktopEntryManager;
 };
 
 /// An action of a @@DesktopEntry$.
@@ -274,12 +283,16 @@ private slots:
 private:
 	explicit DesktopEntryManager();
 
+	[[nodiscard]] QByteArray buildRecoverySection() const;
+
 	QHash<QString, DesktopEntry*> desktopEntries;
 	QHash<QString, DesktopEntry*> lowercaseDesktopEntries;
 	ObjectModel<DesktopEntry> mApplications {this};
 	DesktopEntryMonitor* monitor = nullptr;
 	bool scanInProgress = false;
 	bool scanQueued = false;
+	// entries only change when a scan completes, so the snapshot section is built there
+	QByteArray recoverySection;
 
 	friend class DesktopEntryScanner;
 };
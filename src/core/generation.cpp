@@ -19,10 +19,12 @@
 #include <qquickwindow.h>
 #include <qtmetamacros.h>
 
+#include "bindingstats.hpp"
 #include "iconimageprovider.hpp"
 #include "imageprovider.hpp"
 #include "incubator.hpp"
 #include "logcat.hpp"
+#include "memorystats.hpp"
 #include "plugin.hpp"
 #include "qsintercept.hpp"
 #include "reload.hpp"
@@ -57,6 +59,7 @@ EngineGeneration::EngineGeneration(const QDir& rootPath, QmlScanner scanner)
 	this->engine->addImageProvider("qspixmap", new QsPixmapProvider());
 
 	QsEnginePlugin::runConstructGeneration(*this);
+	BindingStats::attachIfEnabled(this);
 }
 
 EngineGeneration::EngineGeneration(): EngineGeneration(QDir(), QmlScanner()) {}
@@ -152,6 +155,7 @@ void EngineGeneration::onReload(EngineGeneration* old) {
 	if (old != nullptr) {
 		QObject::connect(old, &QObject::destroyed, this, [this]() { this->postReload(); });
 		old->destroy();
+		MemoryStats::scheduleReloadLog();
 	} else {
 		this->postReload();
 	}
@@ -321,6 +325,8 @@ EngineGeneration* EngineGeneration::currentGeneration() {
 	} else return nullptr;
 }
 
+QList<EngineGeneration*> EngineGeneration::generations() { return g_generations.values(); }
+
 EngineGeneration* EngineGeneration::findEngineGeneration(const QQmlEngine* engine) {
 	return g_generations.value(engine);
 }
@@ -54,6 +54,9 @@ public:
 	// otherwise null.
 	static EngineGeneration* currentGeneration();
 
+	// Returns every generation which has not finished destruction.
+	static QList<EngineGeneration*> generations();
+
 	RootWrapper* wrapper = nullptr;
 	QDir rootPath;
 	QmlScanner scanner;
@@ -72,6 +75,8 @@ public:
 	void destroy();
 	void shutdown();
 
+	[[nodiscard]] bool isDestroying() const { return this->destroying; }
+
 signals:
 	void filesChanged();
 	void reloadFinished();
@@ -1,52 +1,363 @@
 #include "iconimageprovider.hpp"
 #include <algorithm>
+#include <cstring>
+#include <utility>
 
+#include <qbytearray.h>
+#include <qcache.h>
 #include <qcolor.h>
+#include <qcryptographichash.h>
+#include <qdatetime.h>
+#include <qdir.h>
+#include <qelapsedtimer.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qguiapplication.h>
 #include <qicon.h>
+#include <qimage.h>
+#include <qiodevice.h>
+#include <qlist.h>
 #include <qlogging.h>
+#include <qloggingcategory.h>
 #include <qpainter.h>
 #include <qpixmap.h>
+#include <qrunnable.h>
+#include <qsavefile.h>
 #include <qsize.h>
 #include <qstring.h>
+#include <qthreadpool.h>
+#include <qtimer.h>
+#include <qtypes.h>
 
-QPixmap
-IconImageProvider::requestPixmap(const QString& id, QSize* size, const QSize& requestedSize) {
+#include "logcat.hpp"
+#include "paths.hpp"
+
+namespace {
+
+QS_LOGGING_CATEGORY(logIconCache, "quickshell.iconprovider.cache", QtWarningMsg);
+
+// Icons are often requested in bursts, such as when a launcher opens.
+constexpr int DISK_WRITE_DELAY = 1000;
+
+struct IconRequest {
 	QString iconName;
 	QString fallbackName;
 	QString path;
+};
+
+IconRequest parseRequest(const QString& id) {
+	IconRequest request;
 
 	auto splitIdx = id.indexOf("?path=");
 	if (splitIdx != -1) {
-		iconName = id.sliced(0, splitIdx);
-		path = id.sliced(splitIdx + 6);
-		path = QString("/%1/%2").arg(path, iconName.sliced(iconName.lastIndexOf('/') + 1));
+		request.iconName = id.sliced(0, splitIdx);
+		auto path = id.sliced(splitIdx + 6);
+		auto name = request.iconName.sliced(request.iconName.lastIndexOf('/') + 1);
+		request.path = QString("/%1/%2").arg(path, name);
 	} else {
 		splitIdx = id.indexOf("?fallback=");
 		if (splitIdx != -1) {
-			iconName = id.sliced(0, splitIdx);
-			fallbackName = id.sliced(splitIdx + 10);
+			request.iconName = id.sliced(0, splitIdx);
+			request.fallbackName = id.sliced(splitIdx + 10);
 		} else {
-			iconName = id;
+			request.iconName = id;
+		}
+	}
+
+	return request;
+}
+
+struct DiskHeader {
+	char magic[4] = {'Q', 'S', 'I', 'C'}; // NOLINT
+	quint32 width = 0;
+	quint32 height = 0;
+	quint32 bytesPerLine = 0;
+	qreal devicePixelRatio = 1;
+};
+
+// Writes a batch of disk cache entries off the gui thread.
+class IconCacheWriter: public QRunnable {
+public:
+	struct Entry {
+		QString path;
+		QImage image;
+	};
+
+	IconCacheWriter(QDir iconsDir, QString themeSignature, bool prepareDir, QList<Entry> entries)
+	    : iconsDir(std::move(iconsDir))
+	    , themeSignature(std::move(themeSignature))
+	    , prepareDir(prepareDir)
+	    , entries(std::move(entries)) {}
+
+	void run() override {
+		if (this->prepareDir) {
+			// Entries for previous theme states will never be read again.
+			for (const auto& entry: this->iconsDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+				if (entry != this->themeSignature) {
+					QDir(this->iconsDir.filePath(entry)).removeRecursively();
+				}
+			}
+
+			this->iconsDir.mkpath(this->themeSignature);
+		}
+
+		for (const auto& entry: this->entries) {
+			auto image = entry.image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+			auto header = DiskHeader();
+			header.width = image.width();
+			header.height = image.height();
+			header.bytesPerLine = image.bytesPerLine();
+			header.devicePixelRatio = image.devicePixelRatio();
+
+			auto file = QSaveFile(entry.path);
+			if (!file.open(QIODevice::WriteOnly)) continue;
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(DiskHeader));
+			file.write(reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes());
+
+			if (!file.commit()) {
+				qCDebug(logIconCache) << "Failed to write icon cache entry" << file.fileName();
+			}
 		}
 	}
 
-	auto icon = QIcon::fromTheme(iconName);
-	if (icon.isNull() && !fallbackName.isEmpty()) icon = QIcon::fromTheme(fallbackName);
-	if (icon.isNull() && !path.isEmpty()) icon = QPixmap(path);
+private:
+	QDir iconsDir;
+	QString themeSignature;
+	bool prepareDir;
+	QList<Entry> entries;
+};
+
+// Caches resolved icons and rasterized pixmaps for theme icons across reloads.
+// Pixmaps for requests with an explicit path are not cached, as the files are usually
+// owned by a running application and may change at any time.
+class IconCache {
+public:
+	static IconCache* instance() {
+		static auto* instance = new IconCache();
+		return instance;
+	}
+
+	QIcon icon(const IconRequest& request) {
+		this->checkTheme();
+
+		auto key = request.iconName + '\n' + request.fallbackName;
+		if (auto* icon = this->icons.object(key)) return *icon;
+
+		auto icon = QIcon::fromTheme(request.iconName);
+		if (icon.isNull() && !request.fallbackName.isEmpty()) {
+			icon = QIcon::fromTheme(request.fallbackName);
+		}
+
+		this->icons.insert(key, new QIcon(icon));
+		return icon;
+	}
+
+	bool pixmap(const QString& key, QPixmap* pixmap) {
+		this->checkTheme();
+
+		if (auto* cached = this->pixmaps.object(key)) {
+			this->stats.memoryHits++;
+			*pixmap = *cached;
+			return true;
+		}
+
+		if (this->diskCacheEnabled && this->readDiskEntry(key, pixmap)) {
+			this->stats.diskHits++;
+			this->insertMemory(key, *pixmap);
+			return true;
+		}
+
+		this->stats.misses++;
+		return false;
+	}
+
+	void insertPixmap(const QString& key, const QPixmap& pixmap) {
+		this->insertMemory(key, pixmap);
+		if (this->diskCacheEnabled) this->writeDiskEntry(key, pixmap);
+	}
+
+	bool diskCacheEnabled = false;
+
+private:
+	void insertMemory(const QString& key, const QPixmap& pixmap) {
+		auto cost = std::max<qsizetype>(1, pixmap.width() * pixmap.height() * 4 / 1024);
+		this->pixmaps.insert(key, new QPixmap(pixmap), cost);
+	}
+
+	// Changes to the icon theme or the contents of its directories invalidate all cached
+	// lookups. Directory mtimes change when icons are added or an icon cache is regenerated.
+	void checkTheme() {
+		if (this->lastThemeCheck.isValid() && this->lastThemeCheck.elapsed() < 5000) return;
+		this->lastThemeCheck.start();
+		this->logStats();
+
+		auto themes = QList<QString> {QIcon::themeName(), QIcon::fallbackThemeName(), "hicolor"};
+		auto hash = QCryptographicHash(QCryptographicHash::Sha1);
+
+		for (const auto& theme: themes) {
+			hash.addData(theme.toUtf8());
+
+			for (const auto& searchPath: QIcon::themeSearchPaths()) {
+				auto mtime = QFileInfo(QDir(searchPath).filePath(theme)).lastModified();
+				hash.addData(QByteArray::number(mtime.toMSecsSinceEpoch()));
+			}
+		}
+
+		for (const auto& searchPath: QIcon::fallbackSearchPaths()) {
+			hash.addData(QByteArray::number(QFileInfo(searchPath).lastModified().toMSecsSinceEpoch()));
+		}
+
+		auto signature = QString::fromLatin1(hash.result().toHex().left(16));
+		if (signature == this->themeSignature) return;
+
+		if (!this->themeSignature.isEmpty()) {
+			qCDebug(logIconCache) << "Icon theme changed, clearing icon cache.";
+		}
+
+		this->themeSignature = signature;
+		this->icons.clear();
+		this->pixmaps.clear();
+		this->pendingWrites.clear();
+		this->diskDirReady = false;
+	}
+
+	void logStats() {
+		auto requests = this->stats.memoryHits + this->stats.diskHits + this->stats.misses;
+		if (requests == this->loggedRequests) return;
+		this->loggedRequests = requests;
+
+		qCDebug(logIconCache).nospace() << "Pixmap cache: " << this->stats.memoryHits
+		                                << " memory hits, " << this->stats.diskHits << " disk hits, "
+		                                << this->stats.misses << " misses";
+	}
+
+	static QDir iconsDir() { return QDir(QsPaths::instance()->shellCacheDir().filePath("icons")); }
+
+	QString diskEntryPath(const QString& key) {
+		auto name = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+		return IconCache::iconsDir().filePath(QString("%1/%2").arg(this->themeSignature, name));
+	}
+
+	bool readDiskEntry(const QString& key, QPixmap* pixmap) {
+		auto file = QFile(this->diskEntryPath(key));
+		if (!file.open(QIODevice::ReadOnly)) return false;
+
+		auto header = DiskHeader();
+		auto expectedMagic = DiskHeader();
+
+		if (file.read(reinterpret_cast<char*>(&header), sizeof(DiskHeader)) != sizeof(DiskHeader)
+		    || memcmp(header.magic, expectedMagic.magic, sizeof(header.magic)) != 0)
+		{
+			return false;
+		}
+
+		auto image = QImage(
+		    static_cast<int>(header.width),
+		    static_cast<int>(header.height),
+		    QImage::Format_ARGB32_Premultiplied
+		);
+
+		if (image.isNull() || static_cast<quint32>(image.bytesPerLine()) != header.bytesPerLine) {
+			return false;
+		}
+
+		if (file.read(reinterpret_cast<char*>(image.bits()), image.sizeInBytes())
+		    != image.sizeInBytes())
+		{
+			return false;
+		}
+
+		image.setDevicePixelRatio(header.devicePixelRatio);
+		*pixmap = QPixmap::fromImage(std::move(image));
+		return true;
+	}
+
+	// Entries are written in batches on the thread pool, as encoding and writing them can
+	// take long enough to drop frames.
+	void writeDiskEntry(const QString& key, const QPixmap& pixmap) {
+		// QPixmap can only be used on the gui thread.
+		this->pendingWrites.append({.path = this->diskEntryPath(key), .image = pixmap.toImage()});
+
+		if (this->pendingWrites.length() == 1) {
+			QTimer::singleShot(DISK_WRITE_DELAY, [this]() { this->flushDiskWrites(); });
+		}
+	}
+
+	void flushDiskWrites() {
+		if (this->pendingWrites.isEmpty()) return;
+
+		auto* writer = new IconCacheWriter(
+		    IconCache::iconsDir(),
+		    this->themeSignature,
+		    !this->diskDirReady,
+		    this->pendingWrites
+		);
+
+		this->pendingWrites.clear();
+		this->diskDirReady = true;
+		QThreadPool::globalInstance()->start(writer); // takes ownership
+	}
+
+	QCache<QString, QIcon> icons {512};
+	// Cost is in KiB.
+	QCache<QString, QPixmap> pixmaps {32 * 1024};
+	QElapsedTimer lastThemeCheck;
+	QString themeSignature;
+	bool diskDirReady = false;
+	QList<IconCacheWriter::Entry> pendingWrites;
+
+	struct {
+		quint64 memoryHits = 0;
+		quint64 diskHits = 0;
+		quint64 misses = 0;
+	} stats;
+
+	quint64 loggedRequests = 0;
+};
+
+} // namespace
+
+QPixmap
+IconImageProvider::requestPixmap(const QString& id, QSize* size, const QSize& requestedSize) {
+	auto request = parseRequest(id);
+	auto* cache = IconCache::instance();
+	auto cacheable = request.path.isEmpty();
 
 	auto targetSize = requestedSize.isValid() ? requestedSize : QSize(100, 100);
 	if (targetSize.width() == 0 || targetSize.height() == 0) targetSize = QSize(2, 2);
-	auto pixmap = icon.pixmap(targetSize.width(), targetSize.height());
 
-	if (pixmap.isNull()) {
-		qWarning() << "Could not load icon" << id << "at size" << targetSize << "from request";
-		pixmap = IconImageProvider::missingPixmap(targetSize);
+	auto cacheKey = QString("%1@%2x%3@%4")
+	                    .arg(id)
+	                    .arg(targetSize.width())
+	                    .arg(targetSize.height())
+	                    .arg(qGuiApp->devicePixelRatio());
+
+	QPixmap pixmap;
+
+	if (!cacheable || !cache->pixmap(cacheKey, &pixmap)) {
+		auto icon = cache->icon(request);
+		if (icon.isNull() && !request.path.isEmpty()) icon = QPixmap(request.path);
+
+		pixmap = icon.pixmap(targetSize.width(), targetSize.height());
+
+		if (pixmap.isNull()) {
+			qWarning() << "Could not load icon" << id << "at size" << targetSize << "from request";
+			pixmap = IconImageProvider::missingPixmap(targetSize);
+		} else if (cacheable) {
+			cache->insertPixmap(cacheKey, pixmap);
+		}
 	}
 
 	if (size != nullptr) *size = pixmap.size();
 	return pixmap;
 }
 
+void IconImageProvider::setDiskCacheEnabled(bool enabled) {
+	IconCache::instance()->diskCacheEnabled = enabled;
+}
+
 QPixmap IconImageProvider::missingPixmap(const QSize& size) {
 	auto width = size.width() % 2 == 0 ? size.width() : size.width() + 1;
 	auto height = size.height() % 2 == 0 ? size.height() : size.height() + 1;
@@ -16,4 +16,7 @@ public:
 	    const QString& path = QString(),
 	    const QString& fallback = QString()
 	);
+
+	// Persist rasterized theme icons in the shell cache dir, in addition to the in-memory cache.
+	static void setDiskCacheEnabled(bool enabled);
 };
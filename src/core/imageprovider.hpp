@@ -8,6 +8,8 @@
 #include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 
+#include "memorystats.hpp"
+
 class QsImageProvider: public QQuickImageProvider {
 public:
 	explicit QsImageProvider(): QQuickImageProvider(QQuickImageProvider::Image) {}
@@ -34,6 +36,7 @@ public:
 private:
 	QQmlImageProviderBase::ImageType type;
 	QString id;
+	LiveObjectCount<"QsImageHandle"> liveCount;
 };
 
 class QsIndexedImageHandle: public QsImageHandle {
@@ -1,22 +1,40 @@
 #include "incubator.hpp"
+#include <algorithm>
+#include <utility>
 
 #include <private/qsgrenderloop_p.h>
 #include <qabstractanimation.h>
+#include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
 #include <qguiapplication.h>
+#include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qminmax.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qobjectdefs.h>
+#include <qpointer.h>
+#include <qqmlengine.h>
 #include <qqmlincubator.h>
 #include <qscreen.h>
+#include <qstring.h>
+#include <qstringbuilder.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "logcat.hpp"
+#include "startuptrace.hpp"
 
 QS_LOGGING_CATEGORY(logIncubator, "quickshell.incubator", QtWarningMsg);
 
+namespace {
+QS_LOGGING_CATEGORY(logIncubatorCost, "quickshell.incubator.cost", QtWarningMsg);
+
+constexpr int EVENT_LOOP_BUDGET = 10;
+constexpr int MAX_EVENT_LOOP_BUDGET = 16;
+} // namespace
+
 void QsQmlIncubator::statusChanged(QQmlIncubator::Status status) {
 	switch (status) {
 	case QQmlIncubator::Ready: emit this->completed(); break;
@@ -25,6 +43,12 @@ void QsQmlIncubator::statusChanged(QQmlIncubator::Status status) {
 	}
 }
 
+QsIncubationController::~QsIncubationController() {
+	if (logIncubatorCost().isDebugEnabled() && !this->costs.isEmpty()) {
+		qCDebug(logIncubatorCost).noquote() << this->costReport();
+	}
+}
+
 void QsIncubationController::initLoop() {
 	auto* app = static_cast<QGuiApplication*>(QGuiApplication::instance()); // NOLINT
 	this->renderLoop = QSGRenderLoop::instance();
@@ -72,10 +96,14 @@ void QsIncubationController::setIncubationMode(bool render) {
 
 	if (render) {
 		qCDebug(logIncubator) << "Incubation mode changed: render loop driven";
+		this->budget = this->incubationTime;
 	} else {
 		qCDebug(logIncubator) << "Incubation mode changed: event loop driven";
+		this->budget = EVENT_LOOP_BUDGET;
 	}
 
+	this->lastSlice.invalidate();
+
 	if (!render && this->incubatingObjectCount()) this->incubateLater();
 }
 
@@ -94,30 +122,228 @@ void QsIncubationController::incubateLater() {
 
 		// Incubate again at the end of the event processing queue
 		QMetaObject::invokeMethod(this, &QsIncubationController::incubate, Qt::QueuedConnection);
+		this->timerInterval = 0;
 	} else if (this->timerId == 0) {
 		// Wait for a while before processing the next batch. Using a
-		// timer to avoid starvation of system events.
-		this->timerId = this->startTimer(this->incubationTime);
+		// timer to avoid starvation of system events. Incubators with
+		// a deadline skip the wait.
+		this->timerInterval = this->hasUrgentIncubators() ? 0 : this->incubationTime;
+		this->timerId = this->startTimer(this->timerInterval);
 	}
 }
 
 void QsIncubationController::incubate() {
 	if ((!this->followRenderloop || this->renderLoop) && this->incubatingObjectCount()) {
-		if (!this->followRenderloop) {
-			this->incubateFor(10);
-			if (this->incubatingObjectCount()) this->incubateLater();
-		} else if (this->renderLoop->interleaveIncubation()) {
-			this->incubateFor(this->incubationTime);
-		} else {
-			this->incubateFor(this->incubationTime * 2);
-			if (this->incubatingObjectCount()) this->incubateLater();
+		auto interleaved = this->followRenderloop && this->renderLoop->interleaveIncubation();
+		auto budget = this->followRenderloop && !interleaved ? this->budget * 2 : this->budget;
+
+		// Measure how long it took to get back to incubation compared to how long it
+		// should have taken if nothing else needed the thread.
+		if (this->lastSlice.isValid()) {
+			auto expected = interleaved ? this->frameTime : budget + this->timerInterval;
+			this->adaptBudget(this->lastSlice.nsecsElapsed(), static_cast<qint64>(expected) * 1000000);
 		}
+
+		this->lastSlice.start();
+		this->incubateSlice(budget);
+
+		if (!interleaved && this->incubatingObjectCount()) this->incubateLater();
+	}
+}
+
+void QsIncubationController::incubateSlice(int budget) {
+	budget = this->urgentBudget(budget);
+	if (!this->incubatingObjectCount()) return;
+
+	auto loading = QList<QsQmlIncubator*>();
+	for (auto& entry: this->tracked) {
+		if (entry.incubator && entry.incubator->isLoading()) loading.append(entry.incubator);
 	}
+
+	auto span = StartupSpan("incubation", QStringLiteral("incubation slice"));
+	this->beginSlice(std::move(loading));
+	this->incubateFor(budget);
+	this->endSlice();
+}
+
+// The engine does not report which incubators a slice worked on, so slice time is
+// split evenly between every tracked incubator that was loading during the slice.
+void QsIncubationController::beginSlice(QList<QsQmlIncubator*> incubators) {
+	this->sliceIncubators = std::move(incubators);
+	this->sliceTimer.start();
+}
+
+void QsIncubationController::endSlice() {
+	if (!this->sliceIncubators.isEmpty()) {
+		auto share = this->sliceTimer.nsecsElapsed() / this->sliceIncubators.size();
+
+		for (auto* incubator: this->sliceIncubators) {
+			auto entry = this->tracked.find(incubator);
+			if (entry != this->tracked.end()) entry->activeNs += share;
+		}
+	}
+
+	this->sliceIncubators.clear();
+	this->sliceTimer.invalidate();
+}
+
+void QsIncubationController::adaptBudget(qint64 intervalNs, qint64 expectedNs) {
+	// Much longer gaps mean nothing was driving incubation, not that it was delayed.
+	if (intervalNs > expectedNs * 4) return;
+
+	auto maxBudget = this->followRenderloop ? qMax(1, this->frameTime / 2) : MAX_EVENT_LOOP_BUDGET;
+
+	if (intervalNs > expectedNs + expectedNs / 2) {
+		// Frames or other events were delayed, back off quickly.
+		this->budget = qMax(1, this->budget / 2);
+	} else {
+		this->budget = qMin(maxBudget, this->budget + 1);
+	}
+}
+
+bool QsIncubationController::hasUrgentIncubators() const {
+	for (const auto& entry: this->tracked) {
+		if (entry.incubator && !entry.incubator->deadline().isForever()) return true;
+	}
+
+	return false;
+}
+
+int QsIncubationController::urgentBudget(int budget) {
+	auto expired = QList<QPointer<QsQmlIncubator>>();
+	auto interval = this->followRenderloop ? this->frameTime : this->budget + this->timerInterval;
+
+	for (auto& entry: this->tracked) {
+		auto* incubator = entry.incubator.data();
+		if (!incubator || incubator->deadline().isForever()) continue;
+
+		auto remaining = incubator->deadline().remainingTime();
+		if (remaining <= 0) {
+			expired.append(incubator);
+			continue;
+		}
+
+		auto cost = this->costs.value(incubator->name());
+
+		if (cost.count == 0) {
+			// Without a previous load to go off of, front load as much as possible.
+			budget = qMax(budget, qMax(1, this->frameTime / 2));
+			continue;
+		}
+
+		// Spread the remaining expected work over the slices left before the deadline.
+		auto remainingNs = cost.averageNs() - entry.activeNs;
+		if (remainingNs <= 0) continue;
+
+		auto slices = qMax(1ll, remaining / qMax(1, interval));
+		auto needed = static_cast<int>(remainingNs / 1000000 / slices) + 1;
+		budget = qMax(budget, qMin(needed, this->frameTime));
+	}
+
+	for (auto& incubator: expired) {
+		if (!incubator || !incubator->isLoading()) continue;
+
+		qCDebug(logIncubator) << "Forcing completion of" << incubator->name()
+		                      << "as its deadline has passed";
+
+		this->beginSlice({incubator.data()});
+		incubator->forceCompletion();
+		this->endSlice();
+	}
+
+	return budget;
+}
+
+void QsIncubationController::track(QQmlEngine* engine, QsQmlIncubator* incubator) {
+	if (!engine) return;
+
+	auto* controller = dynamic_cast<QsIncubationController*>(engine->incubationController());
+	if (controller) controller->track(incubator);
+}
+
+void QsIncubationController::track(QsQmlIncubator* incubator) {
+	// synchronous incubation will already be done
+	if (!incubator->isLoading() || this->tracked.contains(incubator)) return;
+
+	auto& entry = this->tracked[incubator];
+	entry.incubator = incubator;
+	entry.started.start();
+
+	auto onCompleted = [this, incubator]() { this->onIncubatorFinished(incubator, true); };
+	auto onFailed = [this, incubator]() { this->onIncubatorFinished(incubator, false); };
+	auto onDestroyed = [this, incubator]() { this->tracked.remove(incubator); };
+
+	QObject::connect(incubator, &QsQmlIncubator::completed, this, onCompleted);
+	QObject::connect(incubator, &QsQmlIncubator::failed, this, onFailed);
+	QObject::connect(incubator, &QObject::destroyed, this, onDestroyed);
+
+	// Don't leave an incubator with a deadline waiting out the event loop timer.
+	if (!incubator->deadline().isForever() && !this->followRenderloop && this->timerId != 0) {
+		this->killTimer(this->timerId);
+		this->timerId = 0;
+		this->incubateLater();
+	}
+}
+
+void QsIncubationController::onIncubatorFinished(QsQmlIncubator* incubator, bool success) {
+	if (!this->tracked.contains(incubator)) return;
+
+	// Finishing during a slice means the rest of the slice wasn't spent on this incubator.
+	if (this->sliceIncubators.removeOne(incubator)) {
+		this->tracked[incubator].activeNs +=
+		    this->sliceTimer.nsecsElapsed() / (this->sliceIncubators.size() + 1);
+	}
+
+	auto entry = this->tracked.take(incubator);
+	QObject::disconnect(incubator, nullptr, this, nullptr);
+
+	if (!success) return;
+
+	auto& cost = this->costs[incubator->name()];
+	cost.count++;
+	cost.totalNs += entry.activeNs;
+	cost.maxNs = qMax(cost.maxNs, entry.activeNs);
+
+	qCDebug(logIncubatorCost).nospace()
+	    << "Incubated " << incubator->name() << " with " << entry.activeNs / 1000
+	    << "us of work over " << entry.started.elapsed() << "ms";
+
+	if (StartupTrace::isRecording()) {
+		StartupTrace::addSpan(
+		    "incubation",
+		    "incubate " % incubator->name(),
+		    entry.started.nsecsElapsed(),
+		    {{"activeUs", entry.activeNs / 1000}}
+		);
+	}
+}
+
+QString QsIncubationController::costReport() const {
+	auto names = this->costs.keys();
+	std::ranges::sort(names, [this](const QString& a, const QString& b) {
+		return this->costs.value(a).totalNs > this->costs.value(b).totalNs;
+	});
+
+	auto report = QStringLiteral("Incubation cost by component (count, average, max, total):");
+
+	for (const auto& name: names) {
+		auto cost = this->costs.value(name);
+		report += QStringLiteral("\n  %1: %2, %3us, %4us, %5us")
+		              .arg(name)
+		              .arg(cost.count)
+		              .arg(cost.averageNs() / 1000)
+		              .arg(cost.maxNs / 1000)
+		              .arg(cost.totalNs / 1000);
+	}
+
+	return report;
 }
 
 void QsIncubationController::animationStopped() { this->incubate(); }
 
 void QsIncubationController::incubatingObjectCountChanged(int count) {
+	if (count == 0) this->lastSlice.invalidate();
+
 	if (count
 	    && (!this->followRenderloop
 	        || (this->renderLoop && !this->renderLoop->interleaveIncubation())))
@@ -130,6 +356,8 @@ void QsIncubationController::updateIncubationTime() {
 	auto* screen = QGuiApplication::primaryScreen();
 	if (!screen) return;
 
+	this->frameTime = qMax(1, static_cast<int>(1000 / screen->refreshRate()));
 	// 1/3 frame on primary screen
-	this->incubationTime = qMax(1, static_cast<int>(1000 / screen->refreshRate() / 3));
+	this->incubationTime = qMax(1, this->frameTime / 3);
+	if (this->followRenderloop) this->budget = this->incubationTime;
 }
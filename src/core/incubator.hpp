@@ -1,14 +1,26 @@
 #pragma once
 
+#include <utility>
+
+#include <qcontainerfwd.h>
+#include <qdeadlinetimer.h>
+#include <qelapsedtimer.h>
+#include <qhash.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qpointer.h>
 #include <qqmlincubator.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "logcat.hpp"
 
 QS_DECLARE_LOGGING_CATEGORY(logIncubator);
 
+class QQmlEngine;
+
 class QsQmlIncubator
     : public QObject
     , public QQmlIncubator {
@@ -21,9 +33,22 @@ public:
 
 	void statusChanged(QQmlIncubator::Status status) override;
 
+	// Name used to track incubation cost across incubations of the same component.
+	[[nodiscard]] QString name() const { return this->mName; }
+	void setName(QString name) { this->mName = std::move(name); }
+
+	// Time incubation should be complete by. Incubators with a deadline are given more
+	// time per slice, and are forced to complete once it passes.
+	[[nodiscard]] QDeadlineTimer deadline() const { return this->mDeadline; }
+	void setDeadline(QDeadlineTimer deadline) { this->mDeadline = deadline; }
+
 signals:
 	void completed();
 	void failed();
+
+private:
+	QString mName;
+	QDeadlineTimer mDeadline = QDeadlineTimer(QDeadlineTimer::Forever);
 };
 
 class QSGRenderLoop;
@@ -34,10 +59,20 @@ class QsIncubationController
 	Q_OBJECT
 
 public:
+	QsIncubationController() = default;
+	~QsIncubationController() override;
+	Q_DISABLE_COPY_MOVE(QsIncubationController);
+
 	void initLoop();
 	void setIncubationMode(bool render);
 	void incubateLater();
 
+	// Tracks the cost and deadline of an incubator already started on the given engine.
+	static void track(QQmlEngine* engine, QsQmlIncubator* incubator);
+	void track(QsQmlIncubator* incubator);
+
+	[[nodiscard]] QString costReport() const;
+
 protected:
 	void timerEvent(QTimerEvent* event) override;
 
@@ -50,6 +85,30 @@ protected:
 	void incubatingObjectCountChanged(int count) override;
 
 private:
+	struct TrackedIncubator {
+		QPointer<QsQmlIncubator> incubator;
+		QElapsedTimer started;
+		qint64 activeNs = 0;
+	};
+
+	struct ComponentCost {
+		qint32 count = 0;
+		qint64 totalNs = 0;
+		qint64 maxNs = 0;
+
+		[[nodiscard]] qint64 averageNs() const {
+			return this->count == 0 ? 0 : this->totalNs / this->count;
+		}
+	};
+
+	void incubateSlice(int budget);
+	void beginSlice(QList<QsQmlIncubator*> incubators);
+	void endSlice();
+	void adaptBudget(qint64 intervalNs, qint64 expectedNs);
+	[[nodiscard]] int urgentBudget(int budget);
+	[[nodiscard]] bool hasUrgentIncubators() const;
+	void onIncubatorFinished(QsQmlIncubator* incubator, bool success);
+
 // QPointer did not work with forward declarations prior to 6.7
 #if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
 	QPointer<QSGRenderLoop> renderLoop = nullptr;
@@ -57,6 +116,18 @@ private:
 	QSGRenderLoop* renderLoop = nullptr;
 #endif
 	int incubationTime = 0;
+	int frameTime = 16;
 	int timerId = 0;
 	bool followRenderloop = false;
+
+	// Per slice budget adapted to how much time slices can take without delaying
+	// frames or the event loop.
+	int budget = 10;
+	int timerInterval = 0;
+	QElapsedTimer lastSlice;
+
+	QHash<QsQmlIncubator*, TrackedIncubator> tracked;
+	QHash<QString, ComponentCost> costs;
+	QList<QsQmlIncubator*> sliceIncubators;
+	QElapsedTimer sliceTimer;
 };
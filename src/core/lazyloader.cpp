@@ -1,6 +1,7 @@
 #include "lazyloader.hpp"
 #include <utility>
 
+#include <qdeadlinetimer.h>
 #include <qlogging.h>
 #include <qobject.h>
 #include <qqmlcomponent.h>
@@ -8,6 +9,7 @@
 #include <qqmlengine.h>
 #include <qqmlincubator.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "incubator.hpp"
 #include "reload.hpp"
@@ -94,6 +96,20 @@ void LazyLoader::setActiveAsync(bool active) {
 	else this->setActive(false);
 }
 
+void LazyLoader::setDeadline(qint32 deadline) {
+	if (deadline < 0) deadline = -1;
+	if (deadline == this->mDeadline) return;
+	this->mDeadline = deadline;
+
+	if (this->incubator != nullptr) this->incubator->setDeadline(this->incubationDeadline());
+	emit this->deadlineChanged();
+}
+
+QDeadlineTimer LazyLoader::incubationDeadline() const {
+	if (this->mDeadline == -1) return QDeadlineTimer(QDeadlineTimer::Forever);
+	return QDeadlineTimer(this->mDeadline - this->loadStarted.elapsed());
+}
+
 QQmlComponent* LazyLoader::component() const {
 	return this->cleanupComponent ? nullptr : this->mComponent;
 }
@@ -172,9 +188,21 @@ void LazyLoader::incubateIfReady(bool overrideReloadCheck) {
 	QObject::connect(this->incubator, &QsQmlIncubator::failed, this, &LazyLoader::onIncubationFailed);
 	// clang-format on
 
+	this->loadStarted.start();
+	this->incubator->setDeadline(this->incubationDeadline());
+	this->incubator->setName(
+	    this->mComponent->url().isEmpty() ? QStringLiteral("<inline component>")
+	                                      : this->mComponent->url().toString()
+	);
+
 	emit this->loadingChanged();
 
 	this->mComponent->create(*this->incubator, QQmlEngine::contextForObject(this->mComponent));
+
+	// synchronous incubation will have already finished
+	if (this->incubator != nullptr) {
+		QsIncubationController::track(this->mComponent->engine(), this->incubator);
+	}
 }
 
 void LazyLoader::onIncubationCompleted() {
@@ -195,6 +223,7 @@ void LazyLoader::onIncubationFailed() {
 	}
 
 	delete this->incubator;
+	this->incubator = nullptr;
 	this->targetLoading = false;
 	emit this->loadingChanged();
 }
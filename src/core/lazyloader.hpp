@@ -1,10 +1,13 @@
 #pragma once
 
 #include <QtQml/qqmlcomponent.h>
+#include <qdeadlinetimer.h>
+#include <qelapsedtimer.h>
 #include <qobject.h>
 #include <qqmlincubator.h>
 #include <qqmlintegration.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "incubator.hpp"
 #include "reload.hpp"
@@ -118,6 +121,16 @@ class LazyLoader: public Reloadable {
 	/// @@loading. Reading it or setting it to false will behanve
 	/// the same as @@active.
 	Q_PROPERTY(bool activeAsync READ isActive WRITE setActiveAsync NOTIFY activeChanged);
+	/// Time in milliseconds after loading starts that loading should be finished by,
+	/// or `-1` for no deadline. Defaults to `-1`.
+	///
+	/// Loaders with a deadline are given more time per frame, based on how long the
+	/// component took to load previously, so they finish in time with as little blocking
+	/// as possible. If loading still has not finished once the deadline passes, it will
+	/// be finished immediately, blocking as if @@active had been set to true.
+	///
+	/// This is useful for popups that are likely to be opened soon after loading starts.
+	Q_PROPERTY(qint32 deadline READ deadline WRITE setDeadline NOTIFY deadlineChanged);
 	/// The component to load. Mutually exclusive to @@source.
 	Q_PROPERTY(QQmlComponent* component READ component WRITE setComponent NOTIFY componentChanged);
 	/// The URI to load the component from. Mutually exclusive to @@component.
@@ -138,6 +151,9 @@ public:
 	[[nodiscard]] QObject* item();
 	void setItem(QObject* item);
 
+	[[nodiscard]] qint32 deadline() const { return this->mDeadline; }
+	void setDeadline(qint32 deadline);
+
 	[[nodiscard]] QQmlComponent* component() const;
 	void setComponent(QQmlComponent* component);
 
@@ -150,6 +166,7 @@ signals:
 	void itemChanged();
 	void sourceChanged();
 	void componentChanged();
+	void deadlineChanged();
 
 private slots:
 	void onIncubationCompleted();
@@ -159,6 +176,7 @@ private slots:
 private:
 	void incubateIfReady(bool overrideReloadCheck = false);
 	void waitForObjectCreation();
+	[[nodiscard]] QDeadlineTimer incubationDeadline() const;
 
 	bool targetLoading = false;
 	bool targetActive = false;
@@ -167,4 +185,6 @@ private:
 	QQmlComponent* mComponent = nullptr;
 	QsQmlIncubator* incubator = nullptr;
 	bool cleanupComponent = false;
+	qint32 mDeadline = -1;
+	QElapsedTimer loadStarted;
 };
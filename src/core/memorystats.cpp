@@ -0,0 +1,191 @@
+#include "memorystats.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+#include <qcontainerfwd.h>
+#include <qfile.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmutex.h>
+#include <qobject.h>
+#include <qqmlengine.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtypes.h>
+#include <unistd.h>
+
+#include "build.hpp"
+#include "generation.hpp"
+#include "logcat.hpp"
+
+#if USE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+namespace {
+QS_LOGGING_CATEGORY(logMemory, "quickshell.memory", QtInfoMsg);
+
+// Long enough for the old generation's deferred deletions to have run.
+constexpr int RELOAD_LOG_DELAY = 5000;
+
+QMutex countersMutex;                         // NOLINT
+QList<LiveObjectCounter*> registeredCounters; // NOLINT
+
+qint64 readRss() {
+	auto file = QFile("/proc/self/statm");
+	if (!file.open(QFile::ReadOnly)) return -1;
+
+	// size resident shared ...
+	auto fields = file.readAll().split(' ');
+	if (fields.length() < 2) return -1;
+
+	auto ok = false;
+	auto pages = fields.at(1).toLongLong(&ok);
+	return ok ? pages * sysconf(_SC_PAGESIZE) : -1;
+}
+
+#if USE_JEMALLOC
+template <typename T>
+bool readMallctl(const char* name, T* value) {
+	auto len = sizeof(T);
+	return mallctl(name, value, &len, nullptr, 0) == 0;
+}
+#endif
+
+MemoryStats::Allocator readAllocatorStats() {
+	auto stats = MemoryStats::Allocator();
+
+#if USE_JEMALLOC
+	// Stats are cached by jemalloc until the epoch is advanced.
+	uint64_t epoch = 1;
+	auto epochLen = sizeof(epoch);
+	if (mallctl("epoch", &epoch, &epochLen, &epoch, epochLen) != 0) return stats;
+
+	size_t allocated = 0;
+	size_t active = 0;
+	size_t resident = 0;
+	size_t mapped = 0;
+	size_t retained = 0;
+	unsigned arenas = 0;
+
+	stats.available = readMallctl("stats.allocated", &allocated)
+	               && readMallctl("stats.active", &active)
+	               && readMallctl("stats.resident", &resident)
+	               && readMallctl("stats.mapped", &mapped)
+	               && readMallctl("stats.retained", &retained)
+	               && readMallctl("arenas.narenas", &arenas);
+
+	stats.allocated = static_cast<qint64>(allocated);
+	stats.active = static_cast<qint64>(active);
+	stats.resident = static_cast<qint64>(resident);
+	stats.mapped = static_cast<qint64>(mapped);
+	stats.retained = static_cast<qint64>(retained);
+	stats.arenas = arenas;
+#endif
+
+	return stats;
+}
+
+QString formatMiB(qint64 bytes) {
+	return QStringLiteral("%1MiB").arg(static_cast<double>(bytes) / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+void logSummary() {
+	auto snapshot = MemoryStats::snapshot();
+
+	auto jsHeap = qint64(0);
+	auto pending = 0;
+
+	for (const auto& generation: snapshot.generations) {
+		jsHeap += generation.jsHeapAllocated;
+		if (generation.pendingDestruction) pending++;
+	}
+
+	auto rss = snapshot.rss == -1 ? QStringLiteral("unknown") : formatMiB(snapshot.rss);
+
+	auto summary = QStringLiteral("Memory usage after reload: rss %1, js heap %2 in %3 generation(s)")
+	                   .arg(rss, formatMiB(jsHeap))
+	                   .arg(snapshot.generations.length());
+
+	if (snapshot.allocator.available) {
+		summary += QStringLiteral(", jemalloc %1 allocated, %2 resident in %3 arenas")
+		               .arg(formatMiB(snapshot.allocator.allocated))
+		               .arg(formatMiB(snapshot.allocator.resident))
+		               .arg(snapshot.allocator.arenas);
+	}
+
+	auto objects = QStringList();
+	for (const auto& entry: snapshot.liveObjects) {
+		objects.append(QStringLiteral("%1 %2").arg(entry.name).arg(entry.count));
+	}
+
+	if (!objects.isEmpty()) summary += QStringLiteral("; live objects: ") + objects.join(", ");
+
+	qCInfo(logMemory).noquote() << summary;
+
+	if (pending != 0) {
+		qCWarning(logMemory) << pending << "old generation(s) have not been destroyed"
+		                     << RELOAD_LOG_DELAY / 1000 << "seconds after reloading.";
+	}
+}
+
+} // namespace
+
+LiveObjectCounter::LiveObjectCounter(const char* name): mName(name) {
+	auto lock = QMutexLocker(&countersMutex);
+	registeredCounters.append(this);
+}
+
+QList<LiveObjectCounter*> LiveObjectCounter::counters() {
+	auto lock = QMutexLocker(&countersMutex);
+	return registeredCounters;
+}
+
+void MemoryStats::collectGarbage() {
+	for (auto* generation: EngineGeneration::generations()) {
+		if (!generation->isDestroying()) generation->engine->collectGarbage();
+	}
+}
+
+MemoryStats::Snapshot MemoryStats::snapshot() {
+	auto snapshot = Snapshot {.rss = readRss(), .allocator = readAllocatorStats()};
+
+	for (auto* generation: EngineGeneration::generations()) {
+		auto* mm = generation->engine->handle()->memoryManager;
+
+		snapshot.generations.append({
+		    .id = QStringLiteral("0x%1").arg(reinterpret_cast<quintptr>(generation), 0, 16),
+		    .pendingDestruction = generation->isDestroying(),
+		    .jsHeapUsed = static_cast<qint64>(mm->getUsedMem()),
+		    .jsHeapAllocated = static_cast<qint64>(mm->getAllocatedMem()),
+		    .jsLargeItems = static_cast<qint64>(mm->getLargeItemsMem()),
+		});
+	}
+
+	for (auto* counter: LiveObjectCounter::counters()) {
+		snapshot.liveObjects.append({.name = counter->name(), .count = counter->value()});
+	}
+
+	std::ranges::sort(snapshot.liveObjects, [](const LiveObjects& a, const LiveObjects& b) {
+		return a.name < b.name;
+	});
+
+	return snapshot;
+}
+
+void MemoryStats::scheduleReloadLog() {
+	static auto* timer = [] {
+		auto* timer = new QTimer(); // NOLINT
+		timer->setSingleShot(true);
+		timer->setInterval(RELOAD_LOG_DELAY);
+		QObject::connect(timer, &QTimer::timeout, &logSummary);
+		return timer;
+	}();
+
+	// Only the last of several quick reloads is logged.
+	timer->start();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+
+#include <qcontainerfwd.h>
+#include <qlist.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtypes.h>
+
+#include "util.hpp"
+
+// Number of live instances of a type, used to find objects leaking across reloads.
+class LiveObjectCounter {
+public:
+	explicit LiveObjectCounter(const char* name);
+	~LiveObjectCounter() = default;
+	Q_DISABLE_COPY_MOVE(LiveObjectCounter);
+
+	void increment() { this->count.fetch_add(1, std::memory_order_relaxed); }
+	void decrement() { this->count.fetch_sub(1, std::memory_order_relaxed); }
+
+	[[nodiscard]] const char* name() const { return this->mName; }
+	[[nodiscard]] qint64 value() const { return this->count.load(std::memory_order_relaxed); }
+
+	// Counters are registered the first time an instance of their type is created.
+	static QList<LiveObjectCounter*> counters();
+
+private:
+	const char* mName;
+	std::atomic<qint64> count = 0;
+};
+
+// Member which counts live instances of the containing type under the given name.
+template <StringLiteral Name>
+class LiveObjectCount {
+public:
+	LiveObjectCount() { LiveObjectCount::counter().increment(); }
+	~LiveObjectCount() { LiveObjectCount::counter().decrement(); }
+	LiveObjectCount(const LiveObjectCount& /*other*/) { LiveObjectCount::counter().increment(); }
+	LiveObjectCount(LiveObjectCount&& /*other*/) noexcept { LiveObjectCount::counter().increment(); }
+	LiveObjectCount& operator=(const LiveObjectCount& /*other*/) = default;
+	LiveObjectCount& operator=(LiveObjectCount&& /*other*/) noexcept = default;
+
+private:
+	static LiveObjectCounter& counter() {
+		static LiveObjectCounter counter(Name);
+		return counter;
+	}
+};
+
+// Reports where memory is held in long running instances: engine generations and their JS
+// heaps, counts of objects which tend to accumulate, and allocator stats when built with
+// jemalloc.
+class MemoryStats {
+public:
+	struct Generation {
+		QString id;
+		bool pendingDestruction = false;
+		qint64 jsHeapUsed = 0;
+		qint64 jsHeapAllocated = 0;
+		qint64 jsLargeItems = 0;
+	};
+
+	struct LiveObjects {
+		QString name;
+		qint64 count = 0;
+	};
+
+	struct Allocator {
+		bool available = false;
+		qint64 allocated = 0;
+		qint64 active = 0;
+		qint64 resident = 0;
+		qint64 mapped = 0;
+		qint64 retained = 0;
+		quint32 arenas = 0;
+	};
+
+	struct Snapshot {
+		// -1 if unknown
+		qint64 rss = -1;
+		QList<Generation> generations;
+		QList<LiveObjects> liveObjects;
+		Allocator allocator;
+	};
+
+	// Runs the garbage collector of every generation not pending destruction.
+	static void collectGarbage();
+	static Snapshot snapshot();
+
+	// Logs a summary shortly after a reload, once the old generation should be gone.
+	static void scheduleReloadLog();
+};
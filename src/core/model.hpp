@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 
 #include <QtCore/qtmetamacros.h>
@@ -8,6 +9,7 @@
 #include <qobject.h>
 #include <qqmlintegration.h>
 #include <qqmllist.h>
+#include <qset.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
@@ -128,25 +130,55 @@ public:
 		emit this->objectRemovedPost(object, index);
 	}
 
-	// Assumes only one instance of a specific value
+	// Assumes only one instance of a specific value.
+	// Contiguous runs of removed or inserted values are applied as a single row range.
 	void diffUpdate(const QList<T*>& newValues) {
-		for (qsizetype i = 0; i < this->mValuesList.length();) {
-			if (newValues.contains(this->mValuesList.at(i))) i++;
-			else this->removeAt(i);
+		auto& list = this->mValuesList;
+		auto newSet = QSet<T*>(newValues.begin(), newValues.end());
+		auto changed = false;
+
+		for (qsizetype i = 0; i < list.length();) {
+			if (newSet.contains(list.at(i))) {
+				i++;
+				continue;
+			}
+
+			auto end = i + 1;
+			while (end < list.length() && !newSet.contains(list.at(end))) end++;
+
+			this->removeRange(i, end - i);
+			changed = true;
 		}
 
+		// every remaining value is also in newValues
+		auto oldSet = QSet<T*>(list.begin(), list.end());
+
 		qsizetype oi = 0;
-		for (auto* object: newValues) {
-			if (this->mValuesList.length() == oi || this->mValuesList.at(oi) != object) {
-				// object may already be present further down (reorder case);
-				// drop the old row first so the same pointer is not inserted twice.
-				auto old = this->mValuesList.indexOf(object, oi);
-				if (old != -1) this->removeAt(old);
-				this->insertObject(object, oi);
+		for (qsizetype ni = 0; ni < newValues.length();) {
+			auto* object = newValues.at(ni);
+
+			if (oi < list.length() && list.at(oi) == object) {
+				oi++;
+				ni++;
+			} else if (!oldSet.contains(object)) {
+				auto end = ni + 1;
+				while (end < newValues.length() && !oldSet.contains(newValues.at(end))) end++;
+
+				this->insertRange(oi, newValues.sliced(ni, end - ni));
+				oi += end - ni;
+				ni = end;
+				changed = true;
+			} else {
+				// reorder: the object is further down, move it up
+				this->removeRange(list.indexOf(object, oi), 1);
+				this->insertRange(oi, {object});
+				oi++;
+				ni++;
+				changed = true;
 			}
-
-			oi++;
 		}
+
+		if (changed) emit this->valuesChanged();
 	}
 
 	static ObjectModel<T>* emptyInstance() {
@@ -174,5 +206,39 @@ public:
 	}
 
 private:
+	// Unlike removeAt and insertObject, these do not emit valuesChanged.
+	void removeRange(qsizetype index, qsizetype count) {
+		for (auto i = index; i != index + count; i++) {
+			emit this->objectRemovedPre(this->mValuesList.at(i), i);
+		}
+
+		auto removed = this->mValuesList.sliced(index, count);
+		auto intIndex = static_cast<qint32>(index);
+		this->beginRemoveRows(QModelIndex(), intIndex, static_cast<qint32>(intIndex + count - 1));
+		this->mValuesList.remove(index, count);
+		this->endRemoveRows();
+
+		for (auto i = 0; i != count; i++) {
+			emit this->objectRemovedPost(removed.at(i), index + i);
+		}
+	}
+
+	void insertRange(qsizetype index, const QList<T*>& objects) {
+		for (auto i = 0; i != objects.length(); i++) {
+			emit this->objectInsertedPre(objects.at(i), index + i);
+		}
+
+		auto intIndex = static_cast<qint32>(index);
+		auto last = static_cast<qint32>(index + objects.length() - 1);
+		this->beginInsertRows(QModelIndex(), intIndex, last);
+		this->mValuesList.insert(index, objects.length(), nullptr);
+		std::ranges::copy(objects, this->mValuesList.begin() + index);
+		this->endInsertRows();
+
+		for (auto i = 0; i != objects.length(); i++) {
+			emit this->objectInsertedPost(objects.at(i), index + i);
+		}
+	}
+
 	QList<T*> mValuesList;
 };
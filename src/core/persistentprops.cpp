@@ -1,21 +1,99 @@
 #include "persistentprops.hpp"
 
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qdatastream.h>
+#include <qhash.h>
+#include <qiodevice.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
+#include <qvariant.h>
 
-void PersistentProperties::onReload(QObject* oldInstance) {
-	if (qobject_cast<PersistentProperties*>(oldInstance) == nullptr) {
-		emit this->loaded();
-		return;
-	}
+#include "recovery.hpp"
+
+namespace {
 
-	const auto* metaObject = this->metaObject();
+QList<PersistentProperties*> liveInstances; // NOLINT
+
+QVariantMap saveableProperties(const QObject* object) {
+	auto values = QVariantMap();
+
+	const auto* metaObject = object->metaObject();
 	for (auto i = metaObject->propertyOffset(); i < metaObject->propertyCount(); i++) {
 		const auto prop = metaObject->property(i);
-		auto oldProp = oldInstance->property(prop.name());
+		auto value = prop.read(object);
+		if (RecoverySnapshot::canSave(value)) values.insert(prop.name(), value);
+	}
+
+	return values;
+}
+
+QByteArray saveSnapshot() {
+	auto states = QHash<QString, QVariantMap>();
+
+	// Objects from a newer generation come later, and replace older ones with the same id.
+	for (auto* instance: liveInstances) {
+		if (instance->mReloadableId.isEmpty()) continue;
+		states.insert(instance->mReloadableId, saveableProperties(instance));
+	}
+
+	if (states.isEmpty()) return QByteArray();
+
+	auto data = QByteArray();
+	auto stream = QDataStream(&data, QIODevice::WriteOnly);
+	stream << states;
+	return data;
+}
+
+QHash<QString, QVariantMap>& recoveredStates() {
+	static auto states = [] {
+		auto* recovery = RecoverySnapshot::instance();
+		recovery->addSource("persistentProperties", &saveSnapshot);
+
+		auto states = QHash<QString, QVariantMap>();
+		auto stream = QDataStream(recovery->take("persistentProperties"));
+		stream >> states;
+		return states;
+	}();
+
+	return states;
+}
+
+} // namespace
+
+PersistentProperties::PersistentProperties(QObject* parent): Reloadable(parent) {
+	liveInstances.append(this);
+}
+
+PersistentProperties::~PersistentProperties() { liveInstances.removeOne(this); }
+
+void PersistentProperties::onReload(QObject* oldInstance) {
+	if (qobject_cast<PersistentProperties*>(oldInstance) == nullptr) {
+		// Nothing to reload from, but the state may have been recovered after a crash.
+		auto& recovered = recoveredStates();
+		auto it = this->mReloadableId.isEmpty() ? recovered.end()
+		                                        : recovered.find(this->mReloadableId);
+
+		if (it == recovered.end()) {
+			emit this->loaded();
+			return;
+		}
+
+		for (auto [name, value]: it->asKeyValueRange()) {
+			this->setProperty(name.toUtf8(), value);
+		}
+
+		recovered.erase(it);
+	} else {
+		const auto* metaObject = this->metaObject();
+		for (auto i = metaObject->propertyOffset(); i < metaObject->propertyCount(); i++) {
+			const auto prop = metaObject->property(i);
+			auto oldProp = oldInstance->property(prop.name());
 
-		if (oldProp.isValid()) {
-			this->setProperty(prop.name(), oldProp);
+			if (oldProp.isValid()) {
+				this->setProperty(prop.name(), oldProp);
+			}
 		}
 	}
 
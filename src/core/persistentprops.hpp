@@ -2,6 +2,7 @@
 
 #include <qobject.h>
 #include <qqmlintegration.h>
+#include <qtclasshelpermacros.h>
 
 #include "reload.hpp"
 
@@ -38,12 +39,17 @@
 ///   visible: persist.expanderOpen
 /// }
 /// ```
+///
+/// Properties of objects with a `reloadableId` are also restored when Quickshell is relaunched
+/// after a crash, if they hold simple values such as numbers, strings or lists of them.
 class PersistentProperties: public Reloadable {
 	Q_OBJECT;
 	QML_ELEMENT;
 
 public:
-	PersistentProperties(QObject* parent = nullptr): Reloadable(parent) {}
+	PersistentProperties(QObject* parent = nullptr);
+	~PersistentProperties() override;
+	Q_DISABLE_COPY_MOVE(PersistentProperties);
 
 	void onReload(QObject* oldInstance) override;
 
@@ -52,6 +58,7 @@ signals:
 	/// Will be called every time, including when nothing was loaded from an old instance.
 	void loaded();
 	/// Called every time the properties are reloaded.
-	/// Will not be called if no old instance was loaded.
+	/// Will not be called if no old instance was loaded, unless the properties were restored
+	/// after a crash.
 	void reloaded();
 };
@@ -1,9 +1,11 @@
 #include "plugin.hpp"
 #include <algorithm>
 
+#include <qstringbuilder.h>
 #include <qvector.h> // NOLINT (what??)
 
 #include "generation.hpp"
+#include "startuptrace.hpp"
 
 static QVector<QsEnginePlugin*> plugins; // NOLINT
 
@@ -29,14 +31,17 @@ void QsEnginePlugin::initPlugins() {
 	});
 
 	for (QsEnginePlugin* plugin: plugins) {
+		auto span = StartupSpan("plugin", plugin->name() % " preinit");
 		plugin->preinit();
 	}
 
 	for (QsEnginePlugin* plugin: plugins) {
+		auto span = StartupSpan("plugin", plugin->name() % " init");
 		plugin->init();
 	}
 
 	for (QsEnginePlugin* plugin: plugins) {
+		auto span = StartupSpan("plugin", plugin->name() % " registerTypes");
 		plugin->registerTypes();
 	}
 }
@@ -0,0 +1,26 @@
+#include "powerstate.hpp"
+
+#include <qminmax.h>
+#include <qtypes.h>
+
+PowerState::PowerState() {
+	this->bLiveContentPaused.setBinding([this] {
+		return this->bPowerSaving.value() && this->bIdleHolds.value() != 0;
+	});
+}
+
+PowerState* PowerState::instance() {
+	static PowerState* instance = nullptr; // NOLINT
+	if (instance == nullptr) instance = new PowerState();
+	return instance;
+}
+
+void PowerState::setMaxFrameRate(qint32 maxFrameRate) {
+	this->bMaxFrameRate = qMax(1, maxFrameRate);
+}
+
+void PowerState::acquireIdleHold() { this->bIdleHolds = this->bIdleHolds.value() + 1; }
+
+void PowerState::releaseIdleHold() {
+	this->bIdleHolds = qMax(0, this->bIdleHolds.value() - 1);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <qobject.h>
+#include <qproperty.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+// Global power saving state shared by windows and live content sources.
+//
+// While power saving is enabled, windows are limited to maxFrameRate and stop processing
+// updates while not exposed. Live content, such as screencopy views and peak monitors, is
+// additionally paused while an idle monitor which opted in reports the session as idle.
+class PowerState: public QObject {
+	Q_OBJECT;
+
+public:
+	static constexpr qint32 DEFAULT_MAX_FRAME_RATE = 30;
+
+	static PowerState* instance();
+
+	[[nodiscard]] bool powerSaving() const { return this->bPowerSaving.value(); }
+	void setPowerSaving(bool powerSaving) { this->bPowerSaving = powerSaving; }
+
+	[[nodiscard]] qint32 maxFrameRate() const { return this->bMaxFrameRate.value(); }
+	void setMaxFrameRate(qint32 maxFrameRate);
+
+	[[nodiscard]] bool liveContentPaused() const { return this->bLiveContentPaused.value(); }
+
+	[[nodiscard]] QBindable<bool> bindablePowerSaving() { return &this->bPowerSaving; }
+	[[nodiscard]] QBindable<bool> bindableLiveContentPaused() const {
+		return &this->bLiveContentPaused;
+	}
+
+	// Idle holds are taken by idle monitors while they report the session as idle.
+	void acquireIdleHold();
+	void releaseIdleHold();
+
+signals:
+	void powerSavingChanged();
+	void maxFrameRateChanged();
+	void liveContentPausedChanged();
+
+private:
+	PowerState();
+
+	// clang-format off
+	Q_OBJECT_BINDABLE_PROPERTY(PowerState, bool, bPowerSaving, &PowerState::powerSavingChanged);
+	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(PowerState, qint32, bMaxFrameRate, DEFAULT_MAX_FRAME_RATE, &PowerState::maxFrameRateChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(PowerState, qint32, bIdleHolds);
+	Q_OBJECT_BINDABLE_PROPERTY(PowerState, bool, bLiveContentPaused, &PowerState::liveContentPausedChanged);
+	// clang-format on
+};
@@ -30,6 +30,7 @@
 #include "iconimageprovider.hpp"
 #include "instanceinfo.hpp"
 #include "paths.hpp"
+#include "powerstate.hpp"
 #include "qmlscreen.hpp"
 #include "rootwrapper.hpp"
 #include "scanenv.hpp"
@@ -52,7 +53,13 @@ QuickshellSettings* QuickshellSettings::instance() {
 	return instance;
 }
 
-void QuickshellSettings::reset() { QuickshellSettings::instance()->mWatchFiles = true; }
+void QuickshellSettings::reset() {
+	QuickshellSettings::instance()->mWatchFiles = true;
+
+	auto* powerState = PowerState::instance();
+	powerState->setPowerSaving(false);
+	powerState->setMaxFrameRate(PowerState::DEFAULT_MAX_FRAME_RATE);
+}
 
 QString QuickshellSettings::workingDirectory() const { // NOLINT
 	return QDir::current().absolutePath();
@@ -142,6 +149,9 @@ QuickshellGlobal::QuickshellGlobal(QObject* parent): QObject(parent) {
 	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::lastWindowClosed, this, &QuickshellGlobal::lastWindowClosed);
 
 	QObject::connect(QuickshellTracked::instance(), &QuickshellTracked::screensChanged, this, &QuickshellGlobal::screensChanged);
+
+	QObject::connect(PowerState::instance(), &PowerState::powerSavingChanged, this, &QuickshellGlobal::powerSavingChanged);
+	QObject::connect(PowerState::instance(), &PowerState::maxFrameRateChanged, this, &QuickshellGlobal::powerSavingFrameRateChanged);
 	// clang-format on
 
 	QObject::connect(
@@ -218,6 +228,18 @@ void QuickshellGlobal::setWatchFiles(bool watchFiles) { // NOLINT
 	QuickshellSettings::instance()->setWatchFiles(watchFiles);
 }
 
+bool QuickshellGlobal::powerSaving() { return PowerState::instance()->powerSaving(); }
+
+void QuickshellGlobal::setPowerSaving(bool powerSaving) {
+	PowerState::instance()->setPowerSaving(powerSaving);
+}
+
+qint32 QuickshellGlobal::powerSavingFrameRate() { return PowerState::instance()->maxFrameRate(); }
+
+void QuickshellGlobal::setPowerSavingFrameRate(qint32 frameRate) {
+	PowerState::instance()->setMaxFrameRate(frameRate);
+}
+
 QString QuickshellGlobal::clipboardText() {
 	return static_cast<QGuiApplication*>(QGuiApplication::instance())->clipboard()->text(); // NOLINT
 }
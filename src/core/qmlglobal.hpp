@@ -138,6 +138,24 @@ class QuickshellGlobal: public QObject {
 	///
 	/// > [!WARNING] Under wayland the clipboard will be empty unless a quickshell window is focused.
 	Q_PROPERTY(QString clipboardText READ clipboardText WRITE setClipboardText NOTIFY clipboardTextChanged);
+	/// If true, Quickshell will try to reduce power usage at the cost of smoothness.
+	/// Defaults to false.
+	///
+	/// While power saving is enabled:
+	/// - Windows render at most @@powerSavingFrameRate frames per second, which also
+	///   limits the frame rate of animations.
+	/// - Windows which are not exposed, such as ones the compositor has stopped sending
+	///   frame callbacks to, stop processing updates until they are exposed again.
+	/// - Live @@Quickshell.Wayland.ScreencopyView$s and
+	///   @@Quickshell.Services.Pipewire.PwNodePeakMonitor$s are paused while an
+	///   @@Quickshell.Wayland.IdleMonitor with @@Quickshell.Wayland.IdleMonitor.pauseLiveContent
+	///   set reports the session as idle.
+	///
+	/// This property is reset to its default on reload, so it should be set with a binding,
+	/// for example to a low battery state from `Quickshell.Services.UPower`.
+	Q_PROPERTY(bool powerSaving READ powerSaving WRITE setPowerSaving NOTIFY powerSavingChanged);
+	/// The maximum frame rate of windows while @@powerSaving is enabled. Defaults to 30.
+	Q_PROPERTY(qint32 powerSavingFrameRate READ powerSavingFrameRate WRITE setPowerSavingFrameRate NOTIFY powerSavingFrameRateChanged);
 	/// The per-shell data directory.
 	///
 	/// Usually `~/.local/share/quickshell/by-shell/<shell-id>`
@@ -215,6 +233,10 @@ public:
 	/// > If you want to use a different icon theme, you can put `//@ pragma IconTheme <name>`
 	/// > at the top of your root config file or set the `QS_ICON_THEME` variable to the name
 	/// > of your icon theme.
+	///
+	/// Theme icons are cached in memory across reloads. Putting `//@ pragma IconDiskCache`
+	/// at the top of your root config file or setting `QS_ICON_DISK_CACHE=1` also keeps
+	/// rasterized icons in @@cacheDir, which speeds up loading them after a restart.
 	Q_INVOKABLE static QString iconPath(const QString& icon);
 	/// Setting the `check` parameter of `iconPath` to true will return an empty string
 	/// if the icon does not exist, instead of an image showing a missing texture.
@@ -282,6 +304,12 @@ public:
 	[[nodiscard]] static QString clipboardText();
 	static void setClipboardText(const QString& text);
 
+	[[nodiscard]] static bool powerSaving();
+	static void setPowerSaving(bool powerSaving);
+
+	[[nodiscard]] static qint32 powerSavingFrameRate();
+	static void setPowerSavingFrameRate(qint32 frameRate);
+
 	[[nodiscard]] QString dataDir() const;
 	[[nodiscard]] QString stateDir() const;
 	[[nodiscard]] QString cacheDir() const;
@@ -302,6 +330,8 @@ signals:
 	void workingDirectoryChanged();
 	void watchFilesChanged();
 	void clipboardTextChanged();
+	void powerSavingChanged();
+	void powerSavingFrameRateChanged();
 
 private slots:
 	void onClipboardChanged(QClipboard::Mode mode);
@@ -0,0 +1,151 @@
+#include "recovery.hpp"
+#include <functional>
+#include <utility>
+
+#include <qbytearray.h>
+#include <qdatastream.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qiodevice.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmap.h>
+#include <qmetatype.h>
+#include <qobject.h>
+#include <qsavefile.h>
+#include <qstring.h>
+#include <qtypes.h>
+#include <qvariant.h>
+
+#include "logcat.hpp"
+#include "paths.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logRecovery, "quickshell.recovery", QtWarningMsg);
+
+constexpr quint32 SNAPSHOT_MAGIC = 0x51535253; // QSRS
+constexpr quint32 SNAPSHOT_VERSION = 1;
+constexpr int SNAPSHOT_INTERVAL = 10000;
+const QString SNAPSHOT_FILE = QStringLiteral("recovery.qsr"); // NOLINT
+
+} // namespace
+
+RecoverySnapshot::RecoverySnapshot() {
+	this->timer.setInterval(SNAPSHOT_INTERVAL);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &RecoverySnapshot::save);
+}
+
+RecoverySnapshot* RecoverySnapshot::instance() {
+	static auto* instance = new RecoverySnapshot(); // NOLINT
+	return instance;
+}
+
+void RecoverySnapshot::addSource(const QString& key, std::function<QByteArray()> save) {
+	this->sources.insert(key, std::move(save));
+}
+
+void RecoverySnapshot::start() {
+	auto* runDir = QsPaths::instance()->instanceRunDir();
+
+	if (runDir == nullptr) {
+		qCWarning(logRecovery) << "Not taking recovery snapshots as the instance runtime directory "
+		                          "could not be created.";
+		return;
+	}
+
+	this->startAt(runDir->filePath(SNAPSHOT_FILE));
+}
+
+void RecoverySnapshot::startAt(const QString& path) {
+	this->path = path;
+	this->lastSnapshot.clear();
+	this->timer.start();
+}
+
+void RecoverySnapshot::restore(const QString& instanceId) {
+	if (QsPaths::instance()->baseRunDir() == nullptr) return;
+	this->restoreFrom(QDir(QsPaths::basePath(instanceId)).filePath(SNAPSHOT_FILE));
+}
+
+void RecoverySnapshot::restoreFrom(const QString& path) {
+	auto file = QFile(path);
+
+	if (!file.open(QIODevice::ReadOnly)) {
+		qCInfo(logRecovery) << "No recovery snapshot was left at" << path;
+		return;
+	}
+
+	auto stream = QDataStream(&file);
+	quint32 magic = 0;
+	quint32 version = 0;
+	auto sections = QMap<QString, QByteArray>();
+	stream >> magic >> version;
+
+	if (magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION) stream >> sections;
+
+	if (stream.status() != QDataStream::Ok || magic != SNAPSHOT_MAGIC
+	    || version != SNAPSHOT_VERSION)
+	{
+		qCWarning(logRecovery) << "Ignoring unreadable recovery snapshot" << path;
+	} else {
+		qCInfo(logRecovery) << "Restoring" << sections.size() << "sections from recovery snapshot"
+		                    << path;
+		this->restored = std::move(sections);
+	}
+
+	// Restoring the same state twice could bring back whatever caused the crash.
+	file.remove();
+}
+
+QByteArray RecoverySnapshot::take(const QString& key) { return this->restored.take(key); }
+
+bool RecoverySnapshot::canSave(const QVariant& value) {
+	auto type = value.metaType();
+	if (!type.isValid() || type.flags().testFlag(QMetaType::PointerToQObject)) return false;
+
+	if (type == QMetaType::fromType<QVariantList>()) {
+		for (const auto& entry: value.toList()) {
+			if (!RecoverySnapshot::canSave(entry)) return false;
+		}
+
+		return true;
+	} else if (type == QMetaType::fromType<QVariantMap>()) {
+		for (const auto& entry: value.toMap()) {
+			if (!RecoverySnapshot::canSave(entry)) return false;
+		}
+
+		return true;
+	}
+
+	return type.hasRegisteredDataStreamOperators();
+}
+
+void RecoverySnapshot::save() {
+	if (this->path.isEmpty()) return;
+
+	auto sections = QMap<QString, QByteArray>();
+
+	for (auto [key, saveSection]: this->sources.asKeyValueRange()) {
+		auto section = saveSection();
+		if (!section.isEmpty()) sections.insert(key, section);
+	}
+
+	auto snapshot = QByteArray();
+	auto stream = QDataStream(&snapshot, QIODevice::WriteOnly);
+	stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << sections;
+
+	// Most snapshots are identical to the last one.
+	if (snapshot == this->lastSnapshot) return;
+
+	auto file = QSaveFile(this->path);
+
+	if (!file.open(QIODevice::WriteOnly) || file.write(snapshot) != snapshot.size()
+	    || !file.commit())
+	{
+		qCWarning(logRecovery) << "Could not write recovery snapshot" << this->path
+		                       << file.errorString();
+		return;
+	}
+
+	this->lastSnapshot = std::move(snapshot);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <functional>
+
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qmap.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qvariant.h>
+
+// Periodically snapshots state which is cheap to serialize into the instance run dir, so an
+// instance relaunched after a crash can show the last known state immediately, and refresh it
+// from the real sources in the background.
+//
+// Each part of the snapshot is owned by a source, which restores its section with take()
+// when it is created.
+class RecoverySnapshot: public QObject {
+	Q_OBJECT;
+
+public:
+	static RecoverySnapshot* instance();
+
+	// Registers a section of the snapshot. The save function is called on the main thread
+	// each time a snapshot is taken, and must return the whole section.
+	void addSource(const QString& key, std::function<QByteArray()> save);
+
+	// Starts periodically writing snapshots of the current instance.
+	void start();
+	// Starts periodically writing snapshots to path.
+	void startAt(const QString& path);
+	// Writes a snapshot now, if it changed since the last one.
+	void save();
+
+	// Loads the snapshot left behind by a crashed instance, then removes it.
+	void restore(const QString& instanceId);
+	// Loads the snapshot at path, then removes it.
+	void restoreFrom(const QString& path);
+	// Returns the restored section for key, which will not be returned again.
+	QByteArray take(const QString& key);
+
+	// Returns true if the value can be written to a QDataStream without losing data.
+	static bool canSave(const QVariant& value);
+
+private:
+	RecoverySnapshot();
+
+	QHash<QString, std::function<QByteArray()>> sources;
+	QMap<QString, QByteArray> restored;
+	QByteArray lastSnapshot;
+	QString path;
+	QTimer timer;
+};
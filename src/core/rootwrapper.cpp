@@ -19,6 +19,7 @@
 #include "instanceinfo.hpp"
 #include "qmlglobal.hpp"
 #include "scan.hpp"
+#include "startuptrace.hpp"
 #include "toolsupport.hpp"
 
 RootWrapper::RootWrapper(QString rootPath, QString shellId)
@@ -55,10 +56,16 @@ RootWrapper::~RootWrapper() {
 }
 
 void RootWrapper::reloadGraph(bool hard) {
+	auto span = StartupSpan("config", QStringLiteral("load configuration"));
+
 	auto rootFile = QFileInfo(this->rootPath);
 	auto rootPath = rootFile.dir();
 	auto scanner = QmlScanner(rootPath);
-	scanner.scanQmlRoot(this->rootPath);
+
+	{
+		auto scanSpan = StartupSpan("config", QStringLiteral("scan qml files"));
+		scanner.scanQmlRoot(this->rootPath);
+	}
 
 	qs::core::QmlToolingSupport::updateTooling(rootPath, scanner);
 	this->configDirWatcher.addPath(rootPath.path());
@@ -95,13 +102,17 @@ void RootWrapper::reloadGraph(bool hard) {
 		return;
 	}
 
+	auto engineSpan = StartupSpan("config", QStringLiteral("create engine"));
 	auto* generation = new EngineGeneration(rootPath, std::move(scanner));
 	generation->wrapper = this;
+	engineSpan.end();
 
+	auto compileSpan = StartupSpan("config", QStringLiteral("compile"));
 	QUrl url;
 	url.setScheme("qs");
 	url.setPath("@/qs/" % rootFile.fileName());
 	auto component = QQmlComponent(generation->engine, url);
+	compileSpan.end();
 
 	if (!component.isReady()) {
 		qCritical() << "Failed to load configuration";
@@ -144,6 +155,7 @@ void RootWrapper::reloadGraph(bool hard) {
 		return;
 	}
 
+	auto createSpan = StartupSpan("config", QStringLiteral("create objects"));
 	auto* newRoot = component.beginCreate(generation->engine->rootContext());
 
 	if (auto* item = qobject_cast<QQuickItem*>(newRoot)) {
@@ -158,13 +170,18 @@ void RootWrapper::reloadGraph(bool hard) {
 	generation->root = newRoot;
 
 	component.completeCreate();
+	createSpan.end();
 
 	if (this->generation) {
 		QObject::disconnect(this->generation, nullptr, this, nullptr);
 	}
 
 	auto isReload = this->generation != nullptr;
-	generation->onReload(hard ? nullptr : this->generation);
+
+	{
+		auto reloadSpan = StartupSpan("config", QStringLiteral("reload stage"));
+		generation->onReload(hard ? nullptr : this->generation);
+	}
 
 	if (hard && this->generation) {
 		this->generation->destroy();
@@ -0,0 +1,268 @@
+#include "startuptrace.hpp"
+#include <atomic>
+#include <utility>
+
+#include <qcontainerfwd.h>
+#include <qcoreapplication.h>
+#include <qdatetime.h>
+#include <qdir.h>
+#include <qelapsedtimer.h>
+#include <qiodevice.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmutex.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qquickwindow.h>
+#include <qsavefile.h>
+#include <qset.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtypes.h>
+#include <qvariant.h>
+#include <unistd.h>
+
+#include "common.hpp"
+#include "logcat.hpp"
+#include "paths.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logStartupTrace, "quickshell.startuptrace", QtInfoMsg);
+
+// Services often become ready shortly after the first frame.
+constexpr int WRITE_DELAY = 5000;
+constexpr int WRITE_TIMEOUT = 30000;
+
+struct TraceEvent {
+	// 'X' for spans, 'i' for instants
+	char phase = 'X';
+	const char* category = nullptr;
+	QString name;
+	qint64 startNs = 0;
+	qint64 durationNs = 0;
+	qint64 threadId = 0;
+	QVariantMap args;
+};
+
+// Events may be recorded from the render thread.
+struct TraceState {
+	QMutex mutex;
+	QElapsedTimer timer;
+	qint64 launchOffsetNs = 0;
+	QList<TraceEvent> events;
+	QSet<QString> firstInstants;
+	qint32 windowCount = 0;
+	bool framePresented = false;
+	QTimer* writeTimer = nullptr;
+};
+
+std::atomic<bool> recording = false; // NOLINT
+TraceState* state = nullptr;         // NOLINT
+
+qint64 traceTime() { return state->launchOffsetNs + state->timer.nsecsElapsed(); }
+
+void appendEvent(TraceEvent event) {
+	event.threadId = gettid();
+
+	auto lock = QMutexLocker(&state->mutex);
+	if (!recording.load(std::memory_order_relaxed)) return;
+	state->events.append(std::move(event));
+}
+
+void onFirstFrame() {
+	if (state->writeTimer == nullptr) return;
+
+	qCInfo(logStartupTrace).nospace() << "First frame presented "
+	                                  << traceTime() / 1000000 << "ms after launch.";
+
+	if (state->writeTimer->remainingTime() > WRITE_DELAY) state->writeTimer->start(WRITE_DELAY);
+}
+
+} // namespace
+
+void StartupTrace::enable() {
+	if (state != nullptr) return;
+
+	state = new TraceState();
+	state->timer.start();
+
+	auto launchOffsetMs = qs::Common::LAUNCH_TIME.msecsTo(QDateTime::currentDateTime());
+	state->launchOffsetNs = launchOffsetMs * 1000000;
+	recording = true;
+
+	// Mostly loading libraries and parsing the command line.
+	appendEvent({
+	    .phase = 'X',
+	    .category = "launch",
+	    .name = QStringLiteral("process start"),
+	    .startNs = 0,
+	    .durationNs = state->launchOffsetNs,
+	});
+}
+
+bool StartupTrace::isRecording() { return recording.load(std::memory_order_relaxed); }
+
+void StartupTrace::addSpan(
+    const char* category,
+    const QString& name,
+    qint64 durationNs,
+    const QVariantMap& args
+) {
+	if (!StartupTrace::isRecording()) return;
+
+	appendEvent({
+	    .phase = 'X',
+	    .category = category,
+	    .name = name,
+	    .startNs = traceTime() - durationNs,
+	    .durationNs = durationNs,
+	    .args = args,
+	});
+}
+
+void StartupTrace::addInstant(const char* category, const QString& name, const QVariantMap& args) {
+	if (!StartupTrace::isRecording()) return;
+
+	appendEvent({
+	    .phase = 'i',
+	    .category = category,
+	    .name = name,
+	    .startNs = traceTime(),
+	    .args = args,
+	});
+}
+
+void StartupTrace::addFirstInstant(
+    const char* category,
+    const QString& name,
+    const QVariantMap& args
+) {
+	if (!StartupTrace::isRecording()) return;
+
+	{
+		auto lock = QMutexLocker(&state->mutex);
+		if (state->firstInstants.contains(name)) return;
+		state->firstInstants.insert(name);
+	}
+
+	StartupTrace::addInstant(category, name, args);
+}
+
+void StartupTrace::trackWindow(QQuickWindow* window) {
+	if (!StartupTrace::isRecording()) return;
+
+	auto index = ++state->windowCount;
+
+	// Emitted on the render thread when using the threaded render loop.
+	QObject::connect(
+	    window,
+	    &QQuickWindow::frameSwapped,
+	    window,
+	    [index]() {
+		    StartupTrace::addInstant("window", QStringLiteral("first frame"), {{"window", index}});
+
+		    {
+			    auto lock = QMutexLocker(&state->mutex);
+			    if (state->framePresented) return;
+			    state->framePresented = true;
+		    }
+
+		    auto* app = QCoreApplication::instance();
+		    QMetaObject::invokeMethod(app, &onFirstFrame, Qt::QueuedConnection);
+	    },
+	    static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::SingleShotConnection)
+	);
+}
+
+void StartupTrace::scheduleWrite() {
+	if (!StartupTrace::isRecording() || state->writeTimer != nullptr) return;
+
+	state->writeTimer = new QTimer(QCoreApplication::instance());
+	state->writeTimer->setSingleShot(true);
+	QObject::connect(state->writeTimer, &QTimer::timeout, &StartupTrace::write);
+
+	auto lock = QMutexLocker(&state->mutex);
+	state->writeTimer->start(state->framePresented ? WRITE_DELAY : WRITE_TIMEOUT);
+}
+
+void StartupTrace::write() {
+	auto events = QList<TraceEvent>();
+
+	{
+		auto lock = QMutexLocker(&state->mutex);
+		recording = false;
+		events = std::move(state->events);
+	}
+
+	state->writeTimer->deleteLater();
+	state->writeTimer = nullptr;
+
+	auto* runDir = QsPaths::instance()->instanceRunDir();
+	if (runDir == nullptr) {
+		qCWarning(logStartupTrace) << "Could not write startup trace as the instance runtime "
+		                              "directory could not be created.";
+		return;
+	}
+
+	auto pid = getpid();
+	auto traceEvents = QJsonArray();
+
+	traceEvents.append(QJsonObject {
+	    {"ph", "M"},
+	    {"name", "process_name"},
+	    {"pid", pid},
+	    {"args", QJsonObject {{"name", "quickshell"}}},
+	});
+
+	for (const auto& event: events) {
+		auto object = QJsonObject {
+		    {"ph", QString(QLatin1Char(event.phase))},
+		    {"cat", event.category},
+		    {"name", event.name},
+		    {"ts", static_cast<double>(event.startNs) / 1000.0},
+		    {"pid", pid},
+		    {"tid", event.threadId},
+		};
+
+		if (event.phase == 'X') {
+			object.insert("dur", static_cast<double>(event.durationNs) / 1000.0);
+		} else {
+			object.insert("s", "p");
+		}
+
+		if (!event.args.isEmpty()) object.insert("args", QJsonObject::fromVariantMap(event.args));
+		traceEvents.append(object);
+	}
+
+	auto document = QJsonDocument(QJsonObject {
+	    {"traceEvents", traceEvents},
+	    {"displayTimeUnit", "ms"},
+	});
+
+	auto path = runDir->filePath("startup-trace.json");
+	auto file = QSaveFile(path);
+	auto data = document.toJson(QJsonDocument::Compact);
+
+	if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+		qCWarning(logStartupTrace) << "Could not write startup trace to" << path << file.errorString();
+		return;
+	}
+
+	qCInfo(logStartupTrace) << "Wrote startup trace with" << events.length() << "events to" << path;
+}
+
+StartupSpan::StartupSpan(const char* category, QString name)
+    : category(category)
+    , name(std::move(name)) {
+	if (StartupTrace::isRecording()) this->start = traceTime();
+}
+
+void StartupSpan::end() {
+	if (this->start == -1) return;
+	StartupTrace::addSpan(this->category, this->name, traceTime() - this->start);
+	this->start = -1;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtypes.h>
+#include <qvariant.h>
+
+class QQuickWindow;
+
+// Records timestamped spans along the startup critical path, and writes them to the instance
+// run dir as a Chrome trace-event file, which can be opened in Perfetto or chrome://tracing.
+//
+// Timestamps are relative to process launch. Nothing is recorded unless enabled with
+// --trace-startup, and recording stops once the trace has been written.
+class StartupTrace {
+public:
+	static void enable();
+	[[nodiscard]] static bool isRecording();
+
+	// Records a span which ended now, and lasted durationNs.
+	static void addSpan(
+	    const char* category,
+	    const QString& name,
+	    qint64 durationNs,
+	    const QVariantMap& args = {}
+	);
+
+	// Records an instant event.
+	static void addInstant(const char* category, const QString& name, const QVariantMap& args = {});
+	// Records an instant event only the first time name is used, such as when a service
+	// first becomes ready.
+	static void addFirstInstant(
+	    const char* category,
+	    const QString& name,
+	    const QVariantMap& args = {}
+	);
+
+	// Records the first frame presented by the window.
+	static void trackWindow(QQuickWindow* window);
+
+	// Writes the trace a few seconds after the first frame is presented, leaving time for
+	// services which become ready after it, or after a timeout if no frames are presented.
+	// Must be called once the event loop's application object exists.
+	static void scheduleWrite();
+
+private:
+	static void write();
+};
+
+// Records a span covering its own lifetime, if startup tracing is enabled.
+class StartupSpan {
+public:
+	explicit StartupSpan(const char* category, QString name);
+	~StartupSpan() { this->end(); }
+	Q_DISABLE_COPY_MOVE(StartupSpan);
+
+	// Ends the span before it is destroyed.
+	void end();
+
+private:
+	const char* category;
+	QString name;
+	qint64 start = -1;
+};
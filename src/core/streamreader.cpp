@@ -2,6 +2,7 @@
 #include <cstring>
 
 #include <qbytearray.h>
+#include <qbytearrayview.h>
 #include <qiodevice.h>
 #include <qtypes.h>
 
@@ -31,19 +32,27 @@ bool StreamReader::fill() {
 	return true;
 }
 
-QByteArray StreamReader::readBytes(qsizetype count) {
-	if (this->failed) return {};
+bool StreamReader::ensure(qsizetype count) {
+	if (this->failed) return false;
 
 	auto needed = this->cursor + count;
 
 	while (this->buffer.size() < needed) {
 		if (!this->fill()) {
 			this->failed = true;
-			return {};
+			return false;
 		}
 	}
 
-	auto result = this->buffer.mid(this->cursor, count);
+	return true;
+}
+
+QByteArray StreamReader::readBytes(qsizetype count) { return this->readView(count).toByteArray(); }
+
+QByteArrayView StreamReader::readView(qsizetype count) {
+	if (!this->ensure(count)) return {};
+
+	auto result = QByteArrayView(this->buffer.constData() + this->cursor, count); // NOLINT
 	this->cursor += count;
 	return result;
 }
@@ -71,7 +80,7 @@ QByteArray StreamReader::readUntil(char terminator) {
 }
 
 void StreamReader::readInto(char* ptr, qsizetype count) {
-	auto data = this->readBytes(count);
+	auto data = this->readView(count);
 	if (!data.isEmpty()) memcpy(ptr, data.data(), count);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <qbytearray.h>
+#include <qbytearrayview.h>
 #include <qiodevice.h>
 #include <qtypes.h>
 
@@ -10,6 +11,8 @@ public:
 
 	void startTransaction();
 	QByteArray readBytes(qsizetype count);
+	// Returns a view into the internal buffer, valid until the next read or commit.
+	QByteArrayView readView(qsizetype count);
 	QByteArray readUntil(char terminator);
 	void readInto(char* ptr, qsizetype count);
 	qint32 readI32();
@@ -18,6 +21,7 @@ public:
 
 private:
 	bool fill();
+	bool ensure(qsizetype count);
 
 	QIODevice* device = nullptr;
 	QByteArray buffer;
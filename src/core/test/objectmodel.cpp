@@ -1,7 +1,9 @@
 #include "objectmodel.hpp"
 
+#include <qabstractitemmodel.h>
 #include <qlist.h>
 #include <qobject.h>
+#include <qsignalspy.h>
 #include <qtest.h>
 #include <qtestcase.h>
 
@@ -44,4 +46,35 @@ void TestObjectModel::diffUpdateReorder() {
 	QCOMPARE(model.valueList(), (QList<QObject*> {&a, &b, &c, &d}));
 }
 
+void TestObjectModel::diffUpdateBatchesRanges() {
+	QObject a;
+	QObject b;
+	QObject c;
+	QObject d;
+	QObject e;
+	QObject f;
+
+	auto model = ObjectModel<QObject>(nullptr);
+	model.diffUpdate({&a, &b, &c, &d});
+
+	auto insertSpy = QSignalSpy(&model, &QAbstractItemModel::rowsInserted);
+	auto removeSpy = QSignalSpy(&model, &QAbstractItemModel::rowsRemoved);
+	auto valuesSpy = QSignalSpy(&model, &UntypedObjectModel::valuesChanged);
+
+	// b and c are removed as one range, e and f are inserted as one range
+	model.diffUpdate({&a, &e, &f, &d});
+	QCOMPARE(model.valueList(), (QList<QObject*> {&a, &e, &f, &d}));
+
+	QCOMPARE(removeSpy.count(), 1);
+	QCOMPARE(removeSpy.at(0).at(1).toInt(), 1);
+	QCOMPARE(removeSpy.at(0).at(2).toInt(), 2);
+	QCOMPARE(insertSpy.count(), 1);
+	QCOMPARE(insertSpy.at(0).at(1).toInt(), 1);
+	QCOMPARE(insertSpy.at(0).at(2).toInt(), 2);
+	QCOMPARE(valuesSpy.count(), 1);
+
+	model.diffUpdate({&a, &e, &f, &d});
+	QCOMPARE(valuesSpy.count(), 1);
+}
+
 QTEST_MAIN(TestObjectModel);
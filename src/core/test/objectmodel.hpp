@@ -9,4 +9,5 @@ class TestObjectModel: public QObject {
 private slots:
 	static void diffUpdateInsertRemove();
 	static void diffUpdateReorder();
+	static void diffUpdateBatchesRanges();
 };
@@ -0,0 +1,129 @@
+#include "recovery.hpp"
+#include <memory>
+
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qdatastream.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qiodevice.h>
+#include <qlogging.h>
+#include <qobject.h>
+#include <qqml.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qsignalspy.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qurl.h>
+#include <qvariant.h>
+
+#include "../persistentprops.hpp"
+#include "../recovery.hpp"
+
+namespace {
+
+std::unique_ptr<QObject> create(QQmlEngine& engine, const QByteArray& source) {
+	auto component = QQmlComponent(&engine);
+	component.setData(source, QUrl());
+	auto* object = component.create();
+	if (!object) qFatal("%s", component.errorString().toUtf8().constData());
+	return std::unique_ptr<QObject>(object);
+}
+
+} // namespace
+
+void TestRecoverySnapshot::initTestCase() {
+	qmlRegisterType<PersistentProperties>("QsTest", 1, 0, "PersistentProperties");
+}
+
+void TestRecoverySnapshot::roundTrip() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("recovery.qsr");
+	auto* recovery = RecoverySnapshot::instance();
+
+	recovery->addSource("roundTrip", [] { return QByteArray("section"); });
+	recovery->addSource("empty", [] { return QByteArray(); });
+	recovery->startAt(path);
+	recovery->save();
+	QVERIFY(QFile::exists(path));
+
+	recovery->restoreFrom(path);
+	// restoring the same snapshot twice could repeat a crash
+	QVERIFY(!QFile::exists(path));
+
+	QCOMPARE(recovery->take("roundTrip"), "section");
+	QVERIFY(recovery->take("roundTrip").isEmpty());
+	QVERIFY(recovery->take("empty").isEmpty());
+
+	// unchanged snapshots are not written again
+	recovery->save();
+	QVERIFY(!QFile::exists(path));
+}
+
+void TestRecoverySnapshot::rejectsObjectPointers() {
+	auto object = QObject();
+
+	QVERIFY(RecoverySnapshot::canSave(5));
+	QVERIFY(RecoverySnapshot::canSave(QString("value")));
+	QVERIFY(RecoverySnapshot::canSave(QVariantList {1, "two", QVariantMap {{"three", 3.0}}}));
+
+	QVERIFY(!RecoverySnapshot::canSave(QVariant()));
+	QVERIFY(!RecoverySnapshot::canSave(QVariant::fromValue(&object)));
+	QVERIFY(!RecoverySnapshot::canSave(QVariantList {1, QVariant::fromValue(&object)}));
+	QVERIFY(!RecoverySnapshot::canSave(QVariantMap {{"object", QVariant::fromValue(&object)}}));
+}
+
+void TestRecoverySnapshot::restoresPersistentProperties() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("recovery.qsr");
+	auto* recovery = RecoverySnapshot::instance();
+	auto engine = QQmlEngine();
+
+	// the section written by PersistentProperties of a crashed instance
+	auto states = QHash<QString, QVariantMap>();
+	states.insert("state", {{"count", 5}, {"name", "restored"}});
+
+	auto section = QByteArray();
+	auto stream = QDataStream(&section, QIODevice::WriteOnly);
+	stream << states;
+
+	recovery->addSource("persistentProperties", [section] { return section; });
+	recovery->startAt(path);
+	recovery->save();
+	recovery->restoreFrom(path);
+
+	auto object = create(
+	    engine,
+	    "import QtQml\nimport QsTest\nPersistentProperties {\n"
+	    "reloadableId: \"state\"\n"
+	    "property int count: 0\n"
+	    "property string name: \"\"\n"
+	    "property QtObject object: QtObject {}\n"
+	    "}"
+	);
+
+	auto* props = qobject_cast<PersistentProperties*>(object.get());
+	auto spy = QSignalSpy(props, &PersistentProperties::reloaded);
+
+	props->reload();
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(props->property("count").toInt(), 5);
+	QCOMPARE(props->property("name").toString(), "restored");
+
+	// PersistentProperties replaced the source above with its own.
+	props->setProperty("count", 6);
+	recovery->save();
+	recovery->restoreFrom(path);
+
+	auto saved = QHash<QString, QVariantMap>();
+	auto savedStream = QDataStream(recovery->take("persistentProperties"));
+	savedStream >> saved;
+
+	QCOMPARE(saved.value("state").value("count").toInt(), 6);
+	QCOMPARE(saved.value("state").value("name").toString(), "restored");
+	QVERIFY(!saved.value("state").contains("object"));
+}
+
+QTEST_MAIN(TestRecoverySnapshot);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestRecoverySnapshot: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void initTestCase();
+	static void roundTrip();
+	static void rejectsObjectPointers();
+	static void restoresPersistentProperties();
+};
@@ -0,0 +1,130 @@
+#include "variants.hpp"
+
+#include <qcontainerfwd.h>
+#include <qcoreapplication.h>
+#include <qcoreevent.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qregularexpression.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qurl.h>
+#include <qvariant.h>
+
+#include "../variants.hpp"
+
+namespace {
+
+QList<QObject*> instances(Variants& variants) {
+	auto prop = variants.instances();
+	auto list = QList<QObject*>();
+
+	for (auto i = 0; i < prop.count(&prop); i++) {
+		list.append(prop.at(&prop, i));
+	}
+
+	return list;
+}
+
+void processDeletions() { QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete); }
+
+} // namespace
+
+void TestVariants::reusesEqualValues() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData("import QtQml\nQtObject { property var modelData }", QUrl());
+	QVERIFY(component.isReady());
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+	variants.setModel(QVariantList {"a", "b", "c"});
+
+	auto initial = instances(variants);
+	QCOMPARE(initial.size(), 3);
+	auto removed = QPointer(initial[1]);
+
+	QTest::ignoreMessage(QtWarningMsg, QRegularExpression("^same value specified twice"));
+	variants.setModel(QVariantList {"c", "a", "d", "a"});
+	processDeletions();
+
+	auto updated = instances(variants);
+	QCOMPARE(updated.size(), 3);
+	QCOMPARE(updated[0], initial[0]);
+	QCOMPARE(updated[1], initial[2]);
+	QCOMPARE(updated[2]->property("modelData").toString(), "d");
+	QVERIFY(removed.isNull());
+}
+
+void TestVariants::reusesKeyedValues() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData("import QtQml\nQtObject { property var modelData }", QUrl());
+	QVERIFY(component.isReady());
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+	variants.setModel(QVariantList {
+	    QVariantMap {{"id", 1}, {"name", "one"}},
+	    QVariantMap {{"id", 2}, {"name", "two"}},
+	});
+
+	auto initial = instances(variants);
+	QCOMPARE(initial.size(), 2);
+
+	// setting a key rematches existing instances without recreating them
+	variants.setKey("id");
+	QCOMPARE(instances(variants), initial);
+
+	auto removed = QPointer(initial[1]);
+
+	variants.setModel(QVariantList {
+	    QVariantMap {{"id", 1}, {"name", "renamed"}},
+	    QVariantMap {{"id", 3}, {"name", "three"}},
+	});
+	processDeletions();
+
+	auto updated = instances(variants);
+	QCOMPARE(updated.size(), 2);
+	QCOMPARE(updated[0], initial[0]);
+	QCOMPARE(updated[0]->property("modelData").toMap().value("name").toString(), "renamed");
+	QCOMPARE(updated[1]->property("modelData").toMap().value("name").toString(), "three");
+	QVERIFY(removed.isNull());
+}
+
+void TestVariants::reusesEqualObjects() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData("import QtQml\nQtObject { property var modelData }", QUrl());
+	QVERIFY(component.isReady());
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+	variants.setModel(QVariantList {
+	    QVariantMap {{"id", 1}, {"tags", QVariantList {"a", "b"}}},
+	    QVariantMap {{"id", 2}, {"tags", QVariantList {"c"}}},
+	});
+
+	auto initial = instances(variants);
+	QCOMPARE(initial.size(), 2);
+	auto removed = QPointer(initial[1]);
+
+	// numbers from JS are doubles, and compare equal to the ints they replace
+	variants.setModel(QVariantList {
+	    QVariantMap {{"id", 3.0}, {"tags", QVariantList {}}},
+	    QVariantMap {{"id", 1.0}, {"tags", QVariantList {"a", "b"}}},
+	});
+	processDeletions();
+
+	auto updated = instances(variants);
+	QCOMPARE(updated.size(), 2);
+	QCOMPARE(updated[0], initial[0]);
+	QCOMPARE(updated[1]->property("modelData").toMap().value("id").toInt(), 3);
+	QVERIFY(removed.isNull());
+}
+
+QTEST_MAIN(TestVariants);
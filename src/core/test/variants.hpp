@@ -0,0 +1,13 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestVariants: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void reusesEqualValues();
+	static void reusesKeyedValues();
+	static void reusesEqualObjects();
+};
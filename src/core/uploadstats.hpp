@@ -0,0 +1,19 @@
+#pragma once
+
+#include <qtypes.h>
+
+// Counts bytes uploaded to textures by quickshell on each thread.
+//
+// Uploads happen on the render thread of the window being prepared, so the difference between
+// two reads of threadTotal() on that thread gives the bytes uploaded for that window in between.
+class TextureUploadStats {
+public:
+	static void add(quint64 bytes) { TextureUploadStats::counter() += bytes; }
+	[[nodiscard]] static quint64 threadTotal() { return TextureUploadStats::counter(); }
+
+private:
+	static quint64& counter() {
+		thread_local quint64 bytes = 0;
+		return bytes;
+	}
+};
@@ -1,27 +1,104 @@
 #include "variants.hpp"
-#include <algorithm>
+#include <cstddef>
 #include <utility>
 
 #include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qlist.h>
 #include <qlogging.h>
+#include <qmetatype.h>
 #include <qobject.h>
 #include <qqmlengine.h>
 #include <qqmllist.h>
+#include <qstring.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
 
 #include "reload.hpp"
 
+namespace {
+
+// Hash key over QVariant values, compared with QVariant equality.
+struct VariantKey {
+	QVariant value;
+
+	[[nodiscard]] bool operator==(const VariantKey& other) const {
+		return this->value == other.value;
+	}
+};
+
+size_t qHash(const VariantKey& key, size_t seed = 0) {
+	// this overload hides the global ones
+	using ::qHash;
+
+	const auto& value = key.value;
+
+	if (value.metaType().flags().testFlag(QMetaType::PointerToQObject)) {
+		return qHash(value.value<QObject*>(), seed);
+	}
+
+	switch (value.typeId()) {
+	// numeric values compare equal across types
+	case QMetaType::Bool:
+	case QMetaType::Int:
+	case QMetaType::UInt:
+	case QMetaType::Long:
+	case QMetaType::ULong:
+	case QMetaType::LongLong:
+	case QMetaType::ULongLong:
+	case QMetaType::Short:
+	case QMetaType::UShort:
+	case QMetaType::Float:
+	case QMetaType::Double: return qHash(value.toDouble(), seed);
+	case QMetaType::QString: return qHash(value.toString(), seed);
+	// JS objects and arrays compare by content, so their content is hashed.
+	case QMetaType::QVariantMap: {
+		const auto map = value.value<QVariantMap>();
+		for (const auto& [field, fieldValue]: map.asKeyValueRange()) {
+			seed = qHashMulti(seed, field, VariantKey {fieldValue});
+		}
+
+		return seed;
+	}
+	case QMetaType::QVariantList: {
+		const auto list = value.value<QVariantList>();
+		for (const auto& item: list) {
+			seed = qHashMulti(seed, VariantKey {item});
+		}
+
+		return seed;
+	}
+	default: return seed;
+	}
+}
+
+} // namespace
+
 void Variants::onReload(QObject* oldInstance) {
 	auto* old = qobject_cast<Variants*>(oldInstance);
+	auto keyed = !this->mKey.isEmpty();
+
+	// Without a key, JS object values are matched to the old value sharing the
+	// most fields instead of being looked up here.
+	auto oldInstances = QHash<VariantKey, QObject*>();
+	if (old != nullptr) {
+		for (auto& [value, instance]: old->mInstances) {
+			if (keyed || !value.canConvert<QVariantMap>()) {
+				auto key = VariantKey {this->keyFor(value)};
+				if (!oldInstances.contains(key)) oldInstances.insert(key, instance);
+			}
+		}
+	}
 
-	for (auto& [variant, instanceObj]: this->mInstances.values) {
+	for (auto& [variant, instanceObj]: this->mInstances) {
 		QObject* oldInstance = nullptr;
 		if (old != nullptr) {
-			auto& values = old->mInstances.values;
+			auto& values = old->mInstances;
 
-			if (variant.canConvert<QVariantMap>()) {
+			if (keyed || !variant.canConvert<QVariantMap>()) {
+				oldInstance = oldInstances.take({this->keyFor(variant)});
+			} else {
 				auto variantMap = variant.value<QVariantMap>();
 
 				int matchcount = 0;
@@ -49,16 +126,6 @@ void Variants::onReload(QObject* oldInstance) {
 				if (matchcount > 0) {
 					oldInstance = values.takeAt(matchi).second;
 				}
-			} else {
-				int i = 0;
-				for (auto& [value, _]: values) {
-					if (variant == value) {
-						oldInstance = values.takeAt(i).second;
-						break;
-					}
-
-					i++;
-				}
 			}
 		}
 
@@ -100,16 +167,41 @@ void Variants::setModel(const QVariant& model) {
 	emit this->instancesChanged();
 }
 
+void Variants::setKey(QString key) {
+	if (key == this->mKey) return;
+	this->mKey = std::move(key);
+	emit this->keyChanged();
+
+	// rematch existing instances by the new key
+	if (!this->mInstances.isEmpty()) {
+		this->updateVariants();
+		emit this->instancesChanged();
+	}
+}
+
+QVariant Variants::keyFor(const QVariant& value) const {
+	if (this->mKey.isEmpty()) return value;
+
+	auto field = QVariant();
+	if (auto* object = value.value<QObject*>()) {
+		field = object->property(this->mKey.toUtf8().constData());
+	} else if (value.canConvert<QVariantMap>()) {
+		field = value.value<QVariantMap>().value(this->mKey);
+	}
+
+	return field.isValid() ? field : value;
+}
+
 QQmlListProperty<QObject> Variants::instances() {
 	return QQmlListProperty<QObject>(this, nullptr, &Variants::instanceCount, &Variants::instanceAt);
 }
 
 qsizetype Variants::instanceCount(QQmlListProperty<QObject>* prop) {
-	return static_cast<Variants*>(prop->object)->mInstances.values.length(); // NOLINT
+	return static_cast<Variants*>(prop->object)->mInstances.length(); // NOLINT
 }
 
 QObject* Variants::instanceAt(QQmlListProperty<QObject>* prop, qsizetype i) {
-	return static_cast<Variants*>(prop->object)->mInstances.values.at(i).second; // NOLINT
+	return static_cast<Variants*>(prop->object)->mInstances.at(i).second; // NOLINT
 }
 
 void Variants::componentComplete() {
@@ -123,92 +215,73 @@ void Variants::updateVariants() {
 		return;
 	}
 
-	// clean up removed entries
-	for (auto iter = this->mInstances.values.begin(); iter < this->mInstances.values.end();) {
-		if (this->mModel.contains(iter->first)) {
-			iter++;
-		} else {
-			iter->second->deleteLater();
-			iter = this->mInstances.values.erase(iter);
-		}
-	}
-
-	for (auto iter = this->mModel.begin(); iter < this->mModel.end(); iter++) {
-		auto& variant = *iter;
-		for (auto iter2 = this->mModel.begin(); iter2 < iter; iter2++) {
-			if (*iter2 == variant) {
-				qWarning() << "same value specified twice in Variants, duplicates will be ignored:"
-				           << variant;
-				goto outer;
-			}
-		}
-
-		{
-			if (this->mInstances.contains(variant)) {
-				continue; // we don't need to recreate this one
-			}
+	// index the model by key, ignoring duplicates
+	auto model = QHash<VariantKey, QVariant>();
+	auto order = QList<VariantKey>();
+	model.reserve(this->mModel.size());
+	order.reserve(this->mModel.size());
 
-			auto variantMap = QVariantMap();
-			variantMap.insert("modelData", variant);
+	for (const auto& variant: this->mModel) {
+		auto key = VariantKey {this->keyFor(variant)};
 
-			auto* instance = this->mDelegate->createWithInitialProperties(
-			    variantMap,
-			    QQmlEngine::contextForObject(this->mDelegate)
-			);
+		if (model.contains(key)) {
+			qWarning() << "same value specified twice in Variants, duplicates will be ignored:"
+			           << variant;
+			continue;
+		}
 
-			if (instance == nullptr) {
-				qWarning() << this->mDelegate->errorString().toStdString().c_str();
-				qWarning() << "failed to create variant with object" << variant;
-				continue;
-			}
+		model.insert(key, variant);
+		order.append(std::move(key));
+	}
 
-			QQmlEngine::setObjectOwnership(instance, QQmlEngine::CppOwnership);
+	// clean up removed entries, keeping instances that still have a value
+	for (auto iter = this->mInstances.begin(); iter != this->mInstances.end();) {
+		auto entry = model.constFind({this->keyFor(iter->first)});
 
-			instance->setParent(this);
-			this->mInstances.insert(variant, instance);
+		if (entry == model.constEnd()) {
+			iter->second->deleteLater();
+			iter = this->mInstances.erase(iter);
+			continue;
+		}
 
-			if (this->loaded) {
-				if (auto* reloadable = qobject_cast<Reloadable*>(instance)) reloadable->reload(nullptr);
-				else Reloadable::reloadChildrenRecursive(instance, nullptr);
-			}
+		// only possible when matched by key
+		if (iter->first != *entry) {
+			iter->first = *entry;
+			iter->second->setProperty("modelData", *entry);
 		}
 
-	outer:;
+		model.erase(entry);
+		iter++;
 	}
-}
 
-template <typename K, typename V>
-bool AwfulMap<K, V>::contains(const K& key) const {
-	return std::ranges::any_of(this->values, [&](const QPair<K, V>& pair) {
-		return pair.first == key;
-	});
-}
+	// anything left in the model needs a new instance
+	for (const auto& key: order) {
+		auto entry = model.constFind(key);
+		if (entry == model.constEnd()) continue;
+		const auto& variant = *entry;
 
-template <typename K, typename V>
-V* AwfulMap<K, V>::get(const K& key) {
-	for (auto& [k, v]: this->values) {
-		if (key == k) {
-			return &v;
-		}
-	}
+		auto variantMap = QVariantMap();
+		variantMap.insert("modelData", variant);
 
-	return nullptr;
-}
+		auto* instance = this->mDelegate->createWithInitialProperties(
+		    variantMap,
+		    QQmlEngine::contextForObject(this->mDelegate)
+		);
 
-template <typename K, typename V>
-void AwfulMap<K, V>::insert(const K& key, V value) {
-	this->values.push_back(QPair<K, V>(key, value));
-}
+		if (instance == nullptr) {
+			qWarning() << this->mDelegate->errorString().toStdString().c_str();
+			qWarning() << "failed to create variant with object" << variant;
+			continue;
+		}
+
+		QQmlEngine::setObjectOwnership(instance, QQmlEngine::CppOwnership);
 
-template <typename K, typename V>
-bool AwfulMap<K, V>::remove(const K& key) {
-	for (auto iter = this->values.begin(); iter < this->values.end(); iter++) {
-		if (iter->first == key) {
-			this->values.erase(iter);
+		instance->setParent(this);
+		this->mInstances.append({variant, instance});
 
-			return true;
+		if (this->loaded) {
+			if (auto* reloadable = qobject_cast<Reloadable*>(instance)) reloadable->reload(nullptr);
+			else Reloadable::reloadChildrenRecursive(instance, nullptr);
 		}
 	}
-
-	return false;
 }
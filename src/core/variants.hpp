@@ -3,28 +3,18 @@
 #include <qcontainerfwd.h>
 #include <qlist.h>
 #include <qlogging.h>
-#include <qmap.h>
 #include <qobject.h>
+#include <qpair.h>
 #include <qqmlcomponent.h>
 #include <qqmllist.h>
 #include <qqmlparserstatus.h>
+#include <qstring.h>
 #include <qtmetamacros.h>
 #include <qvariant.h>
 
 #include "doc.hpp"
 #include "reload.hpp"
 
-// extremely inefficient map
-template <typename K, typename V>
-class AwfulMap {
-public:
-	[[nodiscard]] bool contains(const K& key) const;
-	[[nodiscard]] V* get(const K& key);
-	void insert(const K& key, V value); // assumes no duplicates
-	bool remove(const K& key);          // returns true if anything was removed
-	QList<QPair<K, V>> values;
-};
-
 ///! Creates instances of a component based on a given model.
 /// Creates and destroys instances of the given component when the given property changes.
 ///
@@ -32,7 +22,8 @@ public:
 /// a reload scope.
 ///
 /// Each non duplicate value passed to @@model will create a new instance of
-/// @@delegate with a `modelData` property set to that value.
+/// @@delegate with a `modelData` property set to that value. Set @@key to match
+/// values to instances by a single field instead of by the whole value.
 ///
 /// See @@Quickshell.screens for an example of using `Variants` to create copies of a window per
 /// screen.
@@ -50,6 +41,16 @@ class Variants: public Reloadable {
 	/// Each set creates an instance of the component, which are updated when the input sets update.
 	QSDOC_PROPERTY_OVERRIDE(QList<QVariant> model READ model WRITE setModel NOTIFY modelChanged);
 	QSDOC_HIDE Q_PROPERTY(QVariant model READ model WRITE setModel NOTIFY modelChanged);
+	/// The name of a field identifying each value in the @@model. Defaults to an empty string.
+	///
+	/// When set, values are matched to existing instances by this field (a property of objects,
+	/// or a key of JS objects) instead of by the whole value. A matching value with different
+	/// contents reuses its instance and updates its `modelData` instead of recreating it.
+	/// Values without the field are still matched by the whole value.
+	///
+	/// Without a key, JS object values are matched to instances from before a reload by
+	/// comparing every field of every value, which gets slow with large models.
+	Q_PROPERTY(QString key READ key WRITE setKey NOTIFY keyChanged);
 	/// Current instances of the delegate.
 	Q_PROPERTY(QQmlListProperty<QObject> instances READ instances NOTIFY instancesChanged);
 	Q_CLASSINFO("DefaultProperty", "delegate");
@@ -64,10 +65,14 @@ public:
 	[[nodiscard]] QVariant model() const;
 	void setModel(const QVariant& model);
 
+	[[nodiscard]] QString key() const { return this->mKey; }
+	void setKey(QString key);
+
 	QQmlListProperty<QObject> instances();
 
 signals:
 	void modelChanged();
+	void keyChanged();
 	void instancesChanged();
 
 private:
@@ -75,9 +80,11 @@ private:
 	static QObject* instanceAt(QQmlListProperty<QObject>* prop, qsizetype i);
 
 	void updateVariants();
+	[[nodiscard]] QVariant keyFor(const QVariant& value) const;
 
 	QQmlComponent* mDelegate = nullptr;
 	QVariantList mModel;
-	AwfulMap<QVariant, QObject*> mInstances;
+	QString mKey;
+	QList<QPair<QVariant, QObject*>> mInstances;
 	bool loaded = false;
 };
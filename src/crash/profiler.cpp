@@ -0,0 +1,458 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+#include <cpptrace/basic.hpp>
+#include <cpptrace/forward.hpp>
+#include <private/qv4engine_p.h>
+#include <private/qv4executablecompilationunit_p.h>
+#include <private/qv4function_p.h>
+#include <private/qv4stackframe_p.h>
+#include <private/qv4string_p.h>
+#include <pthread.h>
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qdatastream.h>
+#include <qfileinfo.h>
+#include <qhash.h>
+#include <qiodevice.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qobject.h>
+#include <qqmlengine.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtextstream.h>
+#include <qtypes.h>
+#include <qurl.h>
+#include <sys/time.h>
+
+#include "../core/generation.hpp"
+#include "../core/logcat.hpp"
+
+namespace qs::crash {
+
+namespace {
+
+QS_LOGGING_CATEGORY(logProfiler, "quickshell.profiler", QtWarningMsg);
+
+constexpr quint32 SAMPLE_MAGIC = 0x51535046; // QSPF
+constexpr quint8 SAMPLE_VERSION = 1;
+constexpr size_t MAX_NATIVE_FRAMES = 64;
+constexpr size_t MAX_QML_FRAMES = 16;
+constexpr size_t MAX_SAMPLES = 16384;
+constexpr int COLLECT_INTERVAL = 100;
+
+struct RawSample {
+	std::atomic<bool> ready = false;
+	bool mainThread = false;
+	quint8 nativeCount = 0;
+	quint8 qmlCount = 0;
+	std::array<cpptrace::frame_ptr, MAX_NATIVE_FRAMES> native {};
+	std::array<const QV4::Function*, MAX_QML_FRAMES> qml {};
+	// Referenced by the handler so the functions stay alive until their names are resolved.
+	std::array<QV4::ExecutableCompilationUnit*, MAX_QML_FRAMES> qmlUnits {};
+	// Filled in on the main thread by Profiler::collectQmlFrames.
+	std::array<qint32, MAX_QML_FRAMES> qmlNames {};
+};
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<bool> sampling = false;
+std::atomic<int> handlersRunning = 0;
+std::atomic<size_t> nextSample = 0;
+std::atomic<size_t> droppedSamples = 0;
+std::atomic<QV4::ExecutionEngine*> sampledEngine = nullptr;
+RawSample* samples = nullptr;
+size_t sampleCapacity = 0;
+pthread_t mainThread {};
+bool handlerInstalled = false;
+// NOLINTEND
+
+void profileSignalHandler(
+    int /*sig*/,
+    siginfo_t* /*info*/, // NOLINT (misc-include-cleaner)
+    void* /*context*/
+) {
+	auto savedErrno = errno;
+	handlersRunning.fetch_add(1);
+
+	if (sampling.load()) {
+		auto index = nextSample.fetch_add(1, std::memory_order_relaxed);
+
+		if (index < sampleCapacity) {
+			auto& sample = samples[index]; // NOLINT
+
+			// skip the handler's own frame
+			sample.nativeCount = static_cast<quint8>(
+			    cpptrace::safe_generate_raw_trace(sample.native.data(), sample.native.size(), 1)
+			);
+
+			sample.mainThread = pthread_equal(pthread_self(), mainThread) != 0;
+
+			// The engine only runs on the main thread, which this handler has interrupted,
+			// so its stack frames are not changing underneath us. Compilation units of running
+			// functions are alive, and their refcount is atomic, so taking a reference is safe.
+			if (sample.mainThread) {
+				if (auto* engine = sampledEngine.load(std::memory_order_relaxed)) {
+					for (auto* frame = engine->currentStackFrame; frame != nullptr; frame = frame->parent) {
+						if (sample.qmlCount == MAX_QML_FRAMES) break;
+						if (frame->v4Function == nullptr) continue;
+
+						auto* unit = frame->v4Function->executableCompilationUnit();
+						if (unit == nullptr) continue;
+
+						unit->addref();
+						sample.qmlUnits[sample.qmlCount] = unit;
+						sample.qml[sample.qmlCount++] = frame->v4Function;
+					}
+				}
+			}
+
+			sample.ready.store(true, std::memory_order_release);
+		} else {
+			droppedSamples.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	handlersRunning.fetch_sub(1);
+	errno = savedErrno;
+}
+
+QString describeFunction(const QV4::Function* function) {
+	auto name = function->name()->toQString();
+	if (name.isEmpty()) name = QStringLiteral("<anonymous>");
+
+	return QStringLiteral("[qml] %1 (%2)").arg(name, QUrl(function->sourceFile()).fileName());
+}
+
+class ProfilerEngineExt: public EngineGenerationExt {
+public:
+	explicit ProfilerEngineExt(EngineGeneration* generation): generation(generation) {}
+	~ProfilerEngineExt() override { Profiler::instance()->detachEngine(this->generation); }
+	Q_DISABLE_COPY_MOVE(ProfilerEngineExt);
+
+private:
+	EngineGeneration* generation;
+};
+
+const int PROFILER_EXT_KEY = 0;
+
+// Resolves a frame into its symbol names, leaf first.
+// Inlined functions resolve to more than one name.
+QList<QString> resolveFrame(const cpptrace::safe_object_frame& frame) {
+	auto trace = cpptrace::object_trace();
+	trace.frames.push_back(frame.resolve());
+
+	auto names = QList<QString>();
+	for (const auto& resolved: trace.resolve()) {
+		if (!resolved.symbol.empty()) names.append(QString::fromStdString(resolved.symbol));
+	}
+
+	if (names.isEmpty()) {
+		names.append(QStringLiteral("%1+0x%2")
+		                 .arg(QFileInfo(QString::fromUtf8(frame.object_path)).fileName())
+		                 .arg(frame.address_relative_to_object_start, 0, 16));
+	}
+
+	return names;
+}
+
+} // namespace
+
+Profiler::Profiler() {
+	QObject::connect(&this->collectTimer, &QTimer::timeout, this, &Profiler::collectQmlFrames);
+}
+
+Profiler* Profiler::instance() {
+	static auto* instance = new Profiler(); // NOLINT
+	return instance;
+}
+
+bool Profiler::start(qint32 frequency, qint32 durationSecs) {
+	if (this->isRunning() || samples != nullptr) return false;
+
+	// NOLINTBEGIN (misc-include-cleaner)
+	if (!handlerInstalled) {
+		// Preload anything dynamically linked to avoid malloc etc in the dynamic loader.
+		auto buffer = std::array<cpptrace::frame_ptr, 10>();
+		cpptrace::safe_generate_raw_trace(buffer.data(), buffer.size());
+		auto frame = cpptrace::safe_object_frame();
+		cpptrace::get_safe_object_frame(buffer[0], &frame);
+
+		struct sigaction sa {};
+		sa.sa_sigaction = &profileSignalHandler;
+		sa.sa_flags = SA_SIGINFO | SA_RESTART;
+		sigemptyset(&sa.sa_mask);
+
+		if (sigaction(SIGPROF, &sa, nullptr) == -1) {
+			qCCritical(logProfiler) << "Failed to install SIGPROF handler:" << qt_error_string();
+			return false;
+		}
+
+		// The handler is never uninstalled, as a SIGPROF still pending once the timer
+		// is stopped would terminate the process under the default action.
+		handlerInstalled = true;
+	}
+	// NOLINTEND
+
+	// ITIMER_PROF counts cpu time across all threads, so busy threads can exceed the frequency.
+	sampleCapacity = std::min(static_cast<size_t>(frequency) * durationSecs * 2, MAX_SAMPLES);
+	samples = new RawSample[sampleCapacity];
+	nextSample = 0;
+	droppedSamples = 0;
+	mainThread = pthread_self();
+	this->frequency = frequency;
+	this->collectCursor = 0;
+
+	if (auto* generation = EngineGeneration::currentGeneration()) {
+		generation->registerExtension(&PROFILER_EXT_KEY, new ProfilerEngineExt(generation));
+		this->generation = generation;
+		sampledEngine = generation->engine->handle();
+		this->collectTimer.start(COLLECT_INTERVAL);
+	}
+
+	sampling = true;
+
+	auto usecs = 1000000 / frequency;
+	auto interval = timeval {.tv_sec = usecs / 1000000, .tv_usec = usecs % 1000000};
+	auto timer = itimerval {.it_interval = interval, .it_value = interval};
+
+	if (setitimer(ITIMER_PROF, &timer, nullptr) == -1) {
+		qCCritical(logProfiler) << "Failed to start profiling timer:" << qt_error_string();
+		this->takeSamples();
+		return false;
+	}
+
+	qCInfo(logProfiler) << "Started profiling at" << frequency << "Hz with room for"
+	                    << sampleCapacity << "samples";
+
+	return true;
+}
+
+void Profiler::stop() {
+	if (!this->isRunning()) return;
+
+	auto timer = itimerval {};
+	setitimer(ITIMER_PROF, &timer, nullptr);
+	sampling = false;
+
+	// Handlers that saw sampling enabled may still be writing their samples.
+	while (handlersRunning != 0) {
+		std::this_thread::yield();
+	}
+
+	if (this->generation != nullptr) this->detachEngine(this->generation);
+
+	qCInfo(logProfiler) << "Stopped profiling with" << std::min(nextSample.load(), sampleCapacity)
+	                    << "samples";
+}
+
+bool Profiler::isRunning() const { return sampling; }
+
+void Profiler::detachEngine(EngineGeneration* generation) {
+	if (generation != this->generation) return;
+
+	this->collectQmlFrames();
+	this->collectTimer.stop();
+	sampledEngine = nullptr;
+	this->generation = nullptr;
+
+	// Functions are only identified by address, which may be reused once they are released.
+	this->qmlNameIndexes.clear();
+
+	for (auto* unit: this->qmlUnits) {
+		unit->release();
+	}
+
+	this->qmlUnits.clear();
+}
+
+void Profiler::collectQmlFrames() {
+	if (samples == nullptr) return;
+
+	auto end = std::min(nextSample.load(), sampleCapacity);
+
+	for (; this->collectCursor < static_cast<qsizetype>(end); this->collectCursor++) {
+		auto& sample = samples[this->collectCursor]; // NOLINT
+
+		// Samples still being written belong to other threads, which never carry QML frames,
+		// as any handler that interrupted the main thread has finished by now.
+		if (!sample.ready.load(std::memory_order_acquire) || !sample.mainThread) continue;
+
+		for (auto i = 0; i != sample.qmlCount; i++) {
+			const auto* function = sample.qml.at(i);
+			auto* unit = std::exchange(sample.qmlUnits.at(i), nullptr);
+			auto index = this->qmlNameIndexes.value(function, -1);
+
+			if (index == -1) {
+				index = static_cast<qint32>(this->qmlNames.size());
+				this->qmlNames.append(describeFunction(function));
+				this->qmlNameIndexes.insert(function, index);
+
+				// Keeping the first reference alive keeps cached addresses from being reused.
+				this->qmlUnits.append(unit);
+			} else {
+				unit->release();
+			}
+
+			sample.qmlNames.at(i) = index;
+		}
+	}
+}
+
+QByteArray Profiler::takeSamples() {
+	this->stop();
+	if (samples == nullptr) return QByteArray();
+
+	auto count = std::min(nextSample.load(), sampleCapacity);
+
+	// Frames are converted to object relative addresses once per unique address, so the
+	// resolving process can find them without this process's memory map.
+	auto frameIndexes = QHash<cpptrace::frame_ptr, qint32>();
+	auto frameData = QByteArray();
+	auto sampleData = QByteArray();
+	auto sampleStream = QDataStream(&sampleData, QIODevice::WriteOnly);
+	qint32 written = 0;
+
+	for (size_t i = 0; i != count; i++) {
+		const auto& sample = samples[i]; // NOLINT
+		if (!sample.ready.load(std::memory_order_acquire)) continue;
+
+		auto native = QList<qint32>();
+		for (auto j = 0; j != sample.nativeCount; j++) {
+			auto address = sample.native.at(j);
+			auto index = frameIndexes.value(address, -1);
+
+			if (index == -1) {
+				auto frame = cpptrace::safe_object_frame();
+				cpptrace::get_safe_object_frame(address, &frame);
+
+				index = static_cast<qint32>(frameIndexes.size());
+				frameIndexes.insert(address, index);
+				frameData.append(reinterpret_cast<const char*>(&frame), sizeof(frame));
+			}
+
+			native.append(index);
+		}
+
+		auto qml = QList<qint32>();
+		for (auto j = 0; j != sample.qmlCount; j++) {
+			qml.append(sample.qmlNames.at(j));
+		}
+
+		sampleStream << sample.mainThread << native << qml;
+		written++;
+	}
+
+	auto data = QByteArray();
+	auto stream = QDataStream(&data, QIODevice::WriteOnly);
+	stream << SAMPLE_MAGIC << SAMPLE_VERSION << this->frequency
+	       << static_cast<quint64>(droppedSamples.load()) << this->qmlNames << frameData << written;
+	stream.writeRawData(sampleData.constData(), static_cast<int>(sampleData.size()));
+
+	delete[] samples;
+	samples = nullptr;
+	sampleCapacity = 0;
+	this->qmlNames.clear();
+	this->collectCursor = 0;
+
+	return data;
+}
+
+bool writeFoldedStacks(
+    const QByteArray& data,
+    QTextStream& stream,
+    qint32* sampleCount,
+    quint64* droppedCount
+) {
+	auto ds = QDataStream(data);
+
+	quint32 magic = 0;
+	quint8 version = 0;
+	ds >> magic >> version;
+
+	if (magic != SAMPLE_MAGIC || version != SAMPLE_VERSION) {
+		qCCritical(logProfiler) << "Unrecognized profile sample format.";
+		return false;
+	}
+
+	qint32 frequency = 0;
+	quint64 dropped = 0;
+	QList<QString> qmlNames;
+	QByteArray frameData;
+	qint32 count = 0;
+	ds >> frequency >> dropped >> qmlNames >> frameData >> count;
+
+	if (ds.status() != QDataStream::Ok) return false;
+
+	auto frameCount = static_cast<size_t>(frameData.size()) / sizeof(cpptrace::safe_object_frame);
+	const auto* frames = reinterpret_cast<const cpptrace::safe_object_frame*>(frameData.constData());
+
+	auto resolved = QList<QList<QString>>();
+	resolved.reserve(static_cast<qsizetype>(frameCount));
+	for (size_t i = 0; i != frameCount; i++) {
+		resolved.append(resolveFrame(frames[i])); // NOLINT
+	}
+
+	auto stacks = QHash<QString, qint32>();
+
+	for (auto i = 0; i != count; i++) {
+		bool isMainThread = false;
+		QList<qint32> native;
+		QList<qint32> qml;
+		ds >> isMainThread >> native >> qml;
+
+		if (ds.status() != QDataStream::Ok) return false;
+
+		auto folded = QList<QString>();
+		folded.append(isMainThread ? QStringLiteral("[main thread]") : QStringLiteral("[thread]"));
+
+		// QML frames are placed above the interpreter frame that ran them, root first.
+		// Any left over, such as JIT compiled functions, are placed above the innermost frame.
+		auto nextQml = qml.size() - 1;
+
+		for (auto frame = native.size() - 1; frame != -1; frame--) {
+			auto index = native.at(frame);
+			if (index < 0 || index >= resolved.size()) return false;
+
+			const auto& names = resolved.at(index);
+			for (auto name = names.size() - 1; name != -1; name--) {
+				folded.append(names.at(name));
+
+				if (nextQml != -1 && names.at(name).contains(u"QV4::Moth::VME::exec")) {
+					auto qmlIndex = qml.at(nextQml--);
+					if (qmlIndex < 0 || qmlIndex >= qmlNames.size()) return false;
+					folded.append(qmlNames.at(qmlIndex));
+				}
+			}
+		}
+
+		for (; nextQml != -1; nextQml--) {
+			auto qmlIndex = qml.at(nextQml);
+			if (qmlIndex < 0 || qmlIndex >= qmlNames.size()) return false;
+			folded.append(qmlNames.at(qmlIndex));
+		}
+
+		stacks[folded.join(';')]++;
+	}
+
+	auto keys = stacks.keys();
+	std::ranges::sort(keys);
+
+	for (const auto& key: keys) {
+		stream << key << ' ' << stacks.value(key) << '\n';
+	}
+
+	if (sampleCount) *sampleCount = count;
+	if (droppedCount) *droppedCount = dropped;
+	return true;
+}
+
+} // namespace qs::crash
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtextstream.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+class EngineGeneration;
+
+namespace QV4 {
+class ExecutableCompilationUnit;
+}
+
+namespace qs::crash {
+
+// Sampling profiler driven by SIGPROF, sharing the crash handler's signal safe unwinder.
+//
+// Samples are recorded into a preallocated buffer from the signal handler, and only converted
+// into position independent frames once sampling stops, so they can be resolved by another
+// process the same way crash traces are. QML function names are resolved on the main thread,
+// while a reference to their compilation unit taken by the signal handler keeps them alive.
+class Profiler: public QObject {
+	Q_OBJECT;
+
+public:
+	static Profiler* instance();
+
+	// Starts sampling every thread at the given frequency, with room for the given number of
+	// seconds of samples. Returns false if the profiler is already running.
+	bool start(qint32 frequency, qint32 durationSecs);
+	void stop();
+	[[nodiscard]] bool isRunning() const;
+
+	// Stops the profiler if running and returns the recorded samples in the form read by
+	// writeFoldedStacks.
+	QByteArray takeSamples();
+
+	// Stops sampling QML frames from the given generation's engine, which is about to be
+	// destroyed.
+	void detachEngine(EngineGeneration* generation);
+
+private slots:
+	void collectQmlFrames();
+
+private:
+	Profiler();
+
+	QTimer collectTimer;
+	EngineGeneration* generation = nullptr;
+	QList<QString> qmlNames;
+	QHash<const void*, qint32> qmlNameIndexes;
+	// References to the compilation units of functions in qmlNameIndexes.
+	QList<QV4::ExecutableCompilationUnit*> qmlUnits;
+	qsizetype collectCursor = 0;
+	qint32 frequency = 0;
+};
+
+// Resolves samples produced by Profiler::takeSamples and writes them as folded stacks,
+// one line per unique stack ordered root first, followed by the number of samples.
+// Returns false if the samples could not be read.
+bool writeFoldedStacks(
+    const QByteArray& data,
+    QTextStream& stream,
+    qint32* sampleCount,
+    quint64* droppedCount
+);
+
+} // namespace qs::crash
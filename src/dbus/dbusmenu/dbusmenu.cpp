@@ -1,5 +1,5 @@
 #include "dbusmenu.hpp"
-#include <algorithm>
+#include <utility>
 
 #include <qbytearray.h>
 #include <qcontainerfwd.h>
@@ -16,6 +16,7 @@
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qqmllist.h>
+#include <qset.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
@@ -46,7 +47,17 @@ DBusMenuItem::DBusMenuItem(qint32 id, DBusMenu* menu, DBusMenuItem* parentMenu)
 	QObject::connect(this->menu, &DBusMenu::iconThemePathChanged, this, &DBusMenuItem::iconChanged);
 }
 
-void DBusMenuItem::sendOpened() const { this->menu->sendEvent(this->id, "opened"); }
+void DBusMenuItem::sendOpened() {
+	this->menu->sendEvent(this->id, "opened");
+
+	// Submenus are realized when first shown, and refreshed when shown again,
+	// which gives clients the AboutToShow call the spec expects.
+	if (this->id != 0 && this->displayChildren) {
+		if (this->mShowChildren) this->menu->prepareToShow(this->id, DBusMenu::LOOKAHEAD_DEPTH);
+		else this->setShowChildrenRecursive(true);
+	}
+}
+
 void DBusMenuItem::sendClosed() const { this->menu->sendEvent(this->id, "closed"); }
 void DBusMenuItem::sendTriggered() const { this->menu->sendEvent(this->id, "clicked"); }
 
@@ -77,7 +88,7 @@ void DBusMenuItem::setShowChildrenRecursive(bool showChildren) {
 	this->childrenLoaded = false;
 
 	if (showChildren) {
-		this->menu->prepareToShow(this->id, -1);
+		this->menu->prepareToShow(this->id, DBusMenu::LOOKAHEAD_DEPTH);
 	} else {
 		if (!this->mChildren.isEmpty()) {
 			for (auto child: this->mChildren) {
@@ -238,7 +249,7 @@ void DBusMenuItem::updateProperties(const QVariantMap& properties, const QString
 	//if (this->mnemonic != originalMnemonic) emit this->labelChanged();
 	if (this->mEnabled != originalEnabled) emit this->enabledChanged();
 	if (this->visible != originalVisible && this->parentMenu != nullptr)
-		this->parentMenu->onChildrenUpdated();
+		this->menu->queueChildrenUpdate(this->parentMenu);
 	if (this->mButtonType != originalButtonType) emit this->buttonTypeChanged();
 	if (this->mCheckState != originalToggleState) emit this->checkStateChanged();
 	if (this->mSeparator != originalIsSeparator) emit this->isSeparatorChanged();
@@ -261,7 +272,7 @@ void DBusMenuItem::onChildrenUpdated() {
 	QVector<DBusMenuItem*> children;
 	for (auto child: this->mChildren) {
 		auto* item = this->menu->items.value(child);
-		if (item->visible) children.append(item);
+		if (item != nullptr && item->visible) children.append(item);
 	}
 
 	this->enabledChildren.diffUpdate(children);
@@ -343,7 +354,9 @@ void DBusMenu::updateLayout(qint32 parent, qint32 depth) {
 			                       << reply.error();
 		} else {
 			auto layout = reply.argumentAt<1>();
+			this->beginBatch();
 			this->updateLayoutRecursive(layout, this->items.value(parent), depth);
+			this->endBatch();
 		}
 
 		delete call;
@@ -362,7 +375,9 @@ void DBusMenu::updateLayoutRecursive(
 		// there is an actual nullptr in the map and not no entry
 		if (this->items.contains(layout.id)) {
 			item = new DBusMenuItem(layout.id, this, parent);
-			item->mShowChildren = parent != nullptr && parent->mShowChildren;
+			// Only realize submenus when their contents were fetched along with this item,
+			// everything else is loaded once shown.
+			item->mShowChildren = parent != nullptr && parent->mShowChildren && depth != 0;
 			this->items.insert(layout.id, item);
 		}
 	}
@@ -373,43 +388,41 @@ void DBusMenu::updateLayoutRecursive(
 	item->updateProperties(layout.properties);
 
 	if (depth != 0) {
-		auto childrenChanged = false;
-		auto iter = item->mChildren.begin();
-		while (iter != item->mChildren.end()) {
-			auto existing = std::ranges::find_if(layout.children, [&](const DBusMenuLayout& layout) {
-				return layout.id == *iter;
-			});
-
-			if (!item->mShowChildren || existing == layout.children.end()) {
-				qCDebug(logDbusMenu) << "Removing missing layout item" << this->items.value(*iter) << "from"
+		auto children = QVector<qint32>();
+		auto newIds = QSet<qint32>();
+
+		if (item->mShowChildren) {
+			children.reserve(layout.children.length());
+			newIds.reserve(layout.children.length());
+
+			for (const auto& child: layout.children) {
+				children.append(child.id);
+				newIds.insert(child.id);
+			}
+		}
+
+		auto oldIds = QSet<qint32>(item->mChildren.begin(), item->mChildren.end());
+
+		for (auto id: item->mChildren) {
+			if (!newIds.contains(id)) {
+				qCDebug(logDbusMenu) << "Removing missing layout item" << this->items.value(id) << "from"
 				                     << item;
-				this->removeRecursive(*iter);
-				iter = item->mChildren.erase(iter);
-				childrenChanged = true;
-			} else {
-				iter++;
+				this->removeRecursive(id);
 			}
 		}
 
 		for (const auto& child: layout.children) {
-			if (item->mShowChildren && !item->mChildren.contains(child.id)) {
+			if (item->mShowChildren && !oldIds.contains(child.id)) {
 				qCDebug(logDbusMenu) << "Creating new layout item" << child.id << "in" << item;
-				// item->mChildren.push_back(child.id);
 				this->items.insert(child.id, nullptr);
-				childrenChanged = true;
 			}
 
 			this->updateLayoutRecursive(child, item, depth - 1);
 		}
 
-		if (childrenChanged) {
-			// reset to preserve order
-			item->mChildren.clear();
-			for (const auto& child: layout.children) {
-				item->mChildren.push_back(child.id);
-			}
-
-			item->onChildrenUpdated();
+		if (children != item->mChildren) {
+			item->mChildren = std::move(children);
+			this->queueChildrenUpdate(item);
 		}
 	}
 
@@ -420,6 +433,25 @@ void DBusMenu::updateLayoutRecursive(
 	emit item->layoutUpdated();
 }
 
+void DBusMenu::queueChildrenUpdate(DBusMenuItem* item) {
+	if (this->batchDepth == 0) item->onChildrenUpdated();
+	else this->pendingChildrenUpdates.insert(item);
+}
+
+void DBusMenu::beginBatch() { this->batchDepth++; }
+
+void DBusMenu::endBatch() {
+	if (--this->batchDepth != 0) return;
+
+	auto items = std::move(this->pendingChildrenUpdates);
+	this->pendingChildrenUpdates.clear();
+
+	for (auto* item: items) {
+		// removed items are deleted later, but should not be updated anymore
+		if (this->items.value(item->id) == item) item->onChildrenUpdated();
+	}
+}
+
 void DBusMenu::removeRecursive(qint32 id) {
 	auto* item = this->items.value(id);
 
@@ -468,6 +500,9 @@ void DBusMenu::onItemPropertiesUpdated( // NOLINT
     const DBusMenuItemPropertiesList& updatedProps,
     const DBusMenuItemPropertyNamesList& removedProps
 ) {
+	// visibility changes are collected so each parent is rediffed once per signal
+	this->beginBatch();
+
 	for (const auto& propset: updatedProps) {
 		auto* item = this->items.value(propset.id);
 		if (item != nullptr) {
@@ -481,6 +516,8 @@ void DBusMenu::onItemPropertiesUpdated( // NOLINT
 			item->updateProperties({}, propset.properties);
 		}
 	}
+
+	this->endBatch();
 }
 
 QDebug operator<<(QDebug debug, DBusMenu* menu) {
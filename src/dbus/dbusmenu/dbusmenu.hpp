@@ -10,6 +10,7 @@
 #include <qqmlintegration.h>
 #include <qqmllist.h>
 #include <qquickimageprovider.h>
+#include <qset.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
@@ -92,7 +93,7 @@ signals:
 	void layoutUpdated();
 
 private slots:
-	void sendOpened() const;
+	void sendOpened();
 	void sendClosed() const;
 	void sendTriggered() const;
 
@@ -132,10 +133,16 @@ signals:
 public:
 	Q_OBJECT_BINDABLE_PROPERTY(DBusMenu, QStringList, iconThemePath, &DBusMenu::iconThemePathChanged);
 
+	// Menus are fetched along with their direct submenus, so opening a submenu
+	// does not wait for a roundtrip.
+	static constexpr qint32 LOOKAHEAD_DEPTH = 2;
+
 	void prepareToShow(qint32 item, qint32 depth);
 	void updateLayout(qint32 parent, qint32 depth);
 	void removeRecursive(qint32 id);
 	void sendEvent(qint32 item, const QString& event);
+	// Deferred until the current batch of updates ends, if any.
+	void queueChildrenUpdate(DBusMenuItem* item);
 
 	DBusMenuItem rootItem {0, this, nullptr};
 	QHash<qint32, DBusMenuItem*> items {std::make_pair(0, &this->rootItem)};
@@ -151,6 +158,11 @@ private slots:
 
 private:
 	void updateLayoutRecursive(const DBusMenuLayout& layout, DBusMenuItem* parent, qint32 depth);
+	void beginBatch();
+	void endBatch();
+
+	quint32 batchDepth = 0;
+	QSet<DBusMenuItem*> pendingChildrenUpdates;
 
 	QS_DBUS_PROPERTY_BINDING(
 	    DBusMenu,
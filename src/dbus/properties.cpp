@@ -1,26 +1,36 @@
 #include "properties.hpp"
-#include <algorithm>
 #include <utility>
 
 #include <qcontainerfwd.h>
 #include <qdbusabstractinterface.h>
 #include <qdbusargument.h>
+#include <qdbusconnection.h>
 #include <qdbuserror.h>
 #include <qdbusextratypes.h>
 #include <qdbusmessage.h>
 #include <qdbusmetatype.h>
 #include <qdbuspendingcall.h>
 #include <qdbuspendingreply.h>
+#include <qdbusservicewatcher.h>
 #include <qdebug.h>
+#include <qhash.h>
+#include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qmetatype.h>
+#include <qnamespace.h>
 #include <qobject.h>
+#include <qobjectdefs.h>
+#include <qpair.h>
+#include <qpointer.h>
+#include <qstringbuilder.h>
 #include <qtmetamacros.h>
 #include <qtversionchecks.h>
 #include <qvariant.h>
 
 #include "../core/logcat.hpp"
+#include "../core/startuptrace.hpp"
+#include "dbus_objectmanager_types.hpp"
 #include "dbus_properties.h"
 
 QS_LOGGING_CATEGORY(logDbusProperties, "quickshell.dbus.properties", QtWarningMsg);
@@ -112,9 +122,197 @@ void asyncReadPropertyInternal(
 	QObject::connect(call, &QDBusPendingCallWatcher::finished, &interface, responseCallback);
 }
 
+// Batches GetAll requests made for many objects of one service in the same event loop turn
+// into a single GetManagedObjects call, if the service has an object manager above them.
+// Where the object manager lives is discovered once per service, in the background, and
+// forgotten when the service unregisters.
+class DBusManagedObjectBatcher: public QObject {
+public:
+	static DBusManagedObjectBatcher*
+	forService(const QDBusConnection& connection, const QString& service) {
+		auto key = qMakePair(connection.name(), service);
+		auto* batcher = DBusManagedObjectBatcher::batchers().value(key);
+
+		if (batcher == nullptr) {
+			batcher = new DBusManagedObjectBatcher(connection, service);
+			DBusManagedObjectBatcher::batchers().insert(key, batcher);
+		}
+
+		return batcher;
+	}
+
+	void enqueue(DBusPropertyGroup* group) {
+		this->pending.append(group);
+
+		if (!this->flushQueued) {
+			this->flushQueued = true;
+			QMetaObject::invokeMethod(this, [this] { this->flush(); }, Qt::QueuedConnection);
+		}
+	}
+
+private:
+	explicit DBusManagedObjectBatcher(QDBusConnection connection, QString service)
+	    : connection(std::move(connection))
+	    , service(std::move(service))
+	    , serviceWatcher(
+	          this->service,
+	          this->connection,
+	          QDBusServiceWatcher::WatchForUnregistration
+	      ) {
+		qDBusRegisterMetaType<DBusObjectManagerInterfaces>();
+		qDBusRegisterMetaType<DBusObjectManagerObjects>();
+
+		// Unique names are never reused, so batchers for them would otherwise pile up.
+		QObject::connect(
+		    &this->serviceWatcher,
+		    &QDBusServiceWatcher::serviceUnregistered,
+		    this,
+		    &DBusManagedObjectBatcher::onServiceUnregistered
+		);
+	}
+
+	static QHash<QPair<QString, QString>, DBusManagedObjectBatcher*>& batchers() {
+		static auto batchers = QHash<QPair<QString, QString>, DBusManagedObjectBatcher*>();
+		return batchers;
+	}
+
+	void onServiceUnregistered() {
+		qCDebug(logDbusProperties) << "Dropping batcher for unregistered service" << this->service;
+
+		DBusManagedObjectBatcher::batchers().remove(qMakePair(this->connection.name(), this->service));
+		this->deleteLater();
+	}
+
+	enum class State : quint8 {
+		Unknown,
+		Probing,
+		Supported,
+		Unsupported,
+	};
+
+	// Below this many objects, individual GetAll calls are cheaper than fetching every object.
+	static constexpr qsizetype MIN_BATCH = 4;
+
+	void flush() {
+		this->flushQueued = false;
+
+		auto groups = QList<QPointer<DBusPropertyGroup>>();
+		for (auto& group: this->pending) {
+			if (group && group->isConnected()) groups.append(group);
+		}
+
+		this->pending.clear();
+		if (groups.isEmpty()) return;
+
+		if (this->state == State::Supported && groups.length() >= MIN_BATCH) {
+			this->fetch(groups);
+			return;
+		}
+
+		if (this->state == State::Unknown && groups.length() >= MIN_BATCH) {
+			this->state = State::Probing;
+			this->probe(groups.first()->interface->path(), QStringLiteral("/"));
+		}
+
+		for (auto& group: groups) group->getAllDirect();
+	}
+
+	[[nodiscard]] QDBusPendingCall getManagedObjects(const QString& path) const {
+		auto message = QDBusMessage::createMethodCall(
+		    this->service,
+		    path,
+		    "org.freedesktop.DBus.ObjectManager",
+		    "GetManagedObjects"
+		);
+
+		return this->connection.asyncCall(message);
+	}
+
+	// Walks from the root towards objectPath until an object manager containing it is found.
+	void probe(const QString& objectPath, const QString& path) {
+		auto* call = new QDBusPendingCallWatcher(this->getManagedObjects(path), this);
+
+		auto responseCallback = [this, objectPath, path](QDBusPendingCallWatcher* call) {
+			const QDBusPendingReply<DBusObjectManagerObjects> reply = *call;
+			delete call;
+
+			if (!reply.isError() && reply.value().contains(QDBusObjectPath(objectPath))) {
+				qCDebug(logDbusProperties) << "Using object manager at" << path << "of" << this->service
+				                           << "for batched property fetches";
+				this->state = State::Supported;
+				this->managerPath = path;
+				return;
+			}
+
+			auto next = objectPath.indexOf('/', path.length() + 1);
+			if (path == "/") next = objectPath.indexOf('/', 1);
+
+			if (next == -1) {
+				qCDebug(logDbusProperties) << "No object manager found for" << this->service;
+				this->state = State::Unsupported;
+			} else {
+				this->probe(objectPath, objectPath.first(next));
+			}
+		};
+
+		QObject::connect(call, &QDBusPendingCallWatcher::finished, this, responseCallback);
+	}
+
+	void fetch(const QList<QPointer<DBusPropertyGroup>>& groups) {
+		qCDebug(logDbusProperties) << "Fetching properties of" << groups.length() << "objects of"
+		                           << this->service << "via GetManagedObjects";
+
+		auto* call = new QDBusPendingCallWatcher(this->getManagedObjects(this->managerPath), this);
+
+		auto responseCallback = [this, groups](QDBusPendingCallWatcher* call) {
+			const QDBusPendingReply<DBusObjectManagerObjects> reply = *call;
+			delete call;
+
+			if (reply.isError()) {
+				qCDebug(logDbusProperties) << "GetManagedObjects failed for" << this->service
+				                           << reply.error();
+				this->state = State::Unsupported;
+			}
+
+			const auto objects = reply.isError() ? DBusObjectManagerObjects() : reply.value();
+
+			for (const auto& group: groups) {
+				if (!group || !group->isConnected()) continue;
+
+				auto object = objects.find(QDBusObjectPath(group->interface->path()));
+
+				if (object != objects.end()) {
+					auto interface = object->find(group->interface->interface());
+
+					if (interface != object->end()) {
+						group->applyGetAll(*interface);
+						continue;
+					}
+				}
+
+				group->getAllDirect();
+			}
+		};
+
+		QObject::connect(call, &QDBusPendingCallWatcher::finished, this, responseCallback);
+	}
+
+	QDBusConnection connection;
+	QString service;
+	QDBusServiceWatcher serviceWatcher;
+	State state = State::Unknown;
+	QString managerPath;
+	QList<QPointer<DBusPropertyGroup>> pending;
+	bool flushQueued = false;
+};
+
 DBusPropertyGroup::DBusPropertyGroup(QVector<DBusPropertyCore*> properties, QObject* parent)
     : QObject(parent)
-    , properties(std::move(properties)) {}
+    , properties(std::move(properties)) {
+	for (auto* property: this->properties) {
+		this->propertiesByName.insert(property->nameRef(), property);
+	}
+}
 
 void DBusPropertyGroup::setInterface(QDBusAbstractInterface* interface) {
 	if (this->interface != nullptr) {
@@ -143,6 +341,11 @@ void DBusPropertyGroup::setInterface(QDBusAbstractInterface* interface) {
 
 void DBusPropertyGroup::attachProperty(DBusPropertyCore* property) {
 	this->properties.append(property);
+	this->propertiesByName.insert(property->nameRef(), property);
+}
+
+DBusPropertyCore* DBusPropertyGroup::findProperty(QStringView name) const {
+	return this->propertiesByName.value(name);
 }
 
 void DBusPropertyGroup::updateAllDirect() {
@@ -153,8 +356,9 @@ void DBusPropertyGroup::updateAllDirect() {
 		qFatal() << "Attempted to update properties of disconnected property group";
 	}
 
+	// Skips coalescing, which would turn this back into a GetAll call.
 	for (auto* property: this->properties) {
-		this->requestPropertyUpdate(property);
+		this->requestSingleProperty(property);
 	}
 }
 
@@ -166,6 +370,15 @@ void DBusPropertyGroup::updateAllViaGetAll() {
 		qFatal() << "Attempted to update properties of disconnected property group";
 	}
 
+	auto* batcher = DBusManagedObjectBatcher::forService(
+	    this->interface->connection(),
+	    this->interface->service()
+	);
+
+	batcher->enqueue(this);
+}
+
+void DBusPropertyGroup::getAllDirect() {
 	auto pendingCall = this->propertyInterface->GetAll(this->interface->interface());
 	auto* call = new QDBusPendingCallWatcher(pendingCall, this);
 
@@ -180,8 +393,7 @@ void DBusPropertyGroup::updateAllViaGetAll() {
 		} else {
 			qCDebug(logDbusProperties).noquote()
 			    << "Received GetAll property set for" << this->toString();
-			this->updatePropertySet(reply.value(), true);
-			emit this->getAllFinished();
+			this->applyGetAll(reply.value());
 		}
 
 		delete call;
@@ -190,17 +402,29 @@ void DBusPropertyGroup::updateAllViaGetAll() {
 	QObject::connect(call, &QDBusPendingCallWatcher::finished, this, responseCallback);
 }
 
+void DBusPropertyGroup::applyGetAll(const QVariantMap& properties) {
+	this->updatePropertySet(properties, true);
+
+	if (StartupTrace::isRecording()) {
+		StartupTrace::addFirstInstant(
+		    "dbus",
+		    this->interface->interface() % " ready",
+		    {{"service", this->interface->service()}}
+		);
+	}
+
+	emit this->getAllFinished();
+}
+
 void DBusPropertyGroup::updatePropertySet(const QVariantMap& properties, bool complainMissing) {
 	for (const auto [name, value]: properties.asKeyValueRange()) {
-		auto prop = std::ranges::find_if(this->properties, [&name](DBusPropertyCore* prop) {
-			return prop->nameRef() == name;
-		});
+		auto* prop = this->findProperty(name);
 
-		if (prop == this->properties.end()) {
+		if (prop == nullptr) {
 			qCDebug(logDbusProperties) << "Ignoring untracked property update" << name << "for"
 			                           << this->toString();
 		} else {
-			this->tryUpdateProperty(*prop, value);
+			this->tryUpdateProperty(prop, value);
 		}
 	}
 
@@ -232,13 +456,75 @@ void DBusPropertyGroup::tryUpdateProperty(
 }
 
 void DBusPropertyGroup::requestPropertyUpdate(DBusPropertyCore* property) {
-	const QString propStr = this->propertyString(property);
-
 	if (this->interface == nullptr) {
-		qFatal(logDbusProperties).noquote()
-		    << "Tried to update property" << propStr << "of a disconnected interface";
+		qFatal(logDbusProperties).noquote() << "Tried to update property"
+		                                    << this->propertyString(property)
+		                                    << "of a disconnected interface";
 	}
 
+	if (!this->pendingUpdates.contains(property)) this->pendingUpdates.append(property);
+
+	if (!this->updateFlushQueued) {
+		this->updateFlushQueued = true;
+		QMetaObject::invokeMethod(
+		    this,
+		    &DBusPropertyGroup::flushPropertyUpdates,
+		    Qt::QueuedConnection
+		);
+	}
+}
+
+void DBusPropertyGroup::flushPropertyUpdates() {
+	this->updateFlushQueued = false;
+	auto properties = std::move(this->pendingUpdates);
+	this->pendingUpdates.clear();
+
+	if (this->interface == nullptr || properties.isEmpty()) return;
+
+	if (properties.length() == 1) this->requestSingleProperty(properties.first());
+	else this->requestPropertiesViaGetAll(properties);
+}
+
+void DBusPropertyGroup::requestPropertiesViaGetAll(const QVector<DBusPropertyCore*>& properties) {
+	qCDebug(logDbusProperties).noquote()
+	    << "Updating" << properties.length() << "properties of" << this->toString() << "via GetAll";
+
+	auto pendingCall = this->propertyInterface->GetAll(this->interface->interface());
+	auto* call = new QDBusPendingCallWatcher(pendingCall, this);
+
+	auto responseCallback = [this, properties](QDBusPendingCallWatcher* call) {
+		const QDBusPendingReply<QVariantMap> reply = *call;
+		delete call;
+
+		// Some services implement Get but not GetAll for every property.
+		if (reply.isError()) {
+			qCDebug(logDbusProperties).noquote()
+			    << "GetAll failed for" << this->toString() << "falling back to individual queries";
+
+			for (auto* property: properties) this->requestSingleProperty(property);
+			return;
+		}
+
+		const auto& values = reply.value();
+
+		for (auto* property: properties) {
+			auto value = values.find(property->name());
+
+			if (value != values.end()) {
+				this->tryUpdateProperty(property, *value);
+			} else if (property->isRequired()) {
+				qCWarning(logDbusProperties).noquote()
+				    << "Error updating property" << this->propertyString(property)
+				    << ": missing from GetAll result";
+			}
+		}
+	};
+
+	QObject::connect(call, &QDBusPendingCallWatcher::finished, this, responseCallback);
+}
+
+void DBusPropertyGroup::requestSingleProperty(DBusPropertyCore* property) {
+	const QString propStr = this->propertyString(property);
 	qCDebug(logDbusProperties).noquote() << "Updating property" << propStr;
 
 	auto pendingCall = this->propertyInterface->Get(this->interface->interface(), property->name());
@@ -319,15 +605,13 @@ void DBusPropertyGroup::onPropertiesChanged(
 	    << "Received property change set and invalidations for" << this->toString();
 
 	for (const auto& name: invalidatedProperties) {
-		auto prop = std::ranges::find_if(this->properties, [&name](DBusPropertyCore* prop) {
-			return prop->nameRef() == name;
-		});
+		auto* prop = this->findProperty(name);
 
-		if (prop == this->properties.end()) {
+		if (prop == nullptr) {
 			qCDebug(logDbusProperties) << "Ignoring untracked property invalidation" << name << "for"
 			                           << this;
 		} else {
-			this->requestPropertyUpdate(*prop);
+			this->requestPropertyUpdate(prop);
 		}
 	}
 
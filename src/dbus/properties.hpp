@@ -13,6 +13,7 @@
 #include <qdbusreply.h>
 #include <qdbusservicewatcher.h>
 #include <qdebug.h>
+#include <qhash.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
@@ -225,6 +226,8 @@ private:
 	[[nodiscard]] constexpr Bindable* bindable() const { return &(this->owner()->*bindablePtr); }
 };
 
+class DBusManagedObjectBatcher;
+
 class DBusPropertyGroup: public QObject {
 	Q_OBJECT;
 
@@ -235,12 +238,15 @@ public:
 	void setInterface(QDBusAbstractInterface* interface);
 	void attachProperty(DBusPropertyCore* property);
 	void updateAllDirect();
+	// Requests made for many objects of the same service in one event loop turn may be
+	// fulfilled by a single ObjectManager.GetManagedObjects call.
 	void updateAllViaGetAll();
 	void updatePropertySet(const QVariantMap& properties, bool complainMissing = true);
 	[[nodiscard]] QString toString() const;
 	[[nodiscard]] bool isConnected() const { return this->interface; }
 
 	void pushPropertyUpdate(DBusPropertyCore* property);
+	// Requests made in the same event loop turn are coalesced into a single GetAll call.
 	void requestPropertyUpdate(DBusPropertyCore* property);
 
 signals:
@@ -254,15 +260,26 @@ private slots:
 	    const QStringList& invalidatedProperties
 	);
 
+	void flushPropertyUpdates();
+
 private:
+	void requestSingleProperty(DBusPropertyCore* property);
+	void requestPropertiesViaGetAll(const QVector<DBusPropertyCore*>& properties);
+	void getAllDirect();
+	void applyGetAll(const QVariantMap& properties);
 	void tryUpdateProperty(DBusPropertyCore* property, const QVariant& variant) const;
+	[[nodiscard]] DBusPropertyCore* findProperty(QStringView name) const;
 	[[nodiscard]] QString propertyString(const DBusPropertyCore* property) const;
 
 	DBusPropertiesInterface* propertyInterface = nullptr;
 	QDBusAbstractInterface* interface = nullptr;
 	QVector<DBusPropertyCore*> properties;
+	QHash<QStringView, DBusPropertyCore*> propertiesByName;
+	QVector<DBusPropertyCore*> pendingUpdates;
+	bool updateFlushQueued = false;
 
 	friend class AbstractDBusProperty;
+	friend class DBusManagedObjectBatcher;
 };
 
 } // namespace qs::dbus
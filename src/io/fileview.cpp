@@ -1,9 +1,14 @@
 #include "fileview.hpp"
+#include <algorithm>
 #include <array>
+#include <cerrno>
 #include <utility>
 
+#include <fcntl.h>
 #include <qatomic.h>
+#include <qbytearrayview.h>
 #include <qdir.h>
+#include <qelapsedtimer.h>
 #include <qfiledevice.h>
 #include <qfileinfo.h>
 #include <qfilesystemwatcher.h>
@@ -13,12 +18,16 @@
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qobjectdefs.h>
+#include <qpointer.h>
 #include <qqmlinfo.h>
 #include <qsavefile.h>
 #include <qscopedpointer.h>
 #include <qthreadpool.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "../core/logcat.hpp"
 #include "../core/util.hpp"
@@ -291,7 +300,78 @@ void FileViewWriter::write(
 	}
 }
 
+FileViewPoller::FileViewPoller() {
+	this->clock.start();
+	this->timer.setSingleShot(true);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &FileViewPoller::onTimeout);
+}
+
+FileViewPoller* FileViewPoller::instance() {
+	static auto* instance = new FileViewPoller(); // NOLINT
+	return instance;
+}
+
+void FileViewPoller::addView(FileView* view, qint32 interval) {
+	auto now = this->clock.elapsed();
+	auto deadline = (now / interval + 1) * interval;
+
+	auto it = std::ranges::find_if(this->entries, [&](const Entry& e) { return e.view == view; });
+
+	if (it != this->entries.end()) {
+		it->interval = interval;
+		it->deadline = deadline;
+	} else {
+		this->entries.append({.view = view, .interval = interval, .deadline = deadline});
+	}
+
+	this->scheduleNext();
+}
+
+void FileViewPoller::removeView(FileView* view) {
+	auto removed = this->entries.removeIf([&](const Entry& e) { return e.view == view; });
+	if (removed != 0) this->scheduleNext();
+}
+
+void FileViewPoller::onTimeout() {
+	auto now = this->clock.elapsed();
+	auto due = QList<QPointer<FileView>>();
+
+	for (auto& entry: this->entries) {
+		if (entry.deadline <= now) {
+			due.append(entry.view);
+			entry.deadline = (now / entry.interval + 1) * entry.interval;
+		}
+	}
+
+	// Polls may emit signals that add, remove or destroy views.
+	for (const auto& view: due) {
+		if (view) view->poll();
+	}
+
+	this->scheduleNext();
+}
+
+void FileViewPoller::scheduleNext() {
+	if (this->entries.isEmpty()) {
+		this->timer.stop();
+		return;
+	}
+
+	auto deadline = std::ranges::min_element(this->entries, {}, &Entry::deadline)->deadline;
+	auto delay = std::max(deadline - this->clock.elapsed(), static_cast<qint64>(0));
+	this->timer.start(static_cast<int>(delay));
+}
+
+FileView::FileView(QObject* parent): QObject(parent) {
+	this->writeTimer.setSingleShot(true);
+	QObject::connect(&this->writeTimer, &QTimer::timeout, this, &FileView::flushPendingWrite);
+}
+
 FileView::~FileView() {
+	if (this->bPollInterval.value() > 0) FileViewPoller::instance()->removeView(this);
+	this->closePollFd();
+	this->flushPendingWriteSync();
+
 	if (this->mAdapter) {
 		this->mAdapter->setFileView(nullptr);
 	}
@@ -362,7 +442,7 @@ void FileView::operationFinished() {
 	}
 
 	qCDebug(logFileView) << "Async operation finished for" << this;
-	this->writeData = FileViewData();
+	if (!this->writePending) this->writeData = FileViewData();
 	this->updateState(this->liveOperation->state);
 
 	if (this->liveReader()) {
@@ -382,7 +462,7 @@ bool FileView::waitForJob() {
 	if (this->liveOperation != nullptr) {
 		QObject::disconnect(this->liveOperation, nullptr, this, nullptr);
 		this->liveOperation->block();
-		this->writeData = FileViewData();
+		if (!this->writePending) this->writeData = FileViewData();
 		this->updateState(this->liveOperation->state);
 
 		if (this->liveReader()) {
@@ -466,6 +546,9 @@ void FileView::setPath(const QString& path) {
 	auto p = path.startsWith("file://") ? path.sliced(7) : path;
 	if (p == this->targetPath) return;
 
+	// Pending writes belong to the old path.
+	if (this->writePending) this->flushPendingWrite();
+
 	if (this->liveWriter()) {
 		this->waitForJob();
 	} else {
@@ -478,6 +561,8 @@ void FileView::setPath(const QString& path) {
 
 void FileView::updatePath() {
 	this->mPrepared = false;
+	this->closePollFd();
+	this->pollError = FileViewError::Success;
 
 	if (this->targetPath.isEmpty()) {
 		auto state = FileViewState();
@@ -544,6 +629,108 @@ void FileView::onWatchedDirectoryChanged() {
 	}
 }
 
+void FileView::updatePolling() {
+	auto interval = this->bPollInterval.value();
+
+	if (interval > 0) {
+		FileViewPoller::instance()->addView(this, interval);
+	} else {
+		FileViewPoller::instance()->removeView(this);
+		this->closePollFd();
+	}
+}
+
+void FileView::closePollFd() {
+	if (this->pollFd != -1) {
+		close(this->pollFd);
+		this->pollFd = -1;
+	}
+}
+
+void FileView::poll() {
+	// Reads and writes in flight will update the state themselves.
+	if (this->liveOperation || this->targetPath.isEmpty()) return;
+
+	auto fail = [this](FileViewError::Enum error, const char* reason) {
+		this->closePollFd();
+
+		// Only report transitions, as the poll will likely fail the same way again.
+		if (error == this->pollError) return;
+		this->pollError = error;
+
+		if (this->bPrintErrors) {
+			qmlWarning(this) << "Poll of " << this->targetPath << " failed: " << reason;
+		}
+
+		auto state = FileViewState(this->targetPath);
+		state.exists = error != FileViewError::FileNotFound;
+		state.error = error;
+		this->updateState(state);
+		emit this->loadFailed(error);
+	};
+
+	struct stat info {};
+
+	// A file replaced by renaming another over it keeps our fd pointing at the unlinked one.
+	if (this->pollFd != -1 && (fstat(this->pollFd, &info) == -1 || info.st_nlink == 0)) {
+		this->closePollFd();
+	}
+
+	if (this->pollFd == -1) {
+		this->pollFd = open(this->targetPath.toLocal8Bit().constData(), O_RDONLY | O_CLOEXEC);
+
+		if (this->pollFd == -1) {
+			switch (errno) {
+			case ENOENT:
+			case ENOTDIR: fail(FileViewError::FileNotFound, "File does not exist."); break;
+			case EACCES:
+			case EPERM: fail(FileViewError::PermissionDenied, "Permission denied."); break;
+			default: fail(FileViewError::Unknown, "Unknown failure when opening file."); break;
+			}
+
+			return;
+		}
+
+		if (fstat(this->pollFd, &info) == -1 || !S_ISREG(info.st_mode)) {
+			fail(FileViewError::NotAFile, "Not a file.");
+			return;
+		}
+	}
+
+	// Files in /proc and /sys report a size of 0, so the buffer grows until a read comes up short.
+	if (this->pollBuffer.size() < 4096) this->pollBuffer.resize(4096);
+	qsizetype length = 0;
+
+	while (true) {
+		auto* buffer = this->pollBuffer.data() + length; // NOLINT
+		auto r = pread(this->pollFd, buffer, this->pollBuffer.size() - length, length);
+
+		if (r == -1) {
+			if (errno == EINTR) continue;
+			fail(FileViewError::Unknown, "read() failed.");
+			return;
+		} else if (r == 0) break;
+
+		length += r;
+		if (length == this->pollBuffer.size()) this->pollBuffer.resize(length * 2);
+	}
+
+	auto content = QByteArrayView(this->pollBuffer.constData(), length);
+	auto recovered = this->pollError != FileViewError::Success;
+	this->pollError = FileViewError::Success;
+
+	if (!recovered && this->state.exists
+	    && content == this->state.data.operator const QByteArray&())
+	{
+		return;
+	}
+
+	auto state = FileViewState(this->targetPath);
+	state.exists = true;
+	state.data = content.toByteArray();
+	this->updateState(state);
+}
+
 bool FileView::shouldBlockRead() const {
 	return this->mBlockAllReads || (this->mBlockLoading && !this->mLoadedOrAsync);
 }
@@ -584,20 +771,69 @@ QString FileView::text() {
 
 void FileView::setData(const QByteArray& data) {
 	if (this->writeCmpData().operator const QByteArray&() == data) return;
+	this->adapterWritePending = false;
 	this->writeData = data;
-
-	if (this->bBlockWrites) this->saveSync();
-	else this->saveAsync();
+	this->scheduleWrite();
 }
 
 void FileView::setText(const QString& text) {
 	if (this->writeCmpData().operator const QString&() == text) return;
+	this->adapterWritePending = false;
 	this->writeData = text;
+	this->scheduleWrite();
+}
+
+void FileView::scheduleWrite() {
+	this->writePending = true;
+	auto delay = this->bWriteDelay.value();
+
+	if (this->bBlockWrites || delay <= 0) {
+		this->flushPendingWrite();
+	} else if (!this->writeTimer.isActive()) {
+		// Not restarted by later writes, so continuous changes are still written periodically.
+		this->writeTimer.start(delay);
+	}
+}
+
+void FileView::flushPendingWrite() {
+	this->writeTimer.stop();
+	if (!this->writePending) return;
+	this->writePending = false;
+
+	if (this->adapterWritePending) {
+		this->adapterWritePending = false;
+		if (!this->mAdapter) return;
+
+		auto data = this->mAdapter->serializeAdapter();
+		if (this->writeCmpData().operator const QByteArray&() == data) return;
+		this->writeData = data;
+	}
 
 	if (this->bBlockWrites) this->saveSync();
 	else this->saveAsync();
 }
 
+void FileView::flushPendingWriteSync() {
+	if (!this->writePending || this->targetPath.isEmpty()) return;
+	this->writeTimer.stop();
+	this->writePending = false;
+
+	auto state = FileViewState(this->targetPath);
+	state.printErrors = this->bPrintErrors;
+
+	if (this->adapterWritePending) {
+		this->adapterWritePending = false;
+		if (!this->mAdapter) return;
+		state.data = this->mAdapter->serializeAdapter();
+	} else {
+		state.data = this->writeData;
+	}
+
+	// Only the pending data is written, as signals should not be emitted during destruction.
+	if (this->liveWriter()) this->liveOperation->block();
+	FileViewWriter::write(this, state, this->bAtomicWrites);
+}
+
 void FileView::emitDataChanged() {
 	this->dataChangedEmitter.call(this);
 	this->textChangedEmitter.call(this);
@@ -676,7 +912,12 @@ void FileView::writeAdapter() {
 		return;
 	}
 
-	this->setData(this->mAdapter->serializeAdapter());
+	if (this->bWriteDelay.value() > 0 && !this->bBlockWrites) {
+		this->adapterWritePending = true;
+		this->scheduleWrite();
+	} else {
+		this->setData(this->mAdapter->serializeAdapter());
+	}
 }
 
 void FileView::onAdapterDestroyed() { this->mAdapter = nullptr; }
@@ -3,7 +3,9 @@
 #include <utility>
 
 #include <qatomic.h>
+#include <qcontainerfwd.h>
 #include <qdebug.h>
+#include <qelapsedtimer.h>
 #include <qfilesystemwatcher.h>
 #include <qlogging.h>
 #include <qmutex.h>
@@ -15,7 +17,9 @@
 #include <qrunnable.h>
 #include <qstringview.h>
 #include <qtclasshelpermacros.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../core/doc.hpp"
 #include "../core/util.hpp"
@@ -141,6 +145,36 @@ public:
 	bool doAtomicWrite;
 };
 
+// Re-reads polled FileViews from a single timer. Deadlines are aligned to multiples of each
+// view's interval, so views with the same (or evenly dividing) intervals are read in one wakeup.
+class FileViewPoller: public QObject {
+	Q_OBJECT;
+
+public:
+	static FileViewPoller* instance();
+
+	void addView(FileView* view, qint32 interval);
+	void removeView(FileView* view);
+
+private slots:
+	void onTimeout();
+
+private:
+	FileViewPoller();
+
+	void scheduleNext();
+
+	struct Entry {
+		FileView* view = nullptr;
+		qint64 interval = 0;
+		qint64 deadline = 0;
+	};
+
+	QList<Entry> entries;
+	QTimer timer;
+	QElapsedTimer clock;
+};
+
 class FileViewAdapter;
 
 ///! Simple accessor for small files.
@@ -205,6 +239,15 @@ class FileView: public QObject {
 	/// > [!NOTE] This works by creating another file with the desired content, and renaming
 	/// > it over the existing file if successful.
 	Q_PROPERTY(bool atomicWrites READ default WRITE default NOTIFY atomicWritesChanged BINDABLE bindableAtomicWrites);
+	/// If nonzero (default 0), writes made with @@setText(), @@setData() or @@writeAdapter()
+	/// will be delayed by up to `writeDelay` milliseconds, and all writes made during the delay
+	/// will be coalesced into a single write of the latest content.
+	///
+	/// With @@writeAdapter(), the adapter is only serialized once the delay expires.
+	/// Pending writes are flushed when @@path changes or the FileView is destroyed.
+	///
+	/// This has no effect if @@blockWrites is true.
+	Q_PROPERTY(qint32 writeDelay READ default WRITE default NOTIFY writeDelayChanged BINDABLE bindableWriteDelay);
 	/// If true (default), read or write errors will be printed to the quickshell logs.
 	/// If false, all known errors will not be printed.
 	QSDOC_PROPERTY_OVERRIDE(bool printErrors READ default WRITE default NOTIFY printErrorsChanged);
@@ -220,6 +263,18 @@ class FileView: public QObject {
 	/// > }
 	/// > ```
 	Q_PROPERTY(bool watchChanges READ default WRITE default NOTIFY watchChangesChanged BINDABLE bindableWatchChanges);
+	/// If nonzero (default 0), the file will be re-read every `pollInterval` milliseconds,
+	/// replacing the common pattern of a @@QtQml.Timer calling @@reload().
+	///
+	/// Polling keeps the file open and re-reads it from the start on the UI thread, and
+	/// only emits `textChanged()` and `dataChanged()` if the content differs from the last read.
+	/// Polls of all FileViews are aligned to a shared clock, so views with the same interval
+	/// are read together. @@loaded(s) is not emitted for polls.
+	///
+	/// > [!NOTE] Polling is intended for small, fast to read files such as those in `/proc` and `/sys`.
+	/// > As the file is kept open, replacing it by renaming another file over it will only be
+	/// > noticed once the old file has been removed.
+	Q_PROPERTY(qint32 pollInterval READ default WRITE default NOTIFY pollIntervalChanged BINDABLE bindablePollInterval);
 	/// In addition to directly reading/writing the file as text, *adapters* can be used to
 	/// expose a file's content in new ways.
 	///
@@ -248,7 +303,7 @@ class FileView: public QObject {
 	QSDOC_NAMED_ELEMENT(FileView);
 
 public:
-	explicit FileView(QObject* parent = nullptr): QObject(parent) {}
+	explicit FileView(QObject* parent = nullptr);
 	~FileView() override;
 	Q_DISABLE_COPY_MOVE(FileView);
 
@@ -326,9 +381,11 @@ public:
 	// Const bindables functions silently do nothing on setValue.
 	[[nodiscard]] QBindable<bool> bindableBlockWrites() { return &this->bBlockWrites; }
 	[[nodiscard]] QBindable<bool> bindableAtomicWrites() { return &this->bAtomicWrites; }
+	[[nodiscard]] QBindable<qint32> bindableWriteDelay() { return &this->bWriteDelay; }
 
 	[[nodiscard]] QBindable<bool> bindablePrintErrors() { return &this->bPrintErrors; }
 	[[nodiscard]] QBindable<bool> bindableWatchChanges() { return &this->bWatchChanges; }
+	[[nodiscard]] QBindable<qint32> bindablePollInterval() { return &this->bPollInterval; }
 
 	[[nodiscard]] FileViewAdapter* adapter() const;
 	void setAdapter(FileViewAdapter* adapter);
@@ -358,13 +415,16 @@ signals:
 	void blockAllReadsChanged();
 	void blockWritesChanged();
 	void atomicWritesChanged();
+	void writeDelayChanged();
 	void printErrorsChanged();
 	void watchChangesChanged();
+	void pollIntervalChanged();
 	void adapterChanged();
 
 private slots:
 	void operationFinished();
 	void onAdapterDestroyed();
+	void flushPendingWrite();
 
 private:
 	void loadAsync(bool doStringConversion);
@@ -372,11 +432,16 @@ private:
 	void cancelAsync();
 	void loadSync();
 	void saveSync();
+	void scheduleWrite();
+	void flushPendingWriteSync();
 	void updateState(FileViewState& newState);
 	void updatePath();
 	void updateWatchedFiles();
 	void onWatchedFileChanged();
 	void onWatchedDirectoryChanged();
+	void updatePolling();
+	void closePollFd();
+	void poll();
 
 	[[nodiscard]] bool shouldBlockRead() const;
 	[[nodiscard]] FileViewReader* liveReader() const;
@@ -385,6 +450,9 @@ private:
 
 	FileViewState state;
 	FileViewData writeData;
+	QTimer writeTimer;
+	bool writePending = false;
+	bool adapterWritePending = false;
 	FileViewOperation* liveOperation = nullptr;
 	QString pathInFlight;
 
@@ -401,6 +469,10 @@ private:
 	FileViewAdapter* mAdapter = nullptr;
 	QFileSystemWatcher* watcher = nullptr;
 
+	int pollFd = -1;
+	QByteArray pollBuffer;
+	FileViewError::Enum pollError = FileViewError::Success;
+
 	GuardedEmitter<&FileView::internalTextChanged> textChangedEmitter;
 	GuardedEmitter<&FileView::internalDataChanged> dataChangedEmitter;
 	void emitDataChanged();
@@ -421,15 +493,20 @@ public:
 	// clang-format off
 	Q_OBJECT_BINDABLE_PROPERTY(FileView, bool, bBlockWrites, &FileView::blockWritesChanged);
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(FileView, bool, bAtomicWrites, true, &FileView::atomicWritesChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(FileView, qint32, bWriteDelay, &FileView::writeDelayChanged);
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(FileView, bool, bPrintErrors, true, &FileView::printErrorsChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(FileView, bool, bWatchChanges, &FileView::watchChangesChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(FileView, qint32, bPollInterval, &FileView::pollIntervalChanged);
 	// clang-format on
 
 	QS_BINDING_SUBSCRIBE_METHOD(FileView, bWatchChanges, updateWatchedFiles, onValueChanged);
+	QS_BINDING_SUBSCRIBE_METHOD(FileView, bPollInterval, updatePolling, onValueChanged);
 
 	void setPreload(bool preload);
 	void setBlockLoading(bool blockLoading);
 	void setBlockAllReads(bool blockAllReads);
+
+	friend class FileViewPoller;
 };
 
 /// See @@FileView.adapter.
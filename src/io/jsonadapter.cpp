@@ -12,6 +12,7 @@
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qobjectdefs.h>
+#include <qproperty.h>
 #include <qqml.h>
 #include <qqmlengine.h>
 #include <qqmlinfo.h>
@@ -57,34 +58,52 @@ void JsonAdapter::deserializeAdapter(const QByteArray& data) {
 	this->connectNotifiers();
 }
 
+namespace {
+
+int notifySlotIndex() {
+	static const auto index = JsonAdapter::staticMetaObject.indexOfSlot("onPropertyChanged()");
+	return index;
+}
+
+} // namespace
+
 void JsonAdapter::connectNotifiers() {
-	auto notifySlot = JsonAdapter::staticMetaObject.indexOfSlot("onPropertyChanged()");
-	this->connectNotifiersRec(notifySlot, this, &JsonAdapter::staticMetaObject);
+	this->connectNotifiersRec(this, &JsonAdapter::staticMetaObject);
 }
 
-void JsonAdapter::connectNotifiersRec(int notifySlot, QObject* obj, const QMetaObject* base) {
+// The tree walks below start after all properties of `base`, so only properties declared
+// in QML are serialized. Settings of the adapter itself, such as compact, are left out.
+void JsonAdapter::connectNotifiersRec(QObject* obj, const QMetaObject* base) {
 	const auto* metaObject = obj->metaObject();
 
-	for (auto i = base->propertyOffset(); i != metaObject->propertyCount(); i++) {
+	for (auto i = base->propertyCount(); i != metaObject->propertyCount(); i++) {
 		const auto prop = metaObject->property(i);
 
 		if (prop.isReadable() && prop.hasNotifySignal()) {
-			QMetaObject::connect(obj, prop.notifySignalIndex(), this, notifySlot, Qt::UniqueConnection);
-
-			auto val = prop.read(obj);
-			if (val.canView<JsonObject*>()) {
-				auto* pobj = prop.read(obj).view<JsonObject*>();
-				if (pobj) this->connectNotifiersRec(notifySlot, pobj, &JsonObject::staticMetaObject);
-			} else if (val.canConvert<QQmlListProperty<JsonObject>>()) {
-				auto listVal = val.value<QQmlListProperty<JsonObject>>();
-
-				auto len = listVal.count(&listVal);
-				for (auto i = 0; i != len; i++) {
-					auto* pobj = listVal.at(&listVal, i);
+			QMetaObject::connect(
+			    obj,
+			    prop.notifySignalIndex(),
+			    this,
+			    notifySlotIndex(),
+			    Qt::UniqueConnection
+			);
+
+			this->connectNotifiersValue(prop.read(obj));
+		}
+	}
+}
 
-					if (pobj) this->connectNotifiersRec(notifySlot, pobj, &JsonObject::staticMetaObject);
-				}
-			}
+void JsonAdapter::connectNotifiersValue(const QVariant& value) {
+	if (value.canView<JsonObject*>()) {
+		auto* pobj = value.view<JsonObject*>();
+		if (pobj) this->connectNotifiersRec(pobj, &JsonObject::staticMetaObject);
+	} else if (value.canConvert<QQmlListProperty<JsonObject>>()) {
+		auto listVal = value.value<QQmlListProperty<JsonObject>>();
+
+		auto len = listVal.count(&listVal);
+		for (auto i = 0; i != len; i++) {
+			auto* pobj = listVal.at(&listVal, i);
+			if (pobj) this->connectNotifiersRec(pobj, &JsonObject::staticMetaObject);
 		}
 	}
 }
@@ -92,20 +111,38 @@ void JsonAdapter::connectNotifiersRec(int notifySlot, QObject* obj, const QMetaO
 void JsonAdapter::onPropertyChanged() {
 	if (this->changesBlocked) return;
 
-	this->connectNotifiers();
+	// Only the changed property can have brought new objects into the tree,
+	// so the rest of the tree does not need to be walked again.
+	auto* sender = this->sender();
+	auto signalIndex = this->senderSignalIndex();
+
+	if (sender == nullptr || signalIndex == -1) {
+		this->connectNotifiers();
+	} else {
+		const auto* metaObject = sender->metaObject();
+
+		for (auto i = 0; i != metaObject->propertyCount(); i++) {
+			const auto prop = metaObject->property(i);
+
+			if (prop.notifySignalIndex() == signalIndex && prop.isReadable()) {
+				this->connectNotifiersValue(prop.read(sender));
+			}
+		}
+	}
+
 	this->adapterUpdated();
 }
 
 QByteArray JsonAdapter::serializeAdapter() {
-	return QJsonDocument(this->serializeRec(this, &JsonAdapter::staticMetaObject))
-	    .toJson(QJsonDocument::Indented);
+	auto format = this->bCompact ? QJsonDocument::Compact : QJsonDocument::Indented;
+	return QJsonDocument(this->serializeRec(this, &JsonAdapter::staticMetaObject)).toJson(format);
 }
 
 QJsonObject JsonAdapter::serializeRec(const QObject* obj, const QMetaObject* base) const {
 	QJsonObject json;
 	const auto* metaObject = obj->metaObject();
 
-	for (auto i = base->propertyOffset(); i != metaObject->propertyCount(); i++) {
+	for (auto i = base->propertyCount(); i != metaObject->propertyCount(); i++) {
 		const auto prop = metaObject->property(i);
 
 		if (prop.isReadable() && prop.hasNotifySignal()) {
@@ -160,7 +197,7 @@ QJsonObject JsonAdapter::serializeRec(const QObject* obj, const QMetaObject* bas
 void JsonAdapter::deserializeRec(const QJsonObject& json, QObject* obj, const QMetaObject* base) {
 	const auto* metaObject = obj->metaObject();
 
-	for (auto i = base->propertyOffset(); i != metaObject->propertyCount(); i++) {
+	for (auto i = base->propertyCount(); i != metaObject->propertyCount(); i++) {
 		const auto prop = metaObject->property(i);
 		if (json.contains(prop.name())) {
 			auto jval = json.value(prop.name());
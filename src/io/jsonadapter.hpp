@@ -6,10 +6,12 @@
 #include <qjsvalue.h>
 #include <qlist.h>
 #include <qobjectdefs.h>
+#include <qproperty.h>
 #include <qqmlintegration.h>
 #include <qqmlparserstatus.h>
 #include <qstringview.h>
 #include <qtmetamacros.h>
+#include <qvariant.h>
 
 #include "fileview.hpp"
 
@@ -86,12 +88,19 @@ class JsonObject: public QObject {
 ///    }
 /// }
 /// ```
+///
+/// > [!NOTE] Adapters that change frequently, for example from a slider, should set
+/// > @@FileView.writeDelay to avoid rewriting the file on every change.
 class JsonAdapter
     : public FileViewAdapter
     , public QQmlParserStatus {
 	Q_OBJECT;
 	QML_ELEMENT;
 	Q_INTERFACES(QQmlParserStatus);
+	// clang-format off
+	/// If true (default false), the JSON document will be written without indentation or newlines.
+	Q_PROPERTY(bool compact READ default WRITE default NOTIFY compactChanged BINDABLE bindableCompact);
+	// clang-format on
 
 public:
 	void classBegin() override {}
@@ -100,18 +109,26 @@ public:
 	void deserializeAdapter(const QByteArray& data) override;
 	[[nodiscard]] QByteArray serializeAdapter() override;
 
+	[[nodiscard]] QBindable<bool> bindableCompact() { return &this->bCompact; }
+
+signals:
+	void compactChanged();
+
 private slots:
 	void onPropertyChanged();
 
 private:
 	void connectNotifiers();
-	void connectNotifiersRec(int notifySlot, QObject* obj, const QMetaObject* base);
+	void connectNotifiersRec(QObject* obj, const QMetaObject* base);
+	void connectNotifiersValue(const QVariant& value);
 	void deserializeRec(const QJsonObject& json, QObject* obj, const QMetaObject* base);
 	[[nodiscard]] QJsonObject serializeRec(const QObject* obj, const QMetaObject* base) const;
 
 	bool changesBlocked = false;
 	QList<JsonObject*> createdObjects;
 	QList<JsonObject*> oldCreatedObjects;
+
+	Q_OBJECT_BINDABLE_PROPERTY(JsonAdapter, bool, bCompact, &JsonAdapter::compactChanged);
 };
 
 } // namespace qs::io
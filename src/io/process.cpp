@@ -87,6 +87,7 @@ QHash<QString, QVariant> Process::environment() const { return this->mEnvironmen
 void Process::setEnvironment(QHash<QString, QVariant> environment) {
 	if (environment == this->mEnvironment) return;
 	this->mEnvironment = std::move(environment);
+	this->environmentBuilt = false;
 	emit this->environmentChanged();
 }
 
@@ -95,6 +96,7 @@ bool Process::environmentCleared() const { return this->mClearEnvironment; }
 void Process::setEnvironmentCleared(bool cleared) {
 	if (cleared == this->mClearEnvironment) return;
 	this->mClearEnvironment = cleared;
+	this->environmentBuilt = false;
 	emit this->environmentClearChanged();
 }
 
@@ -213,6 +215,7 @@ void Process::startProcessIfReady() {
 	if (!this->mStdinEnabled) this->process->closeWriteChannel();
 
 	this->setupEnvironment(this->process);
+	qs::io::process::setupSpawnParameters(this->process);
 	this->process->start(cmd, args);
 }
 
@@ -262,7 +265,14 @@ void Process::setupEnvironment(QProcess* process) {
 		process->setWorkingDirectory(this->mWorkingDirectory);
 	}
 
-	qs::io::process::setupProcessEnvironment(process, this->mClearEnvironment, this->mEnvironment);
+	// Rebuilding the environment is wasted work for processes restarted on an interval.
+	if (!this->environmentBuilt) {
+		this->builtEnvironment =
+		    qs::io::process::buildProcessEnvironment(this->mClearEnvironment, this->mEnvironment);
+		this->environmentBuilt = true;
+	}
+
+	process->setProcessEnvironment(this->builtEnvironment);
 }
 
 void Process::onStarted() {
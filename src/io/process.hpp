@@ -31,6 +31,31 @@
 ///   }
 /// }
 /// ```
+///
+/// #### Persistent workers
+/// Starting a process has a noticeable cost. Instead of restarting a command on a timer,
+/// prefer commands that stay running and report changes themselves (e.g. `pactl subscribe`
+/// or `nmcli monitor`), or keep a single worker running and request an update by
+/// writing a line to its stdin.
+///
+/// ```qml
+/// Process {
+///   id: worker
+///   running: true
+///   stdinEnabled: true
+///   command: [ "python3", "-u", Qt.resolvedUrl("worker.py").toString().slice(7) ]
+///   stdout: @@SplitParser {
+///     onRead: data => console.log(`response: ${data}`)
+///   }
+/// }
+///
+/// Timer {
+///   running: true
+///   repeat: true
+///   interval: 1000
+///   onTriggered: worker.write("poll\n")
+/// }
+/// ```
 class Process: public PostReloadHook {
 	Q_OBJECT;
 	// clang-format off
@@ -248,6 +273,8 @@ private:
 	QList<QString> mCommand;
 	QString mWorkingDirectory;
 	QHash<QString, QVariant> mEnvironment;
+	QProcessEnvironment builtEnvironment;
+	bool environmentBuilt = false;
 	DataStreamParser* mStdoutParser = nullptr;
 	DataStreamParser* mStderrParser = nullptr;
 	QByteArray stdoutBuffer;
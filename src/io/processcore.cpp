@@ -3,17 +3,14 @@
 #include <qcontainerfwd.h>
 #include <qhash.h>
 #include <qprocess.h>
+#include <qtversionchecks.h>
 #include <qvariant.h>
 
 #include "../core/common.hpp"
 
 namespace qs::io::process {
 
-void setupProcessEnvironment(
-    QProcess* process,
-    bool clear,
-    const QHash<QString, QVariant>& envChanges
-) {
+QProcessEnvironment buildProcessEnvironment(bool clear, const QHash<QString, QVariant>& envChanges) {
 	const auto& sysenv = qs::Common::INITIAL_ENVIRONMENT;
 	auto env = clear ? QProcessEnvironment() : sysenv;
 
@@ -31,7 +28,25 @@ void setupProcessEnvironment(
 		}
 	}
 
-	process->setProcessEnvironment(env);
+	return env;
+}
+
+void setupProcessEnvironment(
+    QProcess* process,
+    bool clear,
+    const QHash<QString, QVariant>& envChanges
+) {
+	process->setProcessEnvironment(buildProcessEnvironment(clear, envChanges));
+}
+
+void setupSpawnParameters([[maybe_unused]] QProcess* process) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+	// No child process modifier is ever set, so the child can safely share our address space
+	// until exec, skipping the page table copy of a full fork.
+	auto params = process->unixProcessParameters();
+	params.flags |= QProcess::UnixProcessFlag::UseVFork;
+	process->setUnixProcessParameters(params);
+#endif
 }
 
 } // namespace qs::io::process
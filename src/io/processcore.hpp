@@ -60,10 +60,15 @@ public:
 	bool unbindStdout : 1 = true;
 };
 
+QProcessEnvironment buildProcessEnvironment(bool clear, const QHash<QString, QVariant>& envChanges);
+
 void setupProcessEnvironment(
     QProcess* process,
     bool clear,
     const QHash<QString, QVariant>& envChanges
 );
 
+// Applies spawn parameters shared by all processes started by quickshell.
+void setupSpawnParameters(QProcess* process);
+
 } // namespace qs::io::process
@@ -0,0 +1,400 @@
+#include "systemstats.hpp"
+#include <algorithm>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qdir.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qobjectdefs.h>
+#include <qproperty.h>
+#include <qtypes.h>
+#include <unistd.h>
+
+#include "../core/logcat.hpp"
+
+namespace qs::io {
+
+namespace {
+QS_LOGGING_CATEGORY(logSystemStats, "quickshell.io.systemstats", QtWarningMsg);
+}
+
+namespace stats {
+
+bool StatTokenizer::nextLine(QByteArrayView& line) {
+	if (this->data.isEmpty()) return false;
+
+	auto end = this->data.indexOf('\n');
+
+	if (end == -1) {
+		line = this->data;
+		this->data = QByteArrayView();
+	} else {
+		line = this->data.first(end);
+		this->data = this->data.sliced(end + 1);
+	}
+
+	return true;
+}
+
+QByteArrayView StatTokenizer::nextToken(QByteArrayView& line) {
+	qsizetype start = 0;
+	while (start < line.size() && (line[start] == ' ' || line[start] == '\t')) start++;
+
+	auto end = start;
+	while (end < line.size() && line[end] != ' ' && line[end] != '\t') end++;
+
+	auto token = line.sliced(start, end - start);
+	line = line.sliced(end);
+	return token;
+}
+
+quint64 StatTokenizer::toUInt(QByteArrayView token) {
+	quint64 value = 0;
+
+	for (auto c: token) {
+		if (c < '0' || c > '9') break;
+		value = value * 10 + (c - '0');
+	}
+
+	return value;
+}
+
+StatFile::~StatFile() {
+	if (this->fd != -1) close(this->fd);
+}
+
+QByteArrayView StatFile::read() {
+	if (this->fd == -1) {
+		this->fd = open(this->path.toLocal8Bit().constData(), O_RDONLY | O_CLOEXEC);
+
+		if (this->fd == -1) {
+			qCDebug(logSystemStats) << "Could not open" << this->path << "errno" << errno;
+			return QByteArrayView();
+		}
+	}
+
+	// Files in /proc and /sys report a size of 0, so the buffer grows until a read comes up short.
+	if (this->buffer.size() < 4096) this->buffer.resize(4096);
+	qsizetype length = 0;
+
+	while (true) {
+		auto* data = this->buffer.data() + length; // NOLINT
+		auto r = pread(this->fd, data, this->buffer.size() - length, length);
+
+		if (r == -1) {
+			if (errno == EINTR) continue;
+			qCDebug(logSystemStats) << "Could not read" << this->path << "errno" << errno;
+			close(this->fd);
+			this->fd = -1;
+			return QByteArrayView();
+		} else if (r == 0) break;
+
+		length += r;
+		if (length == this->buffer.size()) this->buffer.resize(length * 2);
+	}
+
+	return QByteArrayView(this->buffer.constData(), length);
+}
+
+qreal CpuTimes::usageSince(const CpuTimes& previous) const {
+	if (this->total <= previous.total || this->busy < previous.busy) return 0;
+
+	auto busy = static_cast<qreal>(this->busy - previous.busy);
+	return std::clamp(busy / static_cast<qreal>(this->total - previous.total), 0.0, 1.0);
+}
+
+bool parseProcStat(QByteArrayView data, CpuSample& sample) {
+	auto tokenizer = StatTokenizer(data);
+	QByteArrayView line;
+	qsizetype core = 0;
+	auto foundTotal = false;
+
+	while (tokenizer.nextLine(line)) {
+		auto label = StatTokenizer::nextToken(line);
+		if (!label.startsWith("cpu")) {
+			// cpu lines come first
+			if (foundTotal) break;
+			continue;
+		}
+
+		// user nice system idle iowait irq softirq steal. Guest time is already counted in user.
+		auto times = CpuTimes();
+		for (auto i = 0; i != 8; i++) {
+			auto value = StatTokenizer::toUInt(StatTokenizer::nextToken(line));
+			times.total += value;
+			if (i != 3 && i != 4) times.busy += value;
+		}
+
+		if (label.size() == 3) {
+			sample.total = times;
+			foundTotal = true;
+		} else {
+			if (core == sample.cores.size()) sample.cores.append(times);
+			else sample.cores[core] = times;
+			core++;
+		}
+	}
+
+	if (core < sample.cores.size()) sample.cores.resize(core);
+	return foundTotal;
+}
+
+bool parseMeminfo(QByteArrayView data, MemorySample& sample) {
+	auto tokenizer = StatTokenizer(data);
+	QByteArrayView line;
+	auto found = 0;
+
+	while (tokenizer.nextLine(line)) {
+		auto key = StatTokenizer::nextToken(line);
+		quint64* target = nullptr;
+
+		if (key == "MemTotal:") target = &sample.total;
+		else if (key == "MemFree:") target = &sample.free;
+		else if (key == "MemAvailable:") target = &sample.available;
+		else if (key == "SwapTotal:") target = &sample.swapTotal;
+		else if (key == "SwapFree:") target = &sample.swapFree;
+		else continue;
+
+		*target = StatTokenizer::toUInt(StatTokenizer::nextToken(line)) * 1024;
+		if (++found == 5) break;
+	}
+
+	return found == 5;
+}
+
+bool parseNetDev(QByteArrayView data, IoCounters& counters) {
+	auto tokenizer = StatTokenizer(data);
+	QByteArrayView line;
+	auto found = false;
+	counters = IoCounters();
+
+	while (tokenizer.nextLine(line)) {
+		// The interface name and first counter may not be separated by whitespace.
+		auto colon = line.indexOf(':');
+		if (colon == -1) continue;
+
+		auto name = line.first(colon).trimmed();
+		line = line.sliced(colon + 1);
+		found = true;
+		if (name == "lo") continue;
+
+		// bytes packets errs drop fifo frame compressed multicast, then the same for transmit
+		counters.read += StatTokenizer::toUInt(StatTokenizer::nextToken(line));
+		for (auto i = 0; i != 7; i++) StatTokenizer::nextToken(line);
+		counters.written += StatTokenizer::toUInt(StatTokenizer::nextToken(line));
+	}
+
+	return found;
+}
+
+bool parseDiskstats(QByteArrayView data, const QList<QByteArray>& disks, IoCounters& counters) {
+	auto tokenizer = StatTokenizer(data);
+	QByteArrayView line;
+	auto found = false;
+	counters = IoCounters();
+
+	while (tokenizer.nextLine(line)) {
+		StatTokenizer::nextToken(line); // major
+		StatTokenizer::nextToken(line); // minor
+		auto name = StatTokenizer::nextToken(line);
+		if (name.isEmpty()) continue;
+		found = true;
+
+		if (!std::ranges::any_of(disks, [&](const QByteArray& disk) { return disk == name; })) {
+			continue;
+		}
+
+		// reads merged sectors ms, then the same for writes. Sectors are always 512 bytes here.
+		StatTokenizer::nextToken(line);
+		StatTokenizer::nextToken(line);
+		counters.read += StatTokenizer::toUInt(StatTokenizer::nextToken(line)) * 512;
+		StatTokenizer::nextToken(line);
+		StatTokenizer::nextToken(line);
+		StatTokenizer::nextToken(line);
+		counters.written += StatTokenizer::toUInt(StatTokenizer::nextToken(line)) * 512;
+	}
+
+	return found;
+}
+
+bool parseHwmonTemp(QByteArrayView data, qreal& celsius) {
+	auto line = data.trimmed();
+	if (line.isEmpty()) return false;
+
+	auto negative = line.startsWith('-');
+	if (negative) line = line.sliced(1);
+
+	auto millidegrees = static_cast<qreal>(StatTokenizer::toUInt(line));
+	celsius = (negative ? -millidegrees : millidegrees) / 1000.0;
+	return true;
+}
+
+} // namespace stats
+
+SystemStats::SystemStats(QObject* parent): QObject(parent) {
+	QObject::connect(&this->timer, &QTimer::timeout, this, &SystemStats::sample);
+}
+
+SystemStats::~SystemStats() { qDeleteAll(this->hwmonFiles); }
+
+void SystemStats::updateSampling() {
+	auto metrics = this->bMetrics.value();
+	auto interval = this->bInterval.value();
+
+	if (!metrics || interval <= 0) {
+		this->timer.stop();
+		this->sampledMetrics = None;
+		this->sinceLastSample.invalidate();
+		return;
+	}
+
+	this->timer.start(interval);
+
+	// Newly enabled metrics are sampled immediately, deferred to coalesce property initialization.
+	if ((metrics & ~this->sampledMetrics).toInt() != 0 && !this->samplePending) {
+		this->samplePending = true;
+		QMetaObject::invokeMethod(this, &SystemStats::sample, Qt::QueuedConnection);
+	}
+}
+
+void SystemStats::sample() {
+	this->samplePending = false;
+
+	auto metrics = this->bMetrics.value();
+	auto seconds = this->sinceLastSample.isValid()
+	                 ? static_cast<qreal>(this->sinceLastSample.restart()) / 1000.0
+	                 : 0.0;
+
+	if (!this->sinceLastSample.isValid()) this->sinceLastSample.start();
+
+	Qt::beginPropertyUpdateGroup();
+	if (metrics.testFlag(Cpu)) this->sampleCpu();
+	if (metrics.testFlag(Memory)) this->sampleMemory();
+	if (metrics.testFlag(Network)) this->sampleNetwork(seconds);
+	if (metrics.testFlag(Disk)) this->sampleDisk(seconds);
+	if (metrics.testFlag(Thermal)) this->sampleThermal();
+	Qt::endPropertyUpdateGroup();
+
+	this->sampledMetrics = metrics;
+}
+
+void SystemStats::sampleCpu() {
+	if (!stats::parseProcStat(this->procStat.read(), this->currentCpu)) return;
+
+	if (this->sampledMetrics.testFlag(Cpu)) {
+		this->bCpuUsage = this->currentCpu.total.usageSince(this->lastCpu.total);
+
+		auto cores = this->bCpuCoreUsage.value();
+		cores.resize(this->currentCpu.cores.size());
+
+		for (auto i = 0; i != this->currentCpu.cores.size(); i++) {
+			auto previous = stats::CpuTimes();
+			if (i < this->lastCpu.cores.size()) previous = this->lastCpu.cores.at(i);
+			cores[i] = this->currentCpu.cores.at(i).usageSince(previous);
+		}
+
+		this->bCpuCoreUsage = cores;
+	}
+
+	std::swap(this->lastCpu, this->currentCpu);
+}
+
+void SystemStats::sampleMemory() {
+	auto memory = stats::MemorySample();
+	if (!stats::parseMeminfo(this->procMeminfo.read(), memory)) return;
+
+	this->bMemoryTotal = static_cast<qreal>(memory.total);
+	this->bMemoryAvailable = static_cast<qreal>(memory.available);
+	this->bMemoryUsed = static_cast<qreal>(memory.total - std::min(memory.available, memory.total));
+	this->bSwapTotal = static_cast<qreal>(memory.swapTotal);
+	this->bSwapUsed =
+	    static_cast<qreal>(memory.swapTotal - std::min(memory.swapFree, memory.swapTotal));
+}
+
+void SystemStats::sampleNetwork(qreal seconds) {
+	auto counters = stats::IoCounters();
+	if (!stats::parseNetDev(this->procNetDev.read(), counters)) return;
+
+	// Counters go backwards when interfaces are removed.
+	if (this->sampledMetrics.testFlag(Network) && seconds > 0
+	    && counters.read >= this->lastNetwork.read && counters.written >= this->lastNetwork.written)
+	{
+		auto received = counters.read - this->lastNetwork.read;
+		auto sent = counters.written - this->lastNetwork.written;
+		this->bNetworkReceiveRate = static_cast<qreal>(received) / seconds;
+		this->bNetworkSendRate = static_cast<qreal>(sent) / seconds;
+	}
+
+	this->lastNetwork = counters;
+}
+
+void SystemStats::sampleDisk(qreal seconds) {
+	if (!this->sampledMetrics.testFlag(Disk)) {
+		// Partitions are not listed in /sys/block, and virtual devices would count
+		// io to their backing disks twice.
+		this->disks.clear();
+
+		for (const auto& name: QDir("/sys/block").entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+			if (name.startsWith("loop") || name.startsWith("ram") || name.startsWith("zram")
+			    || name.startsWith("dm-") || name.startsWith("md"))
+			{
+				continue;
+			}
+
+			this->disks.append(name.toUtf8());
+		}
+
+		qCDebug(logSystemStats) << "Sampling disks" << this->disks;
+	}
+
+	auto counters = stats::IoCounters();
+	if (!stats::parseDiskstats(this->procDiskstats.read(), this->disks, counters)) return;
+
+	if (this->sampledMetrics.testFlag(Disk) && seconds > 0 && counters.read >= this->lastDisk.read
+	    && counters.written >= this->lastDisk.written)
+	{
+		this->bDiskReadRate = static_cast<qreal>(counters.read - this->lastDisk.read) / seconds;
+		this->bDiskWriteRate = static_cast<qreal>(counters.written - this->lastDisk.written) / seconds;
+	}
+
+	this->lastDisk = counters;
+}
+
+void SystemStats::sampleThermal() {
+	if (!this->sampledMetrics.testFlag(Thermal)) {
+		qDeleteAll(this->hwmonFiles);
+		this->hwmonFiles.clear();
+
+		auto hwmonDir = QDir("/sys/class/hwmon");
+		for (const auto& hwmon: hwmonDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+			auto dir = QDir(hwmonDir.filePath(hwmon));
+
+			for (const auto& input: dir.entryList({"temp*_input"}, QDir::Files)) {
+				this->hwmonFiles.append(new stats::StatFile(dir.filePath(input)));
+			}
+		}
+
+		qCDebug(logSystemStats) << "Found" << this->hwmonFiles.size() << "hwmon temperature inputs";
+	}
+
+	auto found = false;
+	qreal max = 0;
+
+	for (auto* file: this->hwmonFiles) {
+		qreal celsius = 0;
+		if (!stats::parseHwmonTemp(file->read(), celsius)) continue;
+
+		max = found ? std::max(max, celsius) : celsius;
+		found = true;
+	}
+
+	if (found) this->bTemperature = max;
+}
+
+} // namespace qs::io
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <utility>
+
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qproperty.h>
+#include <qqmlintegration.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+#include "../core/util.hpp"
+
+namespace qs::io {
+
+namespace stats {
+
+// Splits the content of procfs and sysfs files without allocating.
+class StatTokenizer {
+public:
+	explicit StatTokenizer(QByteArrayView data): data(data) {}
+
+	// Sets line to the next line without its newline. Returns false once all data was consumed.
+	bool nextLine(QByteArrayView& line);
+
+	// Removes the next whitespace separated token from line and returns it.
+	static QByteArrayView nextToken(QByteArrayView& line);
+	// Parses the leading decimal digits of token, ignoring anything after them.
+	static quint64 toUInt(QByteArrayView token);
+
+private:
+	QByteArrayView data;
+};
+
+// A file kept open and re-read from the start on every read.
+class StatFile {
+public:
+	explicit StatFile(QString path): path(std::move(path)) {}
+	~StatFile();
+	Q_DISABLE_COPY_MOVE(StatFile);
+
+	// Returns the full content of the file, or a null view if it could not be read.
+	// The view is valid until the next call.
+	QByteArrayView read();
+
+	[[nodiscard]] const QString& filePath() const { return this->path; }
+
+private:
+	QString path;
+	int fd = -1;
+	QByteArray buffer;
+};
+
+struct CpuTimes {
+	quint64 busy = 0;
+	quint64 total = 0;
+
+	// Fraction of time spent busy between previous and this.
+	[[nodiscard]] qreal usageSince(const CpuTimes& previous) const;
+};
+
+struct CpuSample {
+	CpuTimes total;
+	QList<CpuTimes> cores;
+};
+
+struct MemorySample {
+	quint64 total = 0;
+	quint64 free = 0;
+	quint64 available = 0;
+	quint64 swapTotal = 0;
+	quint64 swapFree = 0;
+};
+
+struct IoCounters {
+	quint64 read = 0;
+	quint64 written = 0;
+};
+
+// Parses /proc/stat. The core list is only reallocated if the number of cores changes.
+bool parseProcStat(QByteArrayView data, CpuSample& sample);
+// Parses /proc/meminfo, converting all values to bytes.
+bool parseMeminfo(QByteArrayView data, MemorySample& sample);
+// Parses /proc/net/dev, summing received and transmitted bytes of all interfaces except loopback.
+bool parseNetDev(QByteArrayView data, IoCounters& counters);
+// Parses /proc/diskstats, summing bytes read and written by the given disks.
+// Partitions must not be included in disks, as they would be counted twice.
+bool parseDiskstats(QByteArrayView data, const QList<QByteArray>& disks, IoCounters& counters);
+// Parses a hwmon temp*_input file, returning degrees celsius.
+bool parseHwmonTemp(QByteArrayView data, qreal& celsius);
+
+} // namespace stats
+
+///! Native sampler for common system metrics.
+/// Samples CPU, memory, network, disk and temperature statistics directly from
+/// `/proc` and `/sys` on an interval, without parsing them in javascript.
+///
+/// Only metrics selected in @@metrics are read, and properties only emit change
+/// signals when their value changes.
+///
+/// #### Example
+/// ```qml
+/// SystemStats {
+///   id: stats
+///   metrics: SystemStats.Cpu | SystemStats.Memory
+///   interval: 2000
+/// }
+///
+/// Text {
+///   text: `CPU ${Math.round(stats.cpuUsage * 100)}% RAM ${Math.round(stats.memoryUsed / 1e9)}GB`
+/// }
+/// ```
+class SystemStats: public QObject {
+	Q_OBJECT;
+	QML_ELEMENT;
+	// clang-format off
+	/// The metrics to sample. Defaults to none.
+	Q_PROPERTY(qs::io::SystemStats::Metrics metrics READ default WRITE default NOTIFY metricsChanged BINDABLE bindableMetrics);
+	/// The sampling interval in milliseconds. Defaults to 1000.
+	Q_PROPERTY(qint32 interval READ default WRITE default NOTIFY intervalChanged BINDABLE bindableInterval);
+	/// Fraction of time all CPU cores spent busy since the last sample, from 0 to 1.
+	Q_PROPERTY(qreal cpuUsage READ default NOTIFY cpuUsageChanged BINDABLE bindableCpuUsage);
+	/// Fraction of time each CPU core spent busy since the last sample, from 0 to 1.
+	Q_PROPERTY(QList<qreal> cpuCoreUsage READ default NOTIFY cpuCoreUsageChanged BINDABLE bindableCpuCoreUsage);
+	/// Total usable memory in bytes.
+	Q_PROPERTY(qreal memoryTotal READ default NOTIFY memoryTotalChanged BINDABLE bindableMemoryTotal);
+	/// Memory available for new allocations without swapping, in bytes.
+	Q_PROPERTY(qreal memoryAvailable READ default NOTIFY memoryAvailableChanged BINDABLE bindableMemoryAvailable);
+	/// Memory in use, excluding reclaimable caches, in bytes.
+	Q_PROPERTY(qreal memoryUsed READ default NOTIFY memoryUsedChanged BINDABLE bindableMemoryUsed);
+	/// Total swap space in bytes.
+	Q_PROPERTY(qreal swapTotal READ default NOTIFY swapTotalChanged BINDABLE bindableSwapTotal);
+	/// Swap space in use, in bytes.
+	Q_PROPERTY(qreal swapUsed READ default NOTIFY swapUsedChanged BINDABLE bindableSwapUsed);
+	/// Bytes per second received by all non loopback network interfaces.
+	Q_PROPERTY(qreal networkReceiveRate READ default NOTIFY networkReceiveRateChanged BINDABLE bindableNetworkReceiveRate);
+	/// Bytes per second sent by all non loopback network interfaces.
+	Q_PROPERTY(qreal networkSendRate READ default NOTIFY networkSendRateChanged BINDABLE bindableNetworkSendRate);
+	/// Bytes per second read from all disks.
+	Q_PROPERTY(qreal diskReadRate READ default NOTIFY diskReadRateChanged BINDABLE bindableDiskReadRate);
+	/// Bytes per second written to all disks.
+	Q_PROPERTY(qreal diskWriteRate READ default NOTIFY diskWriteRateChanged BINDABLE bindableDiskWriteRate);
+	/// The highest temperature reported by any hwmon sensor, in degrees celsius.
+	Q_PROPERTY(qreal temperature READ default NOTIFY temperatureChanged BINDABLE bindableTemperature);
+	// clang-format on
+
+public:
+	enum Metric : quint8 {
+		None = 0,
+		/// Updates @@cpuUsage and @@cpuCoreUsage.
+		Cpu = 1,
+		/// Updates @@memoryTotal, @@memoryAvailable, @@memoryUsed, @@swapTotal and @@swapUsed.
+		Memory = 2,
+		/// Updates @@networkReceiveRate and @@networkSendRate.
+		Network = 4,
+		/// Updates @@diskReadRate and @@diskWriteRate.
+		Disk = 8,
+		/// Updates @@temperature.
+		Thermal = 16,
+	};
+	Q_DECLARE_FLAGS(Metrics, Metric);
+	Q_FLAG(Metrics);
+
+	explicit SystemStats(QObject* parent = nullptr);
+	~SystemStats() override;
+	Q_DISABLE_COPY_MOVE(SystemStats);
+
+	[[nodiscard]] QBindable<Metrics> bindableMetrics() { return &this->bMetrics; }
+	[[nodiscard]] QBindable<qint32> bindableInterval() { return &this->bInterval; }
+	[[nodiscard]] QBindable<qreal> bindableCpuUsage() const { return &this->bCpuUsage; }
+
+	[[nodiscard]] QBindable<QList<qreal>> bindableCpuCoreUsage() const {
+		return &this->bCpuCoreUsage;
+	}
+
+	[[nodiscard]] QBindable<qreal> bindableMemoryTotal() const { return &this->bMemoryTotal; }
+	[[nodiscard]] QBindable<qreal> bindableMemoryAvailable() const { return &this->bMemoryAvailable; }
+	[[nodiscard]] QBindable<qreal> bindableMemoryUsed() const { return &this->bMemoryUsed; }
+	[[nodiscard]] QBindable<qreal> bindableSwapTotal() const { return &this->bSwapTotal; }
+	[[nodiscard]] QBindable<qreal> bindableSwapUsed() const { return &this->bSwapUsed; }
+
+	[[nodiscard]] QBindable<qreal> bindableNetworkReceiveRate() const {
+		return &this->bNetworkReceiveRate;
+	}
+
+	[[nodiscard]] QBindable<qreal> bindableNetworkSendRate() const {
+		return &this->bNetworkSendRate;
+	}
+
+	[[nodiscard]] QBindable<qreal> bindableDiskReadRate() const { return &this->bDiskReadRate; }
+	[[nodiscard]] QBindable<qreal> bindableDiskWriteRate() const { return &this->bDiskWriteRate; }
+	[[nodiscard]] QBindable<qreal> bindableTemperature() const { return &this->bTemperature; }
+
+signals:
+	void metricsChanged();
+	void intervalChanged();
+	void cpuUsageChanged();
+	void cpuCoreUsageChanged();
+	void memoryTotalChanged();
+	void memoryAvailableChanged();
+	void memoryUsedChanged();
+	void swapTotalChanged();
+	void swapUsedChanged();
+	void networkReceiveRateChanged();
+	void networkSendRateChanged();
+	void diskReadRateChanged();
+	void diskWriteRateChanged();
+	void temperatureChanged();
+
+private slots:
+	void sample();
+
+private:
+	void updateSampling();
+	void sampleCpu();
+	void sampleMemory();
+	void sampleNetwork(qreal seconds);
+	void sampleDisk(qreal seconds);
+	void sampleThermal();
+
+	QTimer timer;
+	QElapsedTimer sinceLastSample;
+	bool samplePending = false;
+	Metrics sampledMetrics;
+
+	stats::StatFile procStat {"/proc/stat"};
+	stats::StatFile procMeminfo {"/proc/meminfo"};
+	stats::StatFile procNetDev {"/proc/net/dev"};
+	stats::StatFile procDiskstats {"/proc/diskstats"};
+	QList<stats::StatFile*> hwmonFiles;
+	QList<QByteArray> disks;
+
+	stats::CpuSample lastCpu;
+	stats::CpuSample currentCpu;
+	stats::IoCounters lastNetwork;
+	stats::IoCounters lastDisk;
+
+	// clang-format off
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, Metrics, bMetrics, &SystemStats::metricsChanged);
+	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(SystemStats, qint32, bInterval, 1000, &SystemStats::intervalChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bCpuUsage, &SystemStats::cpuUsageChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, QList<qreal>, bCpuCoreUsage, &SystemStats::cpuCoreUsageChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bMemoryTotal, &SystemStats::memoryTotalChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bMemoryAvailable, &SystemStats::memoryAvailableChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bMemoryUsed, &SystemStats::memoryUsedChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bSwapTotal, &SystemStats::swapTotalChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bSwapUsed, &SystemStats::swapUsedChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bNetworkReceiveRate, &SystemStats::networkReceiveRateChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bNetworkSendRate, &SystemStats::networkSendRateChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bDiskReadRate, &SystemStats::diskReadRateChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bDiskWriteRate, &SystemStats::diskWriteRateChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(SystemStats, qreal, bTemperature, &SystemStats::temperatureChanged);
+
+	// clang-format on
+
+	QS_BINDING_SUBSCRIBE_METHOD(SystemStats, bMetrics, updateSampling, onValueChanged);
+	QS_BINDING_SUBSCRIBE_METHOD(SystemStats, bInterval, updateSampling, onValueChanged);
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(SystemStats::Metrics);
+
+} // namespace qs::io
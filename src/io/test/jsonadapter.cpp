@@ -0,0 +1,138 @@
+#include "jsonadapter.hpp"
+#include <memory>
+
+#include <qbytearray.h>
+#include <qlogging.h>
+#include <qobject.h>
+#include <qqml.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qsignalspy.h>
+#include <qstring.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qurl.h>
+#include <qvariant.h>
+
+#include "../jsonadapter.hpp"
+
+using namespace qs::io;
+
+namespace {
+
+// A settings-like adapter with many primitive properties and nested objects.
+QByteArray largeAdapterSource() {
+	auto source = QByteArray("import QsTest\nJsonAdapter {\n");
+
+	for (auto i = 0; i != 200; i++) {
+		source += QString("property int int%1: %1\n").arg(i).toUtf8();
+		source += QString("property string string%1: \"value %1\"\n").arg(i).toUtf8();
+	}
+
+	for (auto i = 0; i != 20; i++) {
+		source += QString("property JsonObject object%1: JsonObject {\n").arg(i).toUtf8();
+
+		for (auto j = 0; j != 10; j++) {
+			source += QString("property real real%1: %1.5\n").arg(j).toUtf8();
+		}
+
+		source += "}\n";
+	}
+
+	source += "property JsonObject replaceable: null\n}\n";
+	return source;
+}
+
+std::unique_ptr<QObject> create(QQmlEngine& engine, const QByteArray& source) {
+	auto component = QQmlComponent(&engine);
+	component.setData(source, QUrl());
+	auto* object = component.create();
+	if (!object) qFatal("%s", component.errorString().toUtf8().constData());
+	return std::unique_ptr<QObject>(object);
+}
+
+} // namespace
+
+void TestJsonAdapter::initTestCase() {
+	qmlRegisterType<JsonAdapter>("QsTest", 1, 0, "JsonAdapter");
+	qmlRegisterType<JsonObject>("QsTest", 1, 0, "JsonObject");
+}
+
+void TestJsonAdapter::replacedObjectNotifies() {
+	auto engine = QQmlEngine();
+	auto adapter = create(engine, largeAdapterSource());
+	auto replacement = create(engine, "import QsTest\nJsonObject { property int value: 0 }");
+	auto spy = QSignalSpy(adapter.get(), &FileViewAdapter::adapterUpdated);
+
+	adapter->setProperty("replaceable", QVariant::fromValue(replacement.get()));
+	QCOMPARE(spy.count(), 1);
+
+	// Notifiers of the new object must be connected when it is assigned.
+	replacement->setProperty("value", 1);
+	QCOMPARE(spy.count(), 2);
+
+	adapter->setProperty("int0", 1000);
+	QCOMPARE(spy.count(), 3);
+
+	adapter->setProperty("replaceable", QVariant::fromValue(nullptr));
+}
+
+void TestJsonAdapter::compactSerialization() {
+	auto engine = QQmlEngine();
+	auto object = create(engine, "import QsTest\nJsonAdapter { property int a: 1 }");
+	auto* adapter = qobject_cast<JsonAdapter*>(object.get());
+
+	QCOMPARE(adapter->serializeAdapter(), "{\n    \"a\": 1\n}\n");
+	adapter->bindableCompact().setValue(true);
+	QCOMPARE(adapter->serializeAdapter(), "{\"a\":1}");
+}
+
+void TestJsonAdapter::compactNotSerialized() {
+	auto engine = QQmlEngine();
+	auto object = create(engine, "import QsTest\nJsonAdapter { property int a: 1 }");
+	auto* adapter = qobject_cast<JsonAdapter*>(object.get());
+	auto spy = QSignalSpy(adapter, &FileViewAdapter::adapterUpdated);
+
+	adapter->bindableCompact().setValue(true);
+	QCOMPARE(spy.count(), 0);
+	QCOMPARE(adapter->serializeAdapter(), "{\"a\":1}");
+
+	adapter->deserializeAdapter("{\"a\": 2, \"compact\": false}");
+	QCOMPARE(adapter->property("a").toInt(), 2);
+	QCOMPARE(adapter->bindableCompact().value(), true);
+	QCOMPARE(adapter->serializeAdapter(), "{\"a\":2}");
+}
+
+void TestJsonAdapter::benchmarkPropertyChanges() {
+	auto engine = QQmlEngine();
+	auto adapter = create(engine, largeAdapterSource());
+	auto value = 0;
+
+	QBENCHMARK {
+		for (auto i = 0; i != 200; i++) {
+			adapter->setProperty(QString("int%1").arg(i).toUtf8().constData(), ++value);
+		}
+	}
+}
+
+void TestJsonAdapter::benchmarkSerialize_data() { // NOLINT
+	QTest::addColumn<bool>("compact");
+	QTest::addRow("indented") << false;
+	QTest::addRow("compact") << true;
+}
+
+void TestJsonAdapter::benchmarkSerialize() {
+	QFETCH(bool, compact);
+
+	auto engine = QQmlEngine();
+	auto object = create(engine, largeAdapterSource());
+	auto* adapter = qobject_cast<JsonAdapter*>(object.get());
+	adapter->bindableCompact().setValue(compact);
+
+	QBENCHMARK {
+		auto data = adapter->serializeAdapter();
+		QVERIFY(!data.isEmpty());
+	}
+}
+
+QTEST_MAIN(TestJsonAdapter);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestJsonAdapter: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void initTestCase();
+	static void replacedObjectNotifies();
+	static void compactSerialization();
+	static void compactNotSerialized();
+	static void benchmarkPropertyChanges();
+	static void benchmarkSerialize_data(); // NOLINT
+	static void benchmarkSerialize();
+};
@@ -1,10 +1,12 @@
 #include "process.hpp"
 
 #include <qlist.h>
+#include <qprocess.h>
 #include <qsignalspy.h>
 #include <qtest.h>
 #include <qtestcase.h>
 
+#include "../datastream.hpp"
 #include "../process.hpp"
 
 void TestProcess::startAfterReload() {
@@ -44,4 +46,43 @@ void TestProcess::testExec() {
 	QVERIFY(process.isRunning());
 }
 
+// The spawn benchmarks compare the cost of restarting a command with Process
+// against a bare QProcess, and against requesting a line from a persistent worker.
+
+void TestProcess::benchmarkProcessSpawn() {
+	auto process = Process();
+	auto exitedSpy = QSignalSpy(&process, &Process::exited);
+	process.postReload();
+
+	QBENCHMARK {
+		process.exec({"true"});
+		QVERIFY(exitedSpy.wait(1000));
+	}
+}
+
+void TestProcess::benchmarkQProcessSpawn() {
+	QBENCHMARK {
+		auto process = QProcess();
+		process.start("true", {});
+		QVERIFY(process.waitForFinished(1000));
+	}
+}
+
+void TestProcess::benchmarkPersistentWorker() {
+	auto process = Process();
+	auto parser = SplitParser();
+	auto readSpy = QSignalSpy(&parser, &DataStreamParser::read);
+
+	process.setStdoutParser(&parser);
+	process.setStdinEnabled(true);
+	process.setCommand({"cat"});
+	process.setRunning(true);
+	process.postReload();
+
+	QBENCHMARK {
+		process.write("poll\n");
+		QVERIFY(readSpy.wait(1000));
+	}
+}
+
 QTEST_MAIN(TestProcess);
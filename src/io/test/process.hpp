@@ -9,4 +9,7 @@ class TestProcess: public QObject {
 private slots:
 	static void startAfterReload();
 	static void testExec();
+	static void benchmarkProcessSpawn();
+	static void benchmarkQProcessSpawn();
+	static void benchmarkPersistentWorker();
 };
@@ -0,0 +1,132 @@
+#include "systemstats.hpp"
+
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qfile.h>
+#include <qiodevice.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qobject.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../systemstats.hpp"
+
+using namespace qs::io::stats;
+
+namespace {
+
+QByteArray fixture(const char* name) {
+	auto file = QFile(QString(FIXTURE_DIR "/") + name);
+	if (!file.open(QIODevice::ReadOnly)) qFatal("Missing fixture %s", name);
+	return file.readAll();
+}
+
+} // namespace
+
+void TestSystemStats::tokenizer() {
+	auto tokenizer = StatTokenizer("cpu  10 20\tabc\n\nlast 42");
+	QByteArrayView line;
+
+	QVERIFY(tokenizer.nextLine(line));
+	QCOMPARE(StatTokenizer::nextToken(line).toByteArray(), "cpu");
+	QCOMPARE(StatTokenizer::toUInt(StatTokenizer::nextToken(line)), 10);
+	QCOMPARE(StatTokenizer::toUInt(StatTokenizer::nextToken(line)), 20);
+	QCOMPARE(StatTokenizer::nextToken(line).toByteArray(), "abc");
+	QVERIFY(StatTokenizer::nextToken(line).isEmpty());
+
+	QVERIFY(tokenizer.nextLine(line));
+	QVERIFY(line.isEmpty());
+
+	QVERIFY(tokenizer.nextLine(line));
+	QCOMPARE(StatTokenizer::nextToken(line).toByteArray(), "last");
+	QCOMPARE(StatTokenizer::toUInt(StatTokenizer::nextToken(line)), 42);
+
+	QVERIFY(!tokenizer.nextLine(line));
+}
+
+void TestSystemStats::statFileRereads() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("stat");
+
+	auto write = [&](const QByteArray& data) {
+		auto file = QFile(path);
+		QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+		file.write(data);
+	};
+
+	auto statFile = StatFile(path);
+	QVERIFY(statFile.read().isNull());
+
+	write("first");
+	QCOMPARE(statFile.read().toByteArray(), "first");
+
+	// Larger than the initial buffer, and read through the same fd.
+	auto large = QByteArray(10000, 'x');
+	write(large);
+	QCOMPARE(statFile.read().toByteArray(), large);
+
+	write("short");
+	QCOMPARE(statFile.read().toByteArray(), "short");
+}
+
+void TestSystemStats::procStat() {
+	auto first = CpuSample();
+	QVERIFY(parseProcStat(fixture("stat_1"), first));
+	QCOMPARE(first.total.total, 9800);
+	QCOMPARE(first.total.busy, 1600);
+	QCOMPARE(first.cores.size(), 2);
+
+	auto second = CpuSample();
+	QVERIFY(parseProcStat(fixture("stat_2"), second));
+	QCOMPARE(second.total.usageSince(first.total), 0.5);
+	QCOMPARE(second.cores.at(0).usageSince(first.cores.at(0)), 300.0 / 450.0);
+	QCOMPARE(second.cores.at(1).usageSince(first.cores.at(1)), 200.0 / 550.0);
+
+	// Counters that went backwards must not produce a negative or huge usage.
+	QCOMPARE(first.total.usageSince(second.total), 0);
+
+	// Parsing into an existing sample drops cores that disappeared.
+	QVERIFY(parseProcStat("cpu  1 2 3 4 5 6 7 8\ncpu0 1 2 3 4 5 6 7 8\n", second));
+	QCOMPARE(second.cores.size(), 1);
+}
+
+void TestSystemStats::meminfo() {
+	auto sample = MemorySample();
+	QVERIFY(parseMeminfo(fixture("meminfo"), sample));
+	QCOMPARE(sample.total, 16314180ull * 1024);
+	QCOMPARE(sample.free, 1234567ull * 1024);
+	QCOMPARE(sample.available, 8000000ull * 1024);
+	QCOMPARE(sample.swapTotal, 4194300ull * 1024);
+	QCOMPARE(sample.swapFree, 4000000ull * 1024);
+
+	QVERIFY(!parseMeminfo("MemTotal: 100 kB\n", sample));
+}
+
+void TestSystemStats::netDev() {
+	auto counters = IoCounters();
+	QVERIFY(parseNetDev(fixture("net_dev"), counters));
+	QCOMPARE(counters.read, 1250000);
+	QCOMPARE(counters.written, 525000);
+}
+
+void TestSystemStats::diskstats() {
+	auto disks = QList<QByteArray> {"nvme0n1", "sda"};
+	auto counters = IoCounters();
+	QVERIFY(parseDiskstats(fixture("diskstats"), disks, counters));
+	QCOMPARE(counters.read, 408000ull * 512);
+	QCOMPARE(counters.written, 604000ull * 512);
+}
+
+void TestSystemStats::hwmonTemp() {
+	qreal celsius = 0;
+	QVERIFY(parseHwmonTemp(fixture("temp_input"), celsius));
+	QCOMPARE(celsius, 45.5);
+	QVERIFY(parseHwmonTemp(fixture("temp_input_negative"), celsius));
+	QCOMPARE(celsius, -2.5);
+	QVERIFY(!parseHwmonTemp("\n", celsius));
+}
+
+QTEST_MAIN(TestSystemStats);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestSystemStats: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void tokenizer();
+	static void statFileRereads();
+	static void procStat();
+	static void meminfo();
+	static void netDev();
+	static void diskstats();
+	static void hwmonTemp();
+};
@@ -0,0 +1,134 @@
+#include "bindingstats.hpp"
+#include <variant>
+
+#include <qcontainerfwd.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qminmax.h>
+#include <qstring.h>
+#include <qtypes.h>
+
+#include "../core/bindingstats.hpp"
+#include "../core/logging.hpp"
+#include "ipc.hpp"
+#include "ipccommand.hpp"
+
+namespace qs::ipc {
+
+namespace {
+
+struct BindingStatsUnavailable: std::monostate {};
+
+struct WireBindingStatsEntry {
+	quint8 kind = 0;
+	QString location;
+	quint64 count = 0;
+	qint64 totalNs = 0;
+	qint64 maxNs = 0;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(
+    WireBindingStatsEntry,
+    data.kind,
+    data.location,
+    data.count,
+    data.totalNs,
+    data.maxNs
+);
+
+struct BindingStatsReport {
+	bool enabled = false;
+	QVector<WireBindingStatsEntry> entries;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(BindingStatsReport, data.enabled, data.entries);
+
+using BindingStatsResponse =
+    std::variant<std::monostate, BindingStatsUnavailable, BindingStatsReport>;
+
+QString formatMs(qint64 ns) {
+	return QString::number(static_cast<double>(ns) / 1000000.0, 'f', 2);
+}
+
+} // namespace
+
+void BindingStatsCommand::exec(IpcServerConnection* conn) const {
+	if (!BindingStats::isAvailable()) {
+		conn->respond(BindingStatsResponse(BindingStatsUnavailable()));
+		return;
+	}
+
+	auto* stats = BindingStats::instance();
+
+	if (this->reset) stats->reset();
+	if (this->enable) stats->setEnabled(true);
+	else if (this->disable) stats->setEnabled(false);
+
+	auto report = BindingStatsReport {.enabled = stats->isEnabled()};
+
+	for (const auto& entry: stats->topEntries(qMax(0, this->count))) {
+		report.entries.append({
+		    .kind = static_cast<quint8>(entry.kind),
+		    .location = entry.location,
+		    .count = entry.count,
+		    .totalNs = entry.totalNs,
+		    .maxNs = entry.maxNs,
+		});
+	}
+
+	conn->respond(BindingStatsResponse(report));
+}
+
+int bindingStats(IpcClient* client, bool enable, bool disable, bool reset, qint32 count) {
+	client->sendMessage(IpcCommand(BindingStatsCommand {
+	    .enable = enable,
+	    .disable = disable,
+	    .reset = reset,
+	    .count = count,
+	}));
+
+	BindingStatsResponse slot;
+	if (!client->waitForResponse(slot)) return -1;
+
+	if (std::holds_alternative<BindingStatsReport>(slot)) {
+		const auto& report = std::get<BindingStatsReport>(slot);
+
+		if (report.enabled) {
+			qCInfo(logBare) << "Binding stats are being collected.";
+		} else {
+			qCInfo(logBare) << "Binding stats are not being collected. Enable them with --enable or "
+			                   "the BindingStats pragma.";
+		}
+
+		if (report.entries.isEmpty()) return 0;
+
+		qCInfo(logBare).noquote() << QStringLiteral("\n%1 %2 %3  %4 %5")
+		                                 .arg(QStringLiteral("count"), 10)
+		                                 .arg(QStringLiteral("total ms"), 10)
+		                                 .arg(QStringLiteral("max ms"), 8)
+		                                 .arg(QStringLiteral("kind"), -7)
+		                                 .arg(QStringLiteral("location"));
+
+		for (const auto& entry: report.entries) {
+			auto kind = BindingStats::kindName(static_cast<BindingStats::Kind>(entry.kind));
+
+			qCInfo(logBare).noquote() << QStringLiteral("%1 %2 %3  %4 %5")
+			                                 .arg(entry.count, 10)
+			                                 .arg(formatMs(entry.totalNs), 10)
+			                                 .arg(formatMs(entry.maxNs), 8)
+			                                 .arg(kind, -7)
+			                                 .arg(entry.location);
+		}
+
+		return 0;
+	} else if (std::holds_alternative<BindingStatsUnavailable>(slot)) {
+		qCCritical(logBare) << "Binding stats are unavailable as the instance's Qt was built "
+		                       "without QML debugging support.";
+	} else {
+		qCCritical(logIpc) << "Received invalid IPC response from" << client;
+	}
+
+	return -1;
+}
+
+} // namespace qs::ipc
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qtypes.h>
+
+#include "ipc.hpp"
+
+namespace qs::ipc {
+
+struct BindingStatsCommand {
+	bool enable = false;
+	bool disable = false;
+	bool reset = false;
+	qint32 count = 0;
+
+	void exec(IpcServerConnection* conn) const;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(
+    BindingStatsCommand,
+    data.enable,
+    data.disable,
+    data.reset,
+    data.count
+);
+
+// Applies the given changes to the instance's binding stats, then prints the count
+// most expensive bindings and signal handlers.
+int bindingStats(IpcClient* client, bool enable, bool disable, bool reset, qint32 count);
+
+} // namespace qs::ipc
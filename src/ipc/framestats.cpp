@@ -0,0 +1,73 @@
+#include "framestats.hpp"
+#include <variant>
+
+#include <qcontainerfwd.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qstring.h>
+#include <qtypes.h>
+
+#include "../core/logging.hpp"
+#include "ipc.hpp"
+#include "ipccommand.hpp"
+
+namespace qs::ipc {
+
+namespace {
+
+using FrameStatsResponse = std::variant<std::monostate, QVector<WindowFrameSummary>>;
+
+FrameStatsProvider frameStatsProvider = nullptr; // NOLINT
+
+QString formatMs(qint64 ns) {
+	return QString::number(static_cast<double>(ns) / 1000000.0, 'f', 2);
+}
+
+} // namespace
+
+void setFrameStatsProvider(FrameStatsProvider provider) { frameStatsProvider = provider; }
+
+void FrameStatsCommand::exec(IpcServerConnection* conn) const {
+	auto windows = QVector<WindowFrameSummary>();
+	if (frameStatsProvider != nullptr) windows = frameStatsProvider(this->reset);
+
+	conn->respond(FrameStatsResponse(windows));
+}
+
+int frameStats(IpcClient* client, bool reset) {
+	client->sendMessage(IpcCommand(FrameStatsCommand {.reset = reset}));
+
+	FrameStatsResponse slot;
+	if (!client->waitForResponse(slot)) return -1;
+
+	if (!std::holds_alternative<QVector<WindowFrameSummary>>(slot)) {
+		qCCritical(logIpc) << "Received invalid IPC response from" << client;
+		return -1;
+	}
+
+	const auto& windows = std::get<QVector<WindowFrameSummary>>(slot);
+
+	if (windows.isEmpty()) {
+		qCInfo(logBare) << "The instance has no windows.";
+		return 0;
+	}
+
+	if (reset) qCInfo(logBare) << "Frame stats were reset.";
+
+	for (const auto& window: windows) {
+		qCInfo(logBare).noquote().nospace()
+		    << window.name << ":\n"
+		    << "  Frames: " << window.frameCount << " (" << window.framesPerSecond
+		    << " in the last second)\n"
+		    << "  Average over the last " << window.historyFrames << " frames: sync "
+		    << formatMs(window.avgSyncNs) << "ms, render " << formatMs(window.avgRenderNs)
+		    << "ms, swap " << formatMs(window.avgSwapNs) << "ms, " << window.avgItemsUpdated
+		    << " items updated\n"
+		    << "  Slowest frame: " << formatMs(window.maxFrameNs) << "ms\n"
+		    << "  Texture uploads: " << window.uploadBytes << " bytes\n";
+	}
+
+	return 0;
+}
+
+} // namespace qs::ipc
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qstring.h>
+#include <qtypes.h>
+
+#include "ipc.hpp"
+
+namespace qs::ipc {
+
+// Frame stats of a single window, averaged over its recorded history.
+struct WindowFrameSummary {
+	QString name;
+	quint64 frameCount = 0;
+	qint32 framesPerSecond = 0;
+	qint32 historyFrames = 0;
+	qint64 avgSyncNs = 0;
+	qint64 avgRenderNs = 0;
+	qint64 avgSwapNs = 0;
+	qint64 maxFrameNs = 0;
+	qint32 avgItemsUpdated = 0;
+	quint64 uploadBytes = 0;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(
+    WindowFrameSummary,
+    data.name,
+    data.frameCount,
+    data.framesPerSecond,
+    data.historyFrames,
+    data.avgSyncNs,
+    data.avgRenderNs,
+    data.avgSwapNs,
+    data.maxFrameNs,
+    data.avgItemsUpdated,
+    data.uploadBytes
+);
+
+// Summarizes every window, resetting their stats afterwards if requested.
+using FrameStatsProvider = QVector<WindowFrameSummary> (*)(bool reset);
+
+// Set by the window module, which depends on ipc rather than the other way around.
+void setFrameStatsProvider(FrameStatsProvider provider);
+
+struct FrameStatsCommand {
+	bool reset = false;
+
+	void exec(IpcServerConnection* conn) const;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(FrameStatsCommand, data.reset);
+
+// Prints frame stats for every window of the connected instance.
+int frameStats(IpcClient* client, bool reset);
+
+} // namespace qs::ipc
@@ -3,7 +3,11 @@
 #include <variant>
 
 #include "../io/ipccomm.hpp"
+#include "bindingstats.hpp"
+#include "framestats.hpp"
 #include "ipc.hpp"
+#include "memorystats.hpp"
+#include "profile.hpp"
 
 namespace qs::ipc {
 
@@ -17,6 +21,10 @@ using IpcCommand = std::variant<
     qs::io::ipc::comm::QueryMetadataCommand,
     qs::io::ipc::comm::StringCallCommand,
     qs::io::ipc::comm::SignalListenCommand,
-    qs::io::ipc::comm::StringPropReadCommand>;
+    qs::io::ipc::comm::StringPropReadCommand,
+    ProfileCommand,
+    BindingStatsCommand,
+    FrameStatsCommand,
+    MemoryStatsCommand>;
 
 } // namespace qs::ipc
@@ -0,0 +1,174 @@
+#include "memorystats.hpp"
+#include <variant>
+
+#include <qcontainerfwd.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qstring.h>
+#include <qtypes.h>
+
+#include "../core/logging.hpp"
+#include "../core/memorystats.hpp"
+#include "ipc.hpp"
+#include "ipccommand.hpp"
+
+namespace qs::ipc {
+
+namespace {
+
+struct WireGeneration {
+	QString id;
+	bool pendingDestruction = false;
+	qint64 jsHeapUsed = 0;
+	qint64 jsHeapAllocated = 0;
+	qint64 jsLargeItems = 0;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(
+    WireGeneration,
+    data.id,
+    data.pendingDestruction,
+    data.jsHeapUsed,
+    data.jsHeapAllocated,
+    data.jsLargeItems
+);
+
+struct WireLiveObjects {
+	QString name;
+	qint64 count = 0;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(WireLiveObjects, data.name, data.count);
+
+struct WireAllocator {
+	bool available = false;
+	qint64 allocated = 0;
+	qint64 active = 0;
+	qint64 resident = 0;
+	qint64 mapped = 0;
+	qint64 retained = 0;
+	quint32 arenas = 0;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(
+    WireAllocator,
+    data.available,
+    data.allocated,
+    data.active,
+    data.resident,
+    data.mapped,
+    data.retained,
+    data.arenas
+);
+
+struct MemoryStatsReport {
+	qint64 rss = -1;
+	QVector<WireGeneration> generations;
+	QVector<WireLiveObjects> liveObjects;
+	WireAllocator allocator;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(
+    MemoryStatsReport,
+    data.rss,
+    data.generations,
+    data.liveObjects,
+    data.allocator
+);
+
+using MemoryStatsResponse = std::variant<std::monostate, MemoryStatsReport>;
+
+QString formatMiB(qint64 bytes) {
+	return QString::number(static_cast<double>(bytes) / (1024.0 * 1024.0), 'f', 1) + " MiB";
+}
+
+} // namespace
+
+void MemoryStatsCommand::exec(IpcServerConnection* conn) const {
+	if (this->collectGarbage) MemoryStats::collectGarbage();
+
+	auto snapshot = MemoryStats::snapshot();
+	auto report = MemoryStatsReport {.rss = snapshot.rss};
+
+	for (const auto& generation: snapshot.generations) {
+		report.generations.append({
+		    .id = generation.id,
+		    .pendingDestruction = generation.pendingDestruction,
+		    .jsHeapUsed = generation.jsHeapUsed,
+		    .jsHeapAllocated = generation.jsHeapAllocated,
+		    .jsLargeItems = generation.jsLargeItems,
+		});
+	}
+
+	for (const auto& entry: snapshot.liveObjects) {
+		report.liveObjects.append({.name = entry.name, .count = entry.count});
+	}
+
+	const auto& allocator = snapshot.allocator;
+	report.allocator = {
+	    .available = allocator.available,
+	    .allocated = allocator.allocated,
+	    .active = allocator.active,
+	    .resident = allocator.resident,
+	    .mapped = allocator.mapped,
+	    .retained = allocator.retained,
+	    .arenas = allocator.arenas,
+	};
+
+	conn->respond(MemoryStatsResponse(report));
+}
+
+int memoryStats(IpcClient* client, bool collectGarbage) {
+	client->sendMessage(IpcCommand(MemoryStatsCommand {.collectGarbage = collectGarbage}));
+
+	MemoryStatsResponse slot;
+	if (!client->waitForResponse(slot)) return -1;
+
+	if (!std::holds_alternative<MemoryStatsReport>(slot)) {
+		qCCritical(logIpc) << "Received invalid IPC response from" << client;
+		return -1;
+	}
+
+	const auto& report = std::get<MemoryStatsReport>(slot);
+
+	if (report.rss == -1) qCInfo(logBare) << "Resident set size: unknown";
+	else qCInfo(logBare).noquote() << "Resident set size:" << formatMiB(report.rss);
+
+	qCInfo(logBare).noquote() << "\nGenerations:";
+
+	for (const auto& generation: report.generations) {
+		auto state = generation.pendingDestruction ? QStringLiteral("pending destruction")
+		                                           : QStringLiteral("live");
+
+		qCInfo(logBare).noquote() << QStringLiteral("  %1 (%2): js heap %3 used, %4 alloc, %5 large")
+		                                 .arg(generation.id, state)
+		                                 .arg(formatMiB(generation.jsHeapUsed))
+		                                 .arg(formatMiB(generation.jsHeapAllocated))
+		                                 .arg(formatMiB(generation.jsLargeItems));
+	}
+
+	qCInfo(logBare).noquote() << "\nLive objects:";
+
+	for (const auto& entry: report.liveObjects) {
+		qCInfo(logBare).noquote() << QStringLiteral("  %1 %2").arg(entry.name, -20).arg(entry.count);
+	}
+
+	const auto& allocator = report.allocator;
+
+	if (allocator.available) {
+		qCInfo(logBare).noquote() << "\njemalloc:";
+		qCInfo(logBare).noquote() << "  allocated" << formatMiB(allocator.allocated);
+		qCInfo(logBare).noquote() << "  active   " << formatMiB(allocator.active);
+		qCInfo(logBare).noquote() << "  resident " << formatMiB(allocator.resident);
+		qCInfo(logBare).noquote() << "  mapped   " << formatMiB(allocator.mapped);
+		qCInfo(logBare).noquote() << "  retained " << formatMiB(allocator.retained);
+		qCInfo(logBare).noquote() << "  arenas   " << allocator.arenas;
+	} else {
+		qCInfo(logBare) << "\nAllocator stats are unavailable as the instance was not built with "
+		                   "jemalloc.";
+	}
+
+	return 0;
+}
+
+} // namespace qs::ipc
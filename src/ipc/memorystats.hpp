@@ -0,0 +1,20 @@
+#pragma once
+
+#include <qtypes.h>
+
+#include "ipc.hpp"
+
+namespace qs::ipc {
+
+struct MemoryStatsCommand {
+	bool collectGarbage = false;
+
+	void exec(IpcServerConnection* conn) const;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(MemoryStatsCommand, data.collectGarbage);
+
+// Prints where the instance's memory is held, optionally running the garbage collector first.
+int memoryStats(IpcClient* client, bool collectGarbage);
+
+} // namespace qs::ipc
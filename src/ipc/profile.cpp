@@ -0,0 +1,162 @@
+#include "profile.hpp"
+#include <algorithm>
+#include <variant>
+
+#include <qbytearray.h>
+#include <qfile.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qobject.h>
+#include <qtextstream.h>
+#include <qtypes.h>
+
+#include "../core/logging.hpp"
+#include "build.hpp"
+#include "ipc.hpp"
+#include "ipccommand.hpp"
+
+#if CRASH_HANDLER
+#include "../crash/profiler.hpp"
+#endif
+
+namespace qs::ipc {
+
+namespace {
+
+constexpr qint32 MAX_DURATION = 300;
+constexpr qint32 MAX_FREQUENCY = 1000;
+
+struct ProfilerUnavailable: std::monostate {};
+struct ProfilerBusy: std::monostate {};
+
+struct ProfileSamples {
+	QByteArray data;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(ProfileSamples, data.data);
+
+using ProfileResponse =
+    std::variant<std::monostate, ProfilerUnavailable, ProfilerBusy, ProfileSamples>;
+
+} // namespace
+
+void ProfileCommand::exec(IpcServerConnection* conn) const {
+#if CRASH_HANDLER
+	auto* profiler = qs::crash::Profiler::instance();
+
+	if (profiler->isRunning()) {
+		conn->respond(ProfileResponse(ProfilerBusy()));
+		return;
+	}
+
+	auto duration = std::clamp(this->durationSecs, 1, MAX_DURATION);
+	auto frequency = std::clamp(this->frequency, 1, MAX_FREQUENCY);
+
+	if (!profiler->start(frequency, duration)) {
+		conn->respond(ProfileResponse(ProfilerUnavailable()));
+		return;
+	}
+
+	new ProfileSession(conn, duration);
+#else
+	conn->respond(ProfileResponse(ProfilerUnavailable()));
+#endif
+}
+
+ProfileSession::ProfileSession(IpcServerConnection* conn, qint32 durationSecs): conn(conn) {
+	conn->setParent(this);
+
+	QObject::connect(conn, &QObject::destroyed, this, &ProfileSession::onConnDestroyed);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &ProfileSession::onFinished);
+
+	this->timer.setSingleShot(true);
+	this->timer.start(durationSecs * 1000);
+
+	qCDebug(logIpc) << "Profiling for" << durationSecs << "seconds for" << conn;
+}
+
+ProfileSession::~ProfileSession() { qCDebug(logIpc) << "Destroying profile session" << this; }
+
+void ProfileSession::onFinished() {
+#if CRASH_HANDLER
+	auto samples = qs::crash::Profiler::instance()->takeSamples();
+	this->conn->respond(ProfileResponse(ProfileSamples {.data = samples}));
+#endif
+	// The session is destroyed once the client disconnects, as destroying the connection
+	// here could drop samples that have not been written to the socket yet.
+}
+
+void ProfileSession::onConnDestroyed() {
+#if CRASH_HANDLER
+	// The client went away before profiling finished.
+	if (this->timer.isActive()) qs::crash::Profiler::instance()->takeSamples();
+#endif
+	this->deleteLater();
+}
+
+int profileInstance(
+    [[maybe_unused]] IpcClient* client,
+    [[maybe_unused]] qint32 durationSecs,
+    [[maybe_unused]] qint32 frequency,
+    [[maybe_unused]] const QString& output
+) {
+#if CRASH_HANDLER
+	auto file = QFile(output);
+	auto stream = QTextStream(stdout);
+
+	if (!output.isEmpty()) {
+		if (!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text)) {
+			qCCritical(logBare) << "Failed to open" << output << "for writing.";
+			return -1;
+		}
+
+		stream.setDevice(&file);
+		qCInfo(logBare) << "Profiling for" << durationSecs << "seconds...";
+	}
+
+	client->sendMessage(
+	    IpcCommand(ProfileCommand {.durationSecs = durationSecs, .frequency = frequency})
+	);
+
+	ProfileResponse slot;
+	if (!client->waitForResponse(slot)) return -1;
+
+	if (std::holds_alternative<ProfileSamples>(slot)) {
+		qint32 sampleCount = 0;
+		quint64 droppedCount = 0;
+
+		const auto& samples = std::get<ProfileSamples>(slot);
+		if (!qs::crash::writeFoldedStacks(samples.data, stream, &sampleCount, &droppedCount)) {
+			qCCritical(logBare) << "Failed to read profile samples from the instance.";
+			return -1;
+		}
+
+		stream.flush();
+
+		// stdout is reserved for the folded stacks when not writing to a file.
+		if (!output.isEmpty()) {
+			qCInfo(logBare).noquote() << "Wrote" << sampleCount << "samples to" << output;
+
+			if (droppedCount != 0) {
+				qCWarning(logBare) << droppedCount
+				                   << "samples were dropped after the sample buffer filled up.";
+			}
+		}
+
+		return 0;
+	} else if (std::holds_alternative<ProfilerBusy>(slot)) {
+		qCCritical(logBare) << "The instance is already being profiled.";
+	} else if (std::holds_alternative<ProfilerUnavailable>(slot)) {
+		qCCritical(logBare) << "The instance was unable to start profiling.";
+	} else {
+		qCCritical(logIpc) << "Received invalid IPC response from" << client;
+	}
+
+	return -1;
+#else
+	qCCritical(logBare) << "Profiling requires quickshell to be built with the crash handler.";
+	return -1;
+#endif
+}
+
+} // namespace qs::ipc
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <qobject.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+#include "ipc.hpp"
+
+namespace qs::ipc {
+
+struct ProfileCommand {
+	qint32 durationSecs = 0;
+	qint32 frequency = 0;
+
+	void exec(IpcServerConnection* conn) const;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(ProfileCommand, data.durationSecs, data.frequency);
+
+// Profiles the connected instance and writes its folded stacks to the given file,
+// or stdout if empty.
+int profileInstance(
+    IpcClient* client,
+    qint32 durationSecs,
+    qint32 frequency,
+    const QString& output
+);
+
+// Keeps a profiling connection open until sampling finishes.
+class ProfileSession: public QObject {
+	Q_OBJECT;
+
+public:
+	explicit ProfileSession(IpcServerConnection* conn, qint32 durationSecs);
+	~ProfileSession() override;
+	Q_DISABLE_COPY_MOVE(ProfileSession);
+
+private slots:
+	void onFinished();
+	void onConnDestroyed();
+
+private:
+	IpcServerConnection* conn;
+	QTimer timer;
+};
+
+} // namespace qs::ipc
@@ -29,7 +29,11 @@
 #include "../core/logging.hpp"
 #include "../core/paths.hpp"
 #include "../io/ipccomm.hpp"
+#include "../ipc/bindingstats.hpp"
+#include "../ipc/framestats.hpp"
 #include "../ipc/ipc.hpp"
+#include "../ipc/memorystats.hpp"
+#include "../ipc/profile.hpp"
 #include "launch_p.hpp"
 
 namespace qs::launch {
@@ -440,6 +444,18 @@ int ipcCommand(CommandState& cmd) {
 			return qs::io::ipc::comm::listenToSignal(&client, *cmd.ipc.target, *cmd.ipc.name, true);
 		} else if (*cmd.ipc.listen) {
 			return qs::io::ipc::comm::listenToSignal(&client, *cmd.ipc.target, *cmd.ipc.name, false);
+		} else if (*cmd.ipc.frames) {
+			return qs::ipc::frameStats(&client, cmd.ipc.resetFrames);
+		} else if (*cmd.ipc.memory) {
+			return qs::ipc::memoryStats(&client, cmd.ipc.collectGarbage);
+		} else if (*cmd.ipc.bindings) {
+			return qs::ipc::bindingStats(
+			    &client,
+			    cmd.bindingStats.enable,
+			    cmd.bindingStats.disable,
+			    cmd.bindingStats.reset,
+			    cmd.bindingStats.count
+			);
 		} else {
 			QVector<QString> arguments;
 			for (auto& arg: cmd.ipc.arguments) {
@@ -453,6 +469,21 @@ int ipcCommand(CommandState& cmd) {
 	});
 }
 
+int profileInstance(CommandState& cmd) {
+	InstanceLockInfo instance;
+	auto r = selectInstance(cmd, &instance);
+	if (r != 0) return r;
+
+	return IpcClient::connect(instance.instance.instanceId, [&](IpcClient& client) {
+		return qs::ipc::profileInstance(
+		    &client,
+		    cmd.profile.duration,
+		    cmd.profile.frequency,
+		    *cmd.profile.output
+		);
+	});
+}
+
 int launchFromCommand(CommandState& cmd, QCoreApplication* coreApplication) {
 	QString configPath;
 
@@ -472,6 +503,7 @@ int launchFromCommand(CommandState& cmd, QCoreApplication* coreApplication) {
 	        .configPath = configPath,
 	        .debugPort = cmd.debug.port,
 	        .waitForDebug = cmd.debug.wait,
+	        .traceStartup = cmd.debug.traceStartup,
 	    },
 	    cmd.exec.argv,
 	    coreApplication
@@ -557,6 +589,8 @@ int runCommand(int argc, char** argv, QCoreApplication* coreApplication) {
 		return killInstances(state);
 	} else if (*state.subcommand.msg || *state.ipc.ipc) {
 		return ipcCommand(state);
+	} else if (*state.subcommand.profile) {
+		return profileInstance(state);
 	} else {
 		if (strcmp(qVersion(), QT_VERSION_STR) != 0) {
 			qWarning() << "\033[31mQuickshell was built against Qt" << QT_VERSION_STR
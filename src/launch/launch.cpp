@@ -17,12 +17,16 @@
 #include <qtextstream.h>
 #include <unistd.h>
 
+#include "../core/bindingstats.hpp"
 #include "../core/common.hpp"
+#include "../core/iconimageprovider.hpp"
 #include "../core/instanceinfo.hpp"
 #include "../core/logging.hpp"
 #include "../core/paths.hpp"
 #include "../core/plugin.hpp"
+#include "../core/recovery.hpp"
 #include "../core/rootwrapper.hpp"
+#include "../core/startuptrace.hpp"
 #include "../ipc/ipc.hpp"
 #include "build.hpp"
 #include "launch_p.hpp"
@@ -58,6 +62,8 @@ QString base36Encode(T number) {
 } // namespace
 
 int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplication) {
+	if (args.traceStartup) StartupTrace::enable();
+
 	auto pathId = QCryptographicHash::hash(args.configPath.toUtf8(), QCryptographicHash::Md5).toHex();
 	auto shellId = QString(pathId);
 
@@ -79,11 +85,14 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 		QHash<QString, QString> defaultEnv;
 		QString appId = qEnvironmentVariable("QS_APP_ID");
 		bool dropExpensiveFonts = false;
+		bool iconDiskCache = qEnvironmentVariableIntValue("QS_ICON_DISK_CACHE") == 1;
+		bool bindingStats = qEnvironmentVariableIntValue("QS_BINDING_STATS") == 1;
 		QString dataDir;
 		QString stateDir;
 		QString cacheDir;
 	} pragmas;
 
+	auto pragmaSpan = StartupSpan("launch", QStringLiteral("read pragmas"));
 	auto stream = QTextStream(&file);
 	while (!stream.atEnd()) {
 		auto line = stream.readLine().trimmed();
@@ -112,6 +121,8 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 			else if (pragma == "IgnoreSystemSettings") pragmas.desktopSettingsAware = false;
 			else if (pragma == "RespectSystemStyle") pragmas.useSystemStyle = true;
 			else if (pragma == "DropExpensiveFonts") pragmas.dropExpensiveFonts = true;
+			else if (pragma == "IconDiskCache") pragmas.iconDiskCache = true;
+			else if (pragma == "BindingStats") pragmas.bindingStats = true;
 			else if (pragma.startsWith("IconTheme ")) pragmas.iconTheme = pragma.sliced(10);
 			else if (pragma.startsWith("AppId ")) {
 				pragmas.appId = pragma.sliced(6).trimmed();
@@ -130,6 +141,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	}
 
 	file.close();
+	pragmaSpan.end();
 
 	if (!pragmas.iconTheme.isEmpty()) {
 		QIcon::setThemeName(pragmas.iconTheme);
@@ -154,6 +166,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	if (qEnvironmentVariableIsSet("QS_DISABLE_CRASH_HANDLER")) {
 		qInfo() << "Crash handling disabled.";
 	} else {
+		auto span = StartupSpan("launch", QStringLiteral("init crash handler"));
 		crash::CrashHandler::init();
 
 		auto* log = LogManager::instance();
@@ -173,6 +186,21 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	QsPaths::instance()->linkPathDir();
 	LogManager::initFs();
 
+	if (!args.recoverInstanceId.isEmpty()) {
+		auto span = StartupSpan("launch", QStringLiteral("load recovery snapshot"));
+		RecoverySnapshot::instance()->restore(args.recoverInstanceId);
+	}
+
+#if CRASH_HANDLER
+	// Snapshots are only useful if the crash handler can relaunch the shell.
+	if (!qEnvironmentVariableIsSet("QS_DISABLE_CRASH_HANDLER")) {
+		RecoverySnapshot::instance()->start();
+	}
+#endif
+
+	IconImageProvider::setDiskCacheEnabled(pragmas.iconDiskCache);
+	BindingStats::setEnabledOnLaunch(pragmas.bindingStats);
+
 	Common::INITIAL_ENVIRONMENT = QProcessEnvironment::systemEnvironment();
 
 	if (!pragmas.useSystemStyle) {
@@ -191,6 +219,8 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	pragmas.dropExpensiveFonts |= qEnvironmentVariableIntValue("QS_DROP_EXPENSIVE_FONTS") == 1;
 
 	if (pragmas.dropExpensiveFonts) {
+		auto span = StartupSpan("launch", QStringLiteral("write fontconfig filter"));
+
 		if (auto* runDir = QsPaths::instance()->instanceRunDir()) {
 			auto baseConfigPath = qEnvironmentVariable("FONTCONFIG_FILE");
 			if (baseConfigPath.isEmpty()) baseConfigPath = "/etc/fonts/fonts.conf";
@@ -254,6 +284,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	// Some programs place icons in the pixmaps folder instead of the icons folder.
 	// This seems to be controlled by the QPA and qt6ct does not provide it.
 	{
+		auto span = StartupSpan("launch", QStringLiteral("icon fallback paths"));
 		QList<QString> dataPaths;
 
 		if (qEnvironmentVariableIsSet("XDG_DATA_DIRS")) {
@@ -284,12 +315,16 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	QGuiApplication* app = nullptr;
 	auto qArgC = 0;
 
+	auto appSpan = StartupSpan("launch", QStringLiteral("create application"));
+
 	if (pragmas.useQApplication) {
 		app = new QApplication(qArgC, argv);
 	} else {
 		app = new QGuiApplication(qArgC, argv);
 	}
 
+	appSpan.end();
+
 	QGuiApplication::setDesktopFileName(appId);
 
 	if (args.debugPort != -1) {
@@ -299,7 +334,10 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 		QQmlDebuggingEnabler::startTcpDebugServer(args.debugPort, wait);
 	}
 
-	QsEnginePlugin::initPlugins();
+	{
+		auto span = StartupSpan("launch", QStringLiteral("init plugins"));
+		QsEnginePlugin::initPlugins();
+	}
 
 	// Base window transparency appears to be additive.
 	// Use a fully transparent window with a colored rect.
@@ -309,14 +347,18 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 		QQuickWindow::setTextRenderType(QQuickWindow::NativeTextRendering);
 	}
 
-	qs::ipc::IpcServer::start();
-	QsPaths::instance()->createLock();
+	{
+		auto span = StartupSpan("launch", QStringLiteral("start ipc server"));
+		qs::ipc::IpcServer::start();
+		QsPaths::instance()->createLock();
+	}
 
 	auto root = RootWrapper(args.configPath, shellId);
 	QGuiApplication::setQuitOnLastWindowClosed(false);
 
 	exitDaemon(0);
 
+	StartupTrace::scheduleWrite();
 	auto code = QGuiApplication::exec();
 	delete app;
 	return code;
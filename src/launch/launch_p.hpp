@@ -6,6 +6,7 @@
 #include <CLI/App.hpp>
 #include <qcoreapplication.h>
 #include <qstring.h>
+#include <qtypes.h>
 
 namespace qs::launch {
 
@@ -56,6 +57,7 @@ struct CommandState {
 	struct {
 		int port = -1;
 		bool wait = false;
+		bool traceStartup = false;
 	} debug;
 
 	struct {
@@ -76,17 +78,36 @@ struct CommandState {
 		CLI::App* getprop = nullptr;
 		CLI::App* wait = nullptr;
 		CLI::App* listen = nullptr;
+		CLI::App* bindings = nullptr;
+		CLI::App* frames = nullptr;
+		bool resetFrames = false;
+		CLI::App* memory = nullptr;
+		bool collectGarbage = false;
 		bool showOld = false;
 		QStringOption target;
 		QStringOption name;
 		std::vector<QStringOption> arguments;
 	} ipc;
 
+	struct {
+		bool enable = false;
+		bool disable = false;
+		bool reset = false;
+		qint32 count = 20;
+	} bindingStats;
+
+	struct {
+		qint32 duration = 10;
+		qint32 frequency = 99;
+		QStringOption output;
+	} profile;
+
 	struct {
 		CLI::App* log = nullptr;
 		CLI::App* list = nullptr;
 		CLI::App* kill = nullptr;
 		CLI::App* msg = nullptr;
+		CLI::App* profile = nullptr;
 	} subcommand;
 
 	struct {
@@ -102,6 +123,9 @@ struct LaunchArgs {
 	QString configPath;
 	int debugPort = -1;
 	bool waitForDebug = false;
+	bool traceStartup = false;
+	// Instance to restore a recovery snapshot from, set when relaunching after a crash.
+	QString recoverInstanceId;
 };
 
 void exitDaemon(int code);
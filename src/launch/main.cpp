@@ -64,7 +64,11 @@ void checkCrashRelaunch(char** argv, QCoreApplication* coreApplication) {
 		} else {
 			qCritical() << "Quickshell has been restarted.";
 
-			launch({.configPath = info.instance.configPath}, argv, coreApplication);
+			launch(
+			    {.configPath = info.instance.configPath, .recoverInstanceId = info.instance.instanceId},
+			    argv,
+			    coreApplication
+			);
 		}
 	}
 #endif
@@ -77,6 +77,13 @@ int parseCommand(int argc, char** argv, CommandState& state) {
 		    ->description("Wait for a QML debugger to connect before executing the configuration.")
 		    ->needs(debug);
 
+		group->add_flag("--trace-startup", state.debug.traceStartup)
+		    ->description(
+		        "Record the time spent in each phase of startup until shortly after the first "
+		        "frame, and write it to startup-trace.json in the instance runtime directory.\n"
+		        "The trace uses the Chrome trace event format, and can be opened in Perfetto."
+		    );
+
 		return group;
 	};
 
@@ -248,6 +255,73 @@ int parseCommand(int argc, char** argv, CommandState& state) {
 				get->add_option("property", state.ipc.name)->description("The property to read.");
 			}
 		}
+
+		{
+			auto* bindings = sub->add_subcommand(
+			    "bindings",
+			    "Print how often bindings and signal handlers were evaluated, and the time spent in them."
+			);
+
+			state.ipc.bindings = bindings;
+
+			auto* enable = bindings->add_flag("--enable", state.bindingStats.enable)
+			                   ->description("Start collecting binding stats.");
+
+			bindings->add_flag("--disable", state.bindingStats.disable)
+			    ->description("Stop collecting binding stats.")
+			    ->excludes(enable);
+
+			bindings->add_flag("--reset", state.bindingStats.reset)
+			    ->description("Clear collected binding stats.");
+
+			bindings->add_option("-n,--count", state.bindingStats.count)
+			    ->description("Number of entries to print, ordered by total time.")
+			    ->check(CLI::NonNegativeNumber);
+		}
+
+		{
+			auto* frames = sub->add_subcommand("frames", "Print frame timings for each window.");
+			state.ipc.frames = frames;
+
+			frames->add_flag("--reset", state.ipc.resetFrames)
+			    ->description("Clear collected frame stats after printing them.");
+		}
+
+		{
+			auto* memory = sub->add_subcommand(
+			    "memory",
+			    "Print JS heap sizes, live object counts and allocator stats."
+			);
+
+			state.ipc.memory = memory;
+
+			memory->add_flag("--gc", state.ipc.collectGarbage)
+			    ->description("Run the garbage collector before collecting stats.");
+		}
+	}
+
+	{
+		auto* sub = cli->add_subcommand("profile", "Profile a running quickshell instance.");
+
+		sub->add_option("-d,--duration", state.profile.duration)
+		    ->description("Number of seconds to profile for.")
+		    ->check(CLI::Range(1, 300));
+
+		sub->add_option("-F,--frequency", state.profile.frequency)
+		    ->description("Number of samples to take per second of cpu time.")
+		    ->check(CLI::Range(1, 1000));
+
+		sub->add_option("-o,--output", state.profile.output)
+		    ->description(
+		        "File to write folded stacks to, for use with flamegraph tools.\n"
+		        "If unspecified, folded stacks are written to stdout."
+		    );
+
+		auto* instance = addInstanceSelection(sub);
+		addConfigSelection(sub, true)->excludes(instance);
+		addLoggingOptions(sub, false, true);
+
+		state.subcommand.profile = sub;
 	}
 
 	{
@@ -0,0 +1,97 @@
+#include "apindex.hpp"
+#include <algorithm>
+
+#include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qset.h>
+#include <qstring.h>
+
+namespace qs::network {
+
+void NMAccessPointIndex::update(const NMAccessPointEntry& entry) {
+	auto existing = this->entries.find(entry.path);
+
+	if (existing == this->entries.end()) {
+		this->entries.insert(entry.path, entry);
+	} else if (*existing == entry) {
+		return;
+	} else {
+		*existing = entry;
+	}
+
+	this->dirtyPaths.insert(entry.path);
+}
+
+void NMAccessPointIndex::remove(const QString& path) {
+	if (this->entries.remove(path)) this->dirtyPaths.insert(path);
+}
+
+const NMAccessPointEntry* NMAccessPointIndex::entry(const QString& path) const {
+	auto it = this->entries.constFind(path);
+	return it == this->entries.constEnd() ? nullptr : &*it;
+}
+
+QList<NMAccessPointGroupChange> NMAccessPointIndex::commit() {
+	auto dirtyGroups = QSet<QString>();
+
+	for (const auto& path: this->dirtyPaths) {
+		auto oldGroup = this->committedGroup.value(path);
+		const auto* entry = this->entry(path);
+
+		auto newGroup = QString();
+		if (entry != nullptr && entry->infrastructure) newGroup = entry->ssid;
+
+		if (oldGroup != newGroup) {
+			if (!oldGroup.isEmpty()) {
+				auto group = this->groups.find(oldGroup);
+				group->removeOne(path);
+				dirtyGroups.insert(oldGroup);
+			}
+
+			if (newGroup.isEmpty()) {
+				this->committedGroup.remove(path);
+			} else {
+				this->groups[newGroup].append(path);
+				this->committedGroup.insert(path, newGroup);
+				dirtyGroups.insert(newGroup);
+			}
+		} else if (!newGroup.isEmpty()) {
+			// strength may have changed
+			dirtyGroups.insert(newGroup);
+		}
+	}
+
+	this->dirtyPaths.clear();
+
+	auto changes = QList<NMAccessPointGroupChange>();
+
+	for (const auto& ssid: dirtyGroups) {
+		auto group = this->groups.find(ssid);
+		auto previous = *group;
+		this->sortGroup(*group);
+
+		if (*group == previous && !group->isEmpty()) {
+			// Membership changes always alter the list, so this only
+			// skips groups where strengths moved without reordering.
+			continue;
+		}
+
+		changes.append({.ssid = ssid, .accessPoints = *group});
+		if (group->isEmpty()) this->groups.erase(group);
+	}
+
+	return changes;
+}
+
+void NMAccessPointIndex::sortGroup(QList<QString>& group) const {
+	std::ranges::sort(group, [this](const QString& a, const QString& b) {
+		auto strengthA = this->entries.value(a).strength;
+		auto strengthB = this->entries.value(b).strength;
+
+		// path order keeps equal strength APs stable between commits
+		return strengthA != strengthB ? strengthA > strengthB : a < b;
+	});
+}
+
+} // namespace qs::network
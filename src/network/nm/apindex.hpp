@@ -0,0 +1,57 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qset.h>
+#include <qstring.h>
+#include <qtypes.h>
+
+namespace qs::network {
+
+// The subset of access point state relevant to grouping APs into networks.
+struct NMAccessPointEntry {
+	QString path;
+	QString ssid;
+	quint8 strength = 0;
+	// only infrastructure APs are grouped into networks
+	bool infrastructure = true;
+
+	bool operator==(const NMAccessPointEntry& other) const = default;
+};
+
+// A network whose set or ordering of access points changed during a commit.
+struct NMAccessPointGroupChange {
+	QString ssid;
+	// strongest first, empty if the network no longer has any access points
+	QList<QString> accessPoints;
+};
+
+// Groups access points into networks by SSID, keeping each group ordered by signal strength.
+//
+// Updates are only recorded until commit() is called, which regroups everything touched
+// since the last commit in one pass. A scan completing touches most APs at once, and
+// this keeps it down to a single regroup and a single update per affected network.
+class NMAccessPointIndex {
+public:
+	void update(const NMAccessPointEntry& entry);
+	void remove(const QString& path);
+
+	[[nodiscard]] bool hasPendingChanges() const { return !this->dirtyPaths.isEmpty(); }
+	QList<NMAccessPointGroupChange> commit();
+
+	[[nodiscard]] QList<QString> group(const QString& ssid) const { return this->groups.value(ssid); }
+	[[nodiscard]] QList<QString> ssids() const { return this->groups.keys(); }
+	[[nodiscard]] const NMAccessPointEntry* entry(const QString& path) const;
+
+private:
+	void sortGroup(QList<QString>& group) const;
+
+	QHash<QString, NMAccessPointEntry> entries;
+	// path -> ssid of the group the path is committed to
+	QHash<QString, QString> committedGroup;
+	QHash<QString, QList<QString>> groups;
+	QSet<QString> dirtyPaths;
+};
+
+} // namespace qs::network
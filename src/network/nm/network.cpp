@@ -203,6 +203,9 @@ NMWirelessNetwork::NMWirelessNetwork(const QString& ssid, NetworkDevice* device,
 	QObject::connect(this, &NMWirelessNetwork::referenceApChanged, this, updateSecurity);
 	QObject::connect(this, &NMWirelessNetwork::settingsRemoved, this, checkDisappeared);
 	QObject::connect(this, &NMWirelessNetwork::apRemoved, this, checkDisappeared);
+	// clang-format off
+	QObject::connect(this, &NMWirelessNetwork::activeApPathChanged, this, &NMWirelessNetwork::updateReferenceAp);
+	// clang-format on
 
 	// Register and bind the frontend WifiNetwork.
 	this->mFrontend = new WifiNetwork(ssid, device, this);
@@ -217,39 +220,45 @@ void NMWirelessNetwork::updateReferenceAp() {
 		return;
 	}
 
-	// Otherwise, choose the AP with the strongest signal.
-	NMAccessPoint* selectedAp = nullptr;
-	for (auto* ap: this->mAccessPoints.values()) {
-		// Always prefer the active AP.
+	// Always prefer the active AP, otherwise choose the strongest, which is kept first.
+	auto* selectedAp = this->mAccessPoints.first();
+	for (auto* ap: this->mAccessPoints) {
 		if (ap->path() == this->bActiveApPath) {
 			selectedAp = ap;
 			break;
 		}
-		if (!selectedAp || ap->signalStrength() > selectedAp->signalStrength()) {
-			selectedAp = ap;
-		}
 	}
+
 	if (this->bReferenceAp != selectedAp) {
 		this->bReferenceAp = selectedAp;
 		this->bSignalStrength.setBinding([selectedAp]() { return selectedAp->signalStrength(); });
 	}
 }
 
-void NMWirelessNetwork::addAccessPoint(NMAccessPoint* ap) {
-	if (this->mAccessPoints.contains(ap->path())) return;
-	this->mAccessPoints.insert(ap->path(), ap);
-	auto onDestroyed = [this, ap]() {
-		if (this->mAccessPoints.take(ap->path())) {
-			emit this->apRemoved(ap);
-			this->updateReferenceAp();
-		}
-	};
-	// clang-format off
-	QObject::connect(ap, &NMAccessPoint::signalStrengthChanged, this, &NMWirelessNetwork::updateReferenceAp);
-	QObject::connect(ap, &NMAccessPoint::destroyed, this, onDestroyed);
-	// clang-format on
+void NMWirelessNetwork::setAccessPoints(const QList<NMAccessPoint*>& accessPoints) {
+	auto previous = std::exchange(this->mAccessPoints, accessPoints);
+
+	for (auto* ap: accessPoints) {
+		if (previous.contains(ap)) continue;
+
+		// APs are normally removed from the network before being destroyed,
+		// this only covers teardown of the owning device.
+		QObject::connect(ap, &NMAccessPoint::destroyed, this, [this, ap]() {
+			if (this->mAccessPoints.removeOne(ap)) {
+				emit this->apRemoved(ap);
+				this->updateReferenceAp();
+			}
+		});
+	}
+
 	this->updateReferenceAp();
-};
+
+	for (auto* ap: previous) {
+		if (accessPoints.contains(ap)) continue;
+		QObject::disconnect(ap, nullptr, this, nullptr);
+		emit this->apRemoved(ap);
+	}
+}
 
 void NMWirelessNetwork::bindFrontend() {
 	auto* frontend = this->mFrontend;
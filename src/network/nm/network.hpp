@@ -98,14 +98,15 @@ class NMWirelessNetwork: public NMNetwork {
 public:
 	explicit NMWirelessNetwork(const QString& ssid, NetworkDevice* device, QObject* parent = nullptr);
 
-	void addAccessPoint(NMAccessPoint* ap);
+	// Replaces the network's access points. Expects them ordered strongest first.
+	void setAccessPoints(const QList<NMAccessPoint*>& accessPoints);
 
 	// clang-format off
 	[[nodiscard]] QString ssid() const { return this->mSsid; }
 	[[nodiscard]] quint8 signalStrength() const { return this->bSignalStrength; }
 	[[nodiscard]] WifiSecurityType::Enum security() const { return this->bSecurity; }
 	[[nodiscard]] NMAccessPoint* referenceAp() const { return this->bReferenceAp; }
-	[[nodiscard]] QList<NMAccessPoint*> accessPoints() const { return this->mAccessPoints.values(); }
+	[[nodiscard]] QList<NMAccessPoint*> accessPoints() const { return this->mAccessPoints; }
 	QBindable<QString> bindableActiveApPath() { return &this->bActiveApPath; }
 	[[nodiscard]] WifiNetwork* frontend() override { return this->mFrontend; };
 	// clang-format on
@@ -125,7 +126,7 @@ private:
 
 	WifiNetwork* mFrontend;
 	QString mSsid;
-	QHash<QString, NMAccessPoint*> mAccessPoints;
+	QList<NMAccessPoint*> mAccessPoints;
 
 	// clang-format off
 	Q_OBJECT_BINDABLE_PROPERTY(NMWirelessNetwork, WifiSecurityType::Enum, bSecurity, &NMWirelessNetwork::securityChanged);
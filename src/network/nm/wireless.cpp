@@ -11,6 +11,7 @@
 #include <qloggingcategory.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qobjectdefs.h>
 #include <qstring.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
@@ -22,6 +23,7 @@
 #include "../wifi.hpp"
 #include "accesspoint.hpp"
 #include "active_connection.hpp"
+#include "apindex.hpp"
 #include "dbus_nm_wireless.h"
 #include "dbus_types.hpp"
 #include "device.hpp"
@@ -97,19 +99,64 @@ void NMWirelessDevice::onAccessPointRemoved(const QDBusObjectPath& path) {
 		return;
 	}
 	qCDebug(logNetworkManager) << "Access point removed:" << path.path();
-	delete ap;
+
+	QObject::disconnect(ap, nullptr, this, nullptr);
+	this->mApIndex.remove(path.path());
+	this->mRemovedAccessPoints.append(ap);
+	this->queueAccessPointCommit();
 }
 
 void NMWirelessDevice::onAccessPointLoaded(NMAccessPoint* ap) {
-	const QString ssid = ap->ssid();
-	if (!ssid.isEmpty()) {
-		auto mode = ap->mode();
-		if (mode == NM80211Mode::Infra) {
-			auto* net = this->mNetworks.value(ssid);
-			if (!net) net = this->registerNetwork(ssid);
-			net->addAccessPoint(ap);
+	auto update = [this, ap]() { this->indexAccessPoint(ap); };
+
+	// clang-format off
+	QObject::connect(ap, &NMAccessPoint::ssidChanged, this, update);
+	QObject::connect(ap, &NMAccessPoint::signalStrengthChanged, this, update);
+	QObject::connect(ap, &NMAccessPoint::modeChanged, this, update);
+	// clang-format on
+
+	this->indexAccessPoint(ap);
+}
+
+void NMWirelessDevice::indexAccessPoint(NMAccessPoint* ap) {
+	this->mApIndex.update({
+	    .path = ap->path(),
+	    .ssid = QString::fromUtf8(ap->ssid()),
+	    .strength = ap->signalStrength(),
+	    .infrastructure = ap->mode() == NM80211Mode::Infra,
+	});
+
+	if (this->mApIndex.hasPendingChanges()) this->queueAccessPointCommit();
+}
+
+void NMWirelessDevice::queueAccessPointCommit() {
+	if (this->mApCommitQueued) return;
+	this->mApCommitQueued = true;
+	QMetaObject::invokeMethod(this, &NMWirelessDevice::commitAccessPoints, Qt::QueuedConnection);
+}
+
+void NMWirelessDevice::commitAccessPoints() {
+	this->mApCommitQueued = false;
+
+	for (const auto& change: this->mApIndex.commit()) {
+		auto* net = this->mNetworks.value(change.ssid);
+		if (!net) {
+			if (change.accessPoints.isEmpty()) continue;
+			net = this->registerNetwork(change.ssid);
 		}
+
+		auto accessPoints = QList<NMAccessPoint*>();
+		accessPoints.reserve(change.accessPoints.size());
+
+		for (const auto& path: change.accessPoints) {
+			if (auto* ap = this->mAccessPoints.value(path)) accessPoints.append(ap);
+		}
+
+		net->setAccessPoints(accessPoints);
 	}
+
+	qDeleteAll(this->mRemovedAccessPoints);
+	this->mRemovedAccessPoints.clear();
 }
 
 void NMWirelessDevice::onSettingsLoaded(NMSettings* settings) {
@@ -251,7 +298,8 @@ void NMWirelessDevice::removeNetwork() {
 	auto* net = qobject_cast<NMWirelessNetwork*>(this->sender());
 	if (this->mNetworks.take(net->ssid())) {
 		if (net->visible()) emit this->networkRemoved(net->frontend());
-		delete net;
+		// may be called while the network is still updating its access points
+		net->deleteLater();
 	};
 }
 
@@ -2,6 +2,7 @@
 
 #include <qdbusextratypes.h>
 #include <qhash.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qtmetamacros.h>
@@ -10,6 +11,7 @@
 #include "../wifi.hpp"
 #include "accesspoint.hpp"
 #include "active_connection.hpp"
+#include "apindex.hpp"
 #include "dbus_nm_wireless.h"
 #include "device.hpp"
 #include "enums.hpp"
@@ -76,11 +78,21 @@ private:
 	void initWireless();
 	void bindFrontend();
 	NMWirelessNetwork* registerNetwork(const QString& ssid);
+	void indexAccessPoint(NMAccessPoint* ap);
+	void queueAccessPointCommit();
+	void commitAccessPoints();
 
 	WifiDevice* mFrontend;
 	QHash<QString, NMAccessPoint*> mAccessPoints;
 	QHash<QString, NMWirelessNetwork*> mNetworks;
 
+	// Access point changes are grouped into networks once per event loop pass,
+	// so a completed scan results in one update per affected network.
+	NMAccessPointIndex mApIndex;
+	bool mApCommitQueued = false;
+	// Removed APs are kept alive until their networks have been updated.
+	QList<NMAccessPoint*> mRemovedAccessPoints;
+
 	QDateTime mLastScanRequest;
 	QTimer mScanTimer;
 	qint32 mScanIntervalMs = 10001;
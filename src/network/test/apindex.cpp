@@ -0,0 +1,163 @@
+#include "apindex.hpp"
+
+#include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qobject.h>
+#include <qset.h>
+#include <qstring.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../nm/apindex.hpp"
+
+using namespace qs::network;
+
+namespace {
+
+NMAccessPointEntry
+ap(const QString& path, quint8 strength, const QString& ssid, bool infrastructure = true) {
+	return {.path = path, .ssid = ssid, .strength = strength, .infrastructure = infrastructure};
+}
+
+QList<NMAccessPointEntry> scan(int number) {
+	switch (number) {
+	case 1:
+		return {
+		    ap("/ap/1", 80, "home"),
+		    ap("/ap/2", 45, "home"),
+		    ap("/ap/3", 62, "home"),
+		    ap("/ap/4", 70, "Coffee Shop"),
+		    ap("/ap/5", 70, "Coffee Shop"),
+		    ap("/ap/6", 30, "office"),
+		    ap("/ap/7", 90, "home", false),
+		    ap("/ap/8", 55, ""),
+		};
+	case 2:
+		return {
+		    ap("/ap/1", 80, "home"),
+		    ap("/ap/2", 85, "home"),
+		    ap("/ap/3", 62, "home"),
+		    ap("/ap/4", 70, "Coffee Shop"),
+		    ap("/ap/6", 31, "office"),
+		    ap("/ap/9", 40, "guest"),
+		};
+	case 3: return {ap("/ap/9", 40, "guest")};
+	default: qFatal("Unknown scan %d", number);
+	}
+}
+
+// Applies a scan as a full snapshot, removing any APs missing from it.
+void applyScan(NMAccessPointIndex& index, QSet<QString>& present, int number) {
+	auto previous = present;
+	present.clear();
+
+	for (const auto& entry: scan(number)) {
+		index.update(entry);
+		present.insert(entry.path);
+	}
+
+	for (const auto& path: previous) {
+		if (!present.contains(path)) index.remove(path);
+	}
+}
+
+QHash<QString, QList<QString>> changeMap(const QList<NMAccessPointGroupChange>& changes) {
+	auto map = QHash<QString, QList<QString>>();
+	for (const auto& change: changes) {
+		if (map.contains(change.ssid)) qFatal("Group changed twice in a single commit");
+		map.insert(change.ssid, change.accessPoints);
+	}
+
+	return map;
+}
+
+} // namespace
+
+void TestAccessPointIndex::groupsByStrength() {
+	auto index = NMAccessPointIndex();
+	auto present = QSet<QString>();
+	applyScan(index, present, 1);
+
+	QVERIFY(index.hasPendingChanges());
+	auto changes = changeMap(index.commit());
+	QVERIFY(!index.hasPendingChanges());
+
+	// adhoc and hidden APs are not grouped
+	QCOMPARE(changes.size(), 3);
+	QCOMPARE(changes.value("home"), QList<QString>({"/ap/1", "/ap/3", "/ap/2"}));
+	// equal strength falls back to path order
+	QCOMPARE(changes.value("Coffee Shop"), QList<QString>({"/ap/4", "/ap/5"}));
+	QCOMPARE(changes.value("office"), QList<QString>({"/ap/6"}));
+
+	QCOMPARE(index.group("home"), changes.value("home"));
+	QVERIFY(index.entry("/ap/7") != nullptr);
+	QVERIFY(index.group("").isEmpty());
+}
+
+void TestAccessPointIndex::publishesOnlyChanges() {
+	auto index = NMAccessPointIndex();
+	auto present = QSet<QString>();
+	applyScan(index, present, 1);
+	index.commit();
+
+	applyScan(index, present, 2);
+	auto changes = changeMap(index.commit());
+
+	// office only changed strength without reordering
+	QCOMPARE(changes.size(), 3);
+	QCOMPARE(changes.value("home"), QList<QString>({"/ap/2", "/ap/1", "/ap/3"}));
+	QCOMPARE(changes.value("Coffee Shop"), QList<QString>({"/ap/4"}));
+	QCOMPARE(changes.value("guest"), QList<QString>({"/ap/9"}));
+	QCOMPARE(index.entry("/ap/6")->strength, 31);
+
+	// an identical scan changes nothing
+	applyScan(index, present, 2);
+	QVERIFY(!index.hasPendingChanges());
+	QVERIFY(index.commit().isEmpty());
+}
+
+void TestAccessPointIndex::movesBetweenGroups() {
+	auto index = NMAccessPointIndex();
+	auto present = QSet<QString>();
+	applyScan(index, present, 1);
+	index.commit();
+
+	auto entry = *index.entry("/ap/6");
+	entry.ssid = "home";
+	index.update(entry);
+
+	// an adhoc AP switching to infrastructure joins its group
+	entry = *index.entry("/ap/7");
+	entry.infrastructure = true;
+	index.update(entry);
+
+	auto changes = changeMap(index.commit());
+	QCOMPARE(changes.size(), 2);
+	QCOMPARE(changes.value("home"), QList<QString>({"/ap/7", "/ap/1", "/ap/3", "/ap/2", "/ap/6"}));
+	QVERIFY(changes.contains("office"));
+	QVERIFY(changes.value("office").isEmpty());
+}
+
+void TestAccessPointIndex::dropsEmptyGroups() {
+	auto index = NMAccessPointIndex();
+	auto present = QSet<QString>();
+	applyScan(index, present, 2);
+	index.commit();
+
+	applyScan(index, present, 3);
+	auto changes = changeMap(index.commit());
+
+	QCOMPARE(changes.size(), 3);
+	for (const auto& ssid: {"home", "Coffee Shop", "office"}) {
+		QVERIFY(changes.contains(ssid));
+		QVERIFY(changes.value(ssid).isEmpty());
+	}
+
+	QCOMPARE(index.ssids(), QList<QString>({"guest"}));
+	QVERIFY(index.entry("/ap/1") == nullptr);
+}
+
+QTEST_MAIN(TestAccessPointIndex);
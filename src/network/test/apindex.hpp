@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestAccessPointIndex: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void groupsByStrength();
+	static void publishesOnlyChanges();
+	static void movesBetweenGroups();
+	static void dropsEmptyGroups();
+};
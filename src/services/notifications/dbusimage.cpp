@@ -1,10 +1,17 @@
 #include "dbusimage.hpp"
+#include <algorithm>
+#include <utility>
 
 #include <qdbusargument.h>
+#include <qfile.h>
 #include <qimage.h>
+#include <qiodevice.h>
+#include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qmutex.h>
+#include <qnamespace.h>
+#include <qpair.h>
 #include <qsize.h>
-#include <qsysinfo.h>
 #include <qtypes.h>
 
 #include "../../core/logcat.hpp"
@@ -16,12 +23,23 @@ QS_DECLARE_LOGGING_CATEGORY(logNotifications); // server.cpp
 
 QImage DBusNotificationImage::createImage() const {
 	auto format = this->hasAlpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888;
+	auto bytesPerLine = static_cast<qsizetype>(this->width) * (this->hasAlpha ? 4 : 3);
+
+	if (this->width <= 0 || this->height <= 0 || this->data.size() < bytesPerLine * this->height) {
+		return QImage();
+	}
+
+	// The image keeps its own reference to the buffer, so it outlives later updates.
+	auto* buffer = new QByteArray(this->data);
 
 	return QImage(
-	    reinterpret_cast<const uchar*>(this->data.data()),
+	    reinterpret_cast<const uchar*>(buffer->constData()),
 	    this->width,
 	    this->height,
-	    format
+	    bytesPerLine,
+	    format,
+	    [](void* buffer) { delete static_cast<QByteArray*>(buffer); },
+	    buffer
 	);
 }
 
@@ -63,9 +81,110 @@ const QDBusArgument& operator<<(QDBusArgument& argument, const DBusNotificationI
 	return argument;
 }
 
-QImage
-NotificationImage::requestImage(const QString& /*unused*/, QSize* size, const QSize& /*unused*/) {
-	auto image = this->image.createImage();
+NotificationImage::~NotificationImage() { this->removeEvicted(); }
+
+bool NotificationImage::hasData() const {
+	auto lock = QMutexLocker(&this->mutex);
+	return !this->image.data.isEmpty() || !this->evictedPath.isEmpty();
+}
+
+void NotificationImage::clear() {
+	auto lock = QMutexLocker(&this->mutex);
+	this->removeEvicted();
+	this->image = DBusNotificationImage();
+	this->decoded = QImage();
+	this->scaledCache.clear();
+}
+
+bool NotificationImage::setImage(DBusNotificationImage image) {
+	auto lock = QMutexLocker(&this->mutex);
+	this->restoreEvicted();
+	this->lastUsed.start();
+	if (image == this->image) return false;
+
+	this->image = std::move(image);
+	this->decoded = QImage();
+	this->scaledCache.clear();
+	lock.unlock();
+
+	this->imageChanged();
+	return true;
+}
+
+void NotificationImage::evictIfUnused(const QString& path, qint64 unusedMs) {
+	auto lock = QMutexLocker(&this->mutex);
+	if (this->image.data.isEmpty() || this->lastUsed.elapsed() < unusedMs) return;
+
+	auto file = QFile(path);
+
+	if (!file.open(QIODevice::WriteOnly)
+	    || file.write(this->image.data) != this->image.data.size())
+	{
+		qCWarning(logNotifications) << "Failed to evict notification image to" << path
+		                            << file.errorString();
+		file.remove();
+		return;
+	}
+
+	qCDebug(logNotifications) << "Evicted" << this->image.data.size() << "bytes of image data to"
+	                          << path;
+
+	this->evictedPath = path;
+	this->image.data = QByteArray();
+	this->decoded = QImage();
+	this->scaledCache.clear();
+}
+
+void NotificationImage::restoreEvicted() {
+	if (this->evictedPath.isEmpty()) return;
+
+	auto file = QFile(this->evictedPath);
+
+	if (file.open(QIODevice::ReadOnly)) {
+		this->image.data = file.readAll();
+	} else {
+		qCWarning(logNotifications) << "Failed to restore evicted notification image from"
+		                            << this->evictedPath << file.errorString();
+	}
+
+	this->removeEvicted();
+}
+
+void NotificationImage::removeEvicted() {
+	if (this->evictedPath.isEmpty()) return;
+	QFile::remove(this->evictedPath);
+	this->evictedPath.clear();
+}
+
+QImage NotificationImage::requestImage(
+    const QString& /*unused*/,
+    QSize* size,
+    const QSize& requestedSize
+) {
+	auto lock = QMutexLocker(&this->mutex);
+	this->restoreEvicted();
+	this->lastUsed.start();
+
+	if (this->decoded.isNull()) this->decoded = this->image.createImage();
+	auto image = this->decoded;
+
+	auto targetSize = image.size().scaled(requestedSize, Qt::KeepAspectRatio);
+	if (!image.isNull() && requestedSize.isValid() && !requestedSize.isEmpty()
+	    && targetSize != image.size())
+	{
+		auto cached = std::ranges::find_if(this->scaledCache, [&](const auto& entry) {
+			return entry.first == targetSize;
+		});
+
+		if (cached != this->scaledCache.end()) {
+			image = cached->second;
+		} else {
+			image = image.scaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+			if (this->scaledCache.length() == MAX_CACHED_SIZES) this->scaledCache.removeFirst();
+			this->scaledCache.append({targetSize, image});
+		}
+	}
 
 	if (size != nullptr) *size = image.size();
 	return image;
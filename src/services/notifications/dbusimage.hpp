@@ -1,8 +1,15 @@
 #pragma once
 
 #include <qdbusargument.h>
+#include <qelapsedtimer.h>
 #include <qimage.h>
+#include <qlist.h>
+#include <qmutex.h>
 #include <qobject.h>
+#include <qsize.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtypes.h>
 
 #include "../../core/imageprovider.hpp"
 
@@ -14,8 +21,10 @@ struct DBusNotificationImage {
 	bool hasAlpha = false;
 	QByteArray data;
 
-	// valid only for the lifetime of the pixmap
+	// Shares data with the returned image instead of copying it.
 	[[nodiscard]] QImage createImage() const;
+
+	[[nodiscard]] bool operator==(const DBusNotificationImage& other) const = default;
 };
 
 const QDBusArgument& operator>>(const QDBusArgument& argument, DBusNotificationImage& pixmap);
@@ -24,19 +33,35 @@ const QDBusArgument& operator<<(QDBusArgument& argument, const DBusNotificationI
 class NotificationImage: public QsIndexedImageHandle {
 public:
 	explicit NotificationImage(): QsIndexedImageHandle(QQuickAsyncImageProvider::Image) {}
+	~NotificationImage() override;
+	Q_DISABLE_COPY_MOVE(NotificationImage);
+
+	[[nodiscard]] bool hasData() const;
+	void clear();
 
-	[[nodiscard]] bool hasData() const { return !this->image.data.isEmpty(); }
-	void clear() { this->image.data.clear(); }
+	// Returns false without invalidating the url if the image is unchanged.
+	bool setImage(DBusNotificationImage image);
 
-	[[nodiscard]] DBusNotificationImage& writeImage() {
-		this->imageChanged();
-		return this->image;
-	}
+	// Writes the image data to path and drops it from memory if the image has not been
+	// requested for unusedMs. It is read back the next time it is requested.
+	void evictIfUnused(const QString& path, qint64 unusedMs);
 
+	// May be called from an image loader thread.
 	QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
 
 private:
+	static constexpr qsizetype MAX_CACHED_SIZES = 4;
+
+	// Must be called with the mutex held.
+	void restoreEvicted();
+	void removeEvicted();
+
+	mutable QMutex mutex;
 	DBusNotificationImage image;
+	QImage decoded;
+	QList<QPair<QSize, QImage>> scaledCache;
+	QElapsedTimer lastUsed;
+	QString evictedPath;
 };
 
 } // namespace qs::service::notifications
@@ -1,6 +1,8 @@
 #include "notification.hpp"
+#include <utility>
 
 #include <qcontainerfwd.h>
+#include <qdatetime.h>
 #include <qdbusargument.h>
 #include <qlist.h>
 #include <qlogging.h>
@@ -15,6 +17,7 @@
 #include "../../core/logcat.hpp"
 #include "dbusimage.hpp"
 #include "server.hpp"
+#include "store.hpp"
 
 namespace qs::service::notifications {
 
@@ -43,7 +46,7 @@ QString NotificationAction::identifier() const { return this->mIdentifier; }
 QString NotificationAction::text() const { return this->mText; }
 
 void NotificationAction::invoke() {
-	if (this->notification->isRetained()) {
+	if (this->notification->isRetained() || this->notification->isHistory()) {
 		qCritical() << "Cannot invoke destroyed notification" << this;
 		return;
 	}
@@ -71,6 +74,11 @@ void Notification::close(NotificationCloseReason::Enum reason) {
 		return;
 	}
 
+	if (this->mHistory) {
+		if (reason == 0) qCritical() << "Cannot track notification restored from history" << this;
+		return;
+	}
+
 	this->mCloseReason = reason;
 
 	if (reason != 0) {
@@ -144,7 +152,9 @@ void Notification::updateProperties(
 		this->mImagePixmap.clear();
 	} else {
 		auto value = hints.value(imageDataName).value<QDBusArgument>();
-		value >> this->mImagePixmap.writeImage();
+		auto image = DBusNotificationImage();
+		value >> image;
+		this->mImagePixmap.setImage(std::move(image));
 		imagePath = this->mImagePixmap.url();
 	}
 
@@ -244,4 +254,39 @@ void Notification::setTracked(bool tracked) {
 bool Notification::isLastGeneration() const { return this->mLastGeneration; }
 void Notification::setLastGeneration() { this->mLastGeneration = true; }
 
+NotificationRecord Notification::toRecord() const {
+	auto record = NotificationRecord();
+	record.key = this->mHistoryKey;
+	record.id = this->mId;
+	record.timestamp = QDateTime::currentMSecsSinceEpoch();
+	record.appName = this->bAppName.value();
+	record.appIcon = this->bAppIcon.value();
+	record.summary = this->bSummary.value();
+	record.body = this->bBody.value();
+	record.desktopEntry = this->bDesktopEntry.value();
+	record.urgency = this->bUrgency.value();
+	record.closeReason = this->mCloseReason;
+
+	// Image data only lives as long as the notification, but named or file images can be kept.
+	if (!this->mImagePixmap.hasData()) record.image = this->bImage.value();
+
+	return record;
+}
+
+void Notification::restore(const NotificationRecord& record) {
+	this->mHistory = true;
+	this->mHistoryKey = record.key;
+	this->mCloseReason = record.closeReason == 0
+	                       ? NotificationCloseReason::Dismissed
+	                       : static_cast<NotificationCloseReason::Enum>(record.closeReason);
+
+	this->bAppName = record.appName;
+	this->bAppIcon = record.appIcon;
+	this->bSummary = record.summary;
+	this->bBody = record.body;
+	this->bDesktopEntry = record.desktopEntry;
+	this->bImage = record.image;
+	this->bUrgency = static_cast<NotificationUrgency::Enum>(record.urgency);
+}
+
 } // namespace qs::service::notifications
@@ -10,9 +10,11 @@
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+#include "../../core/memorystats.hpp"
 #include "../../core/retainable.hpp"
 #include "../../core/util.hpp"
 #include "dbusimage.hpp"
+#include "store.hpp"
 
 namespace qs::service::notifications {
 
@@ -80,6 +82,11 @@ class Notification
 	/// Notifications from the last generation will only be emitted
 	/// if @@NotificationServer.keepOnReload is true.
 	Q_PROPERTY(bool lastGeneration READ isLastGeneration CONSTANT);
+	/// If this notification was restored from @@NotificationServer.history() and is no longer live.
+	///
+	/// History entries cannot be tracked, and their actions cannot be invoked.
+	/// Image data sent with the notification is not kept in history.
+	Q_PROPERTY(bool history READ isHistory CONSTANT);
 	/// Time in seconds the notification should be valid for
 	Q_PROPERTY(qreal expireTimeout READ default NOTIFY expireTimeoutChanged BINDABLE bindableExpireTimeout);
 	/// The sending application's name.
@@ -154,6 +161,17 @@ public:
 	[[nodiscard]] bool isLastGeneration() const;
 	void setLastGeneration();
 
+	[[nodiscard]] bool isHistory() const { return this->mHistory; }
+	[[nodiscard]] quint64 historyKey() const { return this->mHistoryKey; }
+	void setHistoryKey(quint64 key) { this->mHistoryKey = key; }
+	[[nodiscard]] NotificationRecord toRecord() const;
+	void restore(const NotificationRecord& record);
+
+	// Moves image data to path if the image has not been shown for unusedMs.
+	void evictImageIfUnused(const QString& path, qint64 unusedMs) {
+		this->mImagePixmap.evictIfUnused(path, unusedMs);
+	}
+
 	[[nodiscard]] QBindable<qreal> bindableExpireTimeout() const { return &this->bExpireTimeout; }
 	[[nodiscard]] QBindable<QString> bindableAppName() const { return &this->bAppName; }
 	[[nodiscard]] QBindable<QString> bindableAppIcon() const { return &this->bAppIcon; }
@@ -208,8 +226,11 @@ private:
 	quint32 mId;
 	NotificationCloseReason::Enum mCloseReason = NotificationCloseReason::Dismissed;
 	bool mLastGeneration = false;
+	bool mHistory = false;
+	quint64 mHistoryKey = 0;
 	NotificationImage mImagePixmap;
 	QList<NotificationAction*> mActions;
+	LiveObjectCount<"Notification"> liveCount;
 
 	// clang-format off
 	Q_OBJECT_BINDABLE_PROPERTY(Notification, qreal, bExpireTimeout, &Notification::expireTimeoutChanged);
@@ -2,6 +2,7 @@
 #include <utility>
 
 #include <qcontainerfwd.h>
+#include <qlist.h>
 #include <qlogging.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
@@ -23,8 +24,16 @@ void NotificationServerQml::onPostReload() {
 	    &NotificationServerQml::notification
 	);
 
+	QObject::connect(
+	    instance,
+	    &NotificationServer::historyChanged,
+	    this,
+	    &NotificationServerQml::historyChanged
+	);
+
 	instance->switchGeneration(this->mKeepOnReload, [this]() {
 		this->live = true;
+		this->updateHistory();
 		emit this->trackedNotificationsChanged();
 	});
 }
@@ -141,6 +150,73 @@ ObjectModel<Notification>* NotificationServerQml::trackedNotifications() const {
 	}
 }
 
+bool NotificationServerQml::historyEnabled() const { return this->mHistoryEnabled; }
+
+void NotificationServerQml::setHistoryEnabled(bool historyEnabled) {
+	if (historyEnabled == this->mHistoryEnabled) return;
+	this->mHistoryEnabled = historyEnabled;
+	this->updateHistory();
+	emit this->historyEnabledChanged();
+}
+
+qsizetype NotificationServerQml::historyLimit() const { return this->mHistoryLimit; }
+
+void NotificationServerQml::setHistoryLimit(qsizetype historyLimit) {
+	if (historyLimit == this->mHistoryLimit) return;
+	this->mHistoryLimit = historyLimit;
+	this->updateHistory();
+	emit this->historyLimitChanged();
+}
+
+qsizetype NotificationServerQml::historyCount() const {
+	if (!this->live) return 0;
+	return NotificationServer::instance()->history().count();
+}
+
+QList<QString> NotificationServerQml::historyApps() const {
+	if (!this->live) return {};
+	return NotificationServer::instance()->history().apps();
+}
+
+QList<Notification*> NotificationServerQml::history(qsizetype offset, qsizetype count) const {
+	if (!this->live) return {};
+	auto* instance = NotificationServer::instance();
+	return instance->historyEntries(instance->history().keys(offset, count));
+}
+
+QList<Notification*>
+NotificationServerQml::historyForApp(const QString& appName, qsizetype count) const {
+	if (!this->live) return {};
+	auto* instance = NotificationServer::instance();
+	return instance->historyEntries(instance->history().keysForApp(appName, count));
+}
+
+QList<Notification*>
+NotificationServerQml::searchHistory(const QString& query, qsizetype count) const {
+	if (!this->live) return {};
+	auto* instance = NotificationServer::instance();
+	return instance->historyEntries(instance->history().search(query, count));
+}
+
+void NotificationServerQml::removeFromHistory(Notification* notification) const {
+	if (!this->live || notification == nullptr || notification->historyKey() == 0) return;
+	NotificationServer::instance()->removeFromHistory(notification->historyKey());
+}
+
+void NotificationServerQml::clearHistory() const {
+	if (!this->live) return;
+	NotificationServer::instance()->clearHistory();
+}
+
+void NotificationServerQml::updateHistory() {
+	if (!this->live) return;
+
+	auto* instance = NotificationServer::instance();
+	// limit first so an oversized journal is trimmed as it is replayed
+	instance->setHistoryLimit(this->mHistoryLimit);
+	instance->setHistoryEnabled(this->mHistoryEnabled);
+}
+
 void NotificationServerQml::updateSupported() {
 	if (this->live) {
 		NotificationServer::instance()->support = this->support;
@@ -72,12 +72,44 @@ class NotificationServerQml: public PostReloadHook {
 	Q_PROPERTY(UntypedObjectModel* trackedNotifications READ trackedNotifications NOTIFY trackedNotificationsChanged);
 	/// Extra hints to expose to notification clients.
 	Q_PROPERTY(QVector<QString> extraHints READ extraHints WRITE setExtraHints NOTIFY extraHintsChanged);
+	/// If received notifications should be kept in a history that persists across restarts.
+	/// Defaults to false.
+	///
+	/// History is stored as a journal in @@Quickshell.Quickshell.stateDir and can be browsed
+	/// with @@history(), @@historyForApp() and @@searchHistory(). Notifications with the
+	/// @@Notification.transient flag set are not recorded, and image data is not kept.
+	Q_PROPERTY(bool historyEnabled READ historyEnabled WRITE setHistoryEnabled NOTIFY historyEnabledChanged);
+	/// The maximum number of notifications kept in history. The oldest are dropped first.
+	/// Defaults to 1000.
+	Q_PROPERTY(qsizetype historyLimit READ historyLimit WRITE setHistoryLimit NOTIFY historyLimitChanged);
+	/// The number of notifications currently in history.
+	Q_PROPERTY(qsizetype historyCount READ historyCount NOTIFY historyChanged);
+	/// The names of all applications with notifications in history, sorted alphabetically.
+	Q_PROPERTY(QList<QString> historyApps READ historyApps NOTIFY historyChanged);
 	// clang-format on
 	QML_NAMED_ELEMENT(NotificationServer);
 
 public:
 	void onPostReload() override;
 
+	/// Returns up to `count` notifications from history, newest first, skipping the first `offset`.
+	///
+	/// Notifications that are still live are returned as is. Others are created on demand
+	/// with @@Notification.history set, and are destroyed once no longer referenced.
+	Q_INVOKABLE QList<qs::service::notifications::Notification*>
+	history(qsizetype offset, qsizetype count) const;
+	/// Returns up to `count` notifications from history sent by `appName`, newest first.
+	Q_INVOKABLE QList<qs::service::notifications::Notification*>
+	historyForApp(const QString& appName, qsizetype count) const;
+	/// Returns up to `count` notifications from history, newest first, whose app name,
+	/// summary or body contains every word of `query`. The last word may be incomplete.
+	Q_INVOKABLE QList<qs::service::notifications::Notification*>
+	searchHistory(const QString& query, qsizetype count) const;
+	/// Removes a notification from history. Live notifications are not closed.
+	Q_INVOKABLE void removeFromHistory(qs::service::notifications::Notification* notification) const;
+	/// Removes all notifications from history.
+	Q_INVOKABLE void clearHistory() const;
+
 	[[nodiscard]] bool keepOnReload() const;
 	void setKeepOnReload(bool keepOnReload);
 
@@ -113,6 +145,15 @@ public:
 
 	[[nodiscard]] ObjectModel<Notification>* trackedNotifications() const;
 
+	[[nodiscard]] bool historyEnabled() const;
+	void setHistoryEnabled(bool historyEnabled);
+
+	[[nodiscard]] qsizetype historyLimit() const;
+	void setHistoryLimit(qsizetype historyLimit);
+
+	[[nodiscard]] qsizetype historyCount() const;
+	[[nodiscard]] QList<QString> historyApps() const;
+
 signals:
 	/// Sent when a notification is received by the server.
 	///
@@ -131,12 +172,18 @@ signals:
 	void inlineReplySupportedChanged();
 	void extraHintsChanged();
 	void trackedNotificationsChanged();
+	void historyEnabledChanged();
+	void historyLimitChanged();
+	void historyChanged();
 
 private:
 	void updateSupported();
+	void updateHistory();
 
 	bool live = false;
 	bool mKeepOnReload = true;
+	bool mHistoryEnabled = false;
+	qsizetype mHistoryLimit = 1000;
 	NotificationServerSupport support;
 };
 
@@ -1,33 +1,90 @@
 #include "server.hpp"
 #include <functional>
 
+#include <qbytearray.h>
 #include <qcontainerfwd.h>
 #include <qcoreapplication.h>
+#include <qdatastream.h>
 #include <qdbusconnection.h>
 #include <qdbusmetatype.h>
 #include <qdbusservicewatcher.h>
+#include <qiodevice.h>
+#include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qminmax.h>
 #include <qqmlengine.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
 #include "../../core/logcat.hpp"
 #include "../../core/model.hpp"
+#include "../../core/paths.hpp"
+#include "../../core/recovery.hpp"
 #include "dbus_notifications.h"
 #include "dbusimage.hpp"
 #include "notification.hpp"
+#include "store.hpp"
 
 namespace qs::service::notifications {
 
 // NOLINTNEXTLINE(misc-use-internal-linkage)
 QS_LOGGING_CATEGORY(logNotifications, "quickshell.service.notifications", QtWarningMsg);
 
+namespace {
+
+// Images of tracked notifications which have not been requested in this long are moved to
+// the instance run dir until they are shown again.
+constexpr int IMAGE_EVICTION_INTERVAL = 60000;
+
+// Enough of a tracked notification to replay it through Notify after a crash.
+struct RecoveredNotification {
+	quint32 id = 0;
+	quint64 historyKey = 0;
+	QString appName;
+	QString appIcon;
+	QString summary;
+	QString body;
+	QStringList actions;
+	QVariantMap hints;
+	qint32 expireTimeout = -1;
+};
+
+QDataStream& operator<<(QDataStream& stream, const RecoveredNotification& data) {
+	stream << data.id << data.historyKey << data.appName << data.appIcon << data.summary << data.body
+	       << data.actions << data.hints << data.expireTimeout;
+
+	return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, RecoveredNotification& data) {
+	stream >> data.id >> data.historyKey >> data.appName >> data.appIcon >> data.summary >> data.body
+	    >> data.actions >> data.hints >> data.expireTimeout;
+
+	return stream;
+}
+
+} // namespace
+
 NotificationServer::NotificationServer() {
 	qDBusRegisterMetaType<DBusNotificationImage>();
 
+	auto* recovery = RecoverySnapshot::instance();
+	this->recovered = recovery->take("notifications");
+	recovery->addSource("notifications", [this]() { return this->saveRecoverySnapshot(); });
+
 	new DBusNotificationServer(this);
 
+	this->imageEvictionTimer.setInterval(IMAGE_EVICTION_INTERVAL);
+	QObject::connect(
+	    &this->imageEvictionTimer,
+	    &QTimer::timeout,
+	    this,
+	    &NotificationServer::evictUnusedImages
+	);
+	this->imageEvictionTimer.start();
+
 	qCInfo(logNotifications) << "Starting notification server";
 
 	auto bus = QDBusConnection::sessionBus();
@@ -63,6 +120,8 @@ NotificationServer* NotificationServer::instance() {
 }
 
 void NotificationServer::switchGeneration(bool reEmit, const std::function<void()>& clearHook) {
+	if (!this->recovered.isEmpty()) this->restoreRecoverySnapshot();
+
 	auto notifications = this->mNotifications.valueList();
 	this->mNotifications.valueList().clear();
 	this->idMap.clear();
@@ -76,6 +135,10 @@ void NotificationServer::switchGeneration(bool reEmit, const std::function<void(
 			emit this->notification(notification);
 
 			if (!notification->isTracked()) {
+				if (notification->historyKey() != 0) {
+					this->store.setCloseReason(notification->historyKey(), notification->closeReason());
+				}
+
 				emit this->NotificationClosed(notification->id(), notification->closeReason());
 				delete notification;
 			} else {
@@ -85,6 +148,10 @@ void NotificationServer::switchGeneration(bool reEmit, const std::function<void(
 		}
 	} else {
 		for (auto* notification: notifications) {
+			if (notification->historyKey() != 0) {
+				this->store.setCloseReason(notification->historyKey(), NotificationCloseReason::Expired);
+			}
+
 			emit this->NotificationClosed(notification->id(), NotificationCloseReason::Expired);
 			delete notification;
 		}
@@ -99,17 +166,202 @@ void NotificationServer::deleteNotification(
     Notification* notification,
     NotificationCloseReason::Enum reason
 ) {
-	if (!this->idMap.contains(notification->id())) return;
+	// history entries may share an id with a live notification from an earlier run
+	if (this->idMap.value(notification->id()) != notification) return;
 
 	emit notification->closed(reason);
 
 	this->mNotifications.removeObject(notification);
 	this->idMap.remove(notification->id());
 
+	if (notification->historyKey() != 0) {
+		this->store.setCloseReason(notification->historyKey(), reason);
+	}
+
 	emit this->NotificationClosed(notification->id(), reason);
 	notification->retainedDestroy();
 }
 
+void NotificationServer::setHistoryEnabled(bool enabled) {
+	if (enabled == this->historyEnabled) return;
+	this->historyEnabled = enabled;
+
+	if (enabled) {
+		auto path = QsPaths::instance()->shellStateDir().filePath("notifications.journal");
+		this->store.open(path);
+
+		// Keep ids unique across restarts so history entries don't alias new notifications.
+		this->nextId = qMax(this->nextId, this->store.maxId() + 1);
+
+		qCDebug(logNotifications) << "Loaded" << this->store.count() << "notifications from history";
+	} else {
+		this->store.close();
+		this->store.open(QString());
+	}
+
+	emit this->historyChanged();
+}
+
+void NotificationServer::setHistoryLimit(qsizetype limit) {
+	if (limit == this->store.limit()) return;
+	this->store.setLimit(limit);
+	emit this->historyChanged();
+}
+
+Notification* NotificationServer::historyEntry(quint64 key) {
+	if (auto* notification = this->historyObjects.value(key).data()) return notification;
+
+	for (auto* notification: this->idMap) {
+		if (notification->historyKey() == key) return notification;
+	}
+
+	const auto* record = this->store.record(key);
+	if (record == nullptr) return nullptr;
+
+	// Entries are only materialized when asked for, and collected by the engine once unused.
+	auto* notification = new Notification(record->id, nullptr);
+	notification->restore(*record);
+	QQmlEngine::setObjectOwnership(notification, QQmlEngine::JavaScriptOwnership);
+
+	if (this->historyObjects.size() >= 256) {
+		this->historyObjects.removeIf([](QHash<quint64, QPointer<Notification>>::iterator entry) {
+			return entry.value().isNull();
+		});
+	}
+
+	this->historyObjects.insert(key, notification);
+	return notification;
+}
+
+QList<Notification*> NotificationServer::historyEntries(const QList<quint64>& keys) {
+	auto entries = QList<Notification*>();
+	entries.reserve(keys.length());
+
+	for (auto key: keys) {
+		if (auto* entry = this->historyEntry(key)) entries.append(entry);
+	}
+
+	return entries;
+}
+
+void NotificationServer::removeFromHistory(quint64 key) {
+	if (!this->store.remove(key)) return;
+	this->historyObjects.remove(key);
+
+	for (auto* notification: this->idMap) {
+		if (notification->historyKey() == key) notification->setHistoryKey(0);
+	}
+
+	emit this->historyChanged();
+}
+
+void NotificationServer::clearHistory() {
+	this->store.clear();
+	this->historyObjects.clear();
+
+	for (auto* notification: this->idMap) {
+		notification->setHistoryKey(0);
+	}
+
+	emit this->historyChanged();
+}
+
+void NotificationServer::recordHistory(Notification* notification) {
+	// transient notifications explicitly ask to skip persistence
+	if (!this->historyEnabled || notification->bindableTransient().value()) return;
+
+	auto key = this->store.insert(notification->toRecord());
+	notification->setHistoryKey(key);
+	emit this->historyChanged();
+}
+
+void NotificationServer::evictUnusedImages() {
+	auto* runDir = QsPaths::instance()->instanceRunDir();
+	if (runDir == nullptr) return;
+
+	for (auto* notification: this->mNotifications.valueList()) {
+		auto path = runDir->filePath(QStringLiteral("notification-image-%1").arg(notification->id()));
+		notification->evictImageIfUnused(path, IMAGE_EVICTION_INTERVAL);
+	}
+}
+
+QByteArray NotificationServer::saveRecoverySnapshot() const {
+	auto notifications = QList<RecoveredNotification>();
+
+	for (auto* notification: this->mNotifications.valueList()) {
+		auto actions = QStringList();
+		for (auto* action: notification->actions()) {
+			actions << action->identifier() << action->text();
+		}
+
+		if (notification->bindableHasInlineReply().value()) {
+			actions << QStringLiteral("inline-reply")
+			        << notification->bindableInlineReplyPlaceholder().value();
+		}
+
+		auto hints = notification->bindableHints().value();
+		hints.removeIf([](QVariantMap::iterator hint) {
+			return !RecoverySnapshot::canSave(hint.value());
+		});
+
+		notifications.append({
+		    .id = notification->id(),
+		    .historyKey = notification->historyKey(),
+		    .appName = notification->bindableAppName().value(),
+		    .appIcon = notification->bindableAppIcon().value(),
+		    .summary = notification->bindableSummary().value(),
+		    .body = notification->bindableBody().value(),
+		    .actions = actions,
+		    .hints = hints,
+		    .expireTimeout = static_cast<qint32>(notification->bindableExpireTimeout().value()),
+		});
+	}
+
+	if (notifications.isEmpty() && this->nextId == 1) return QByteArray();
+
+	auto data = QByteArray();
+	auto stream = QDataStream(&data, QIODevice::WriteOnly);
+	stream << this->nextId << notifications;
+	return data;
+}
+
+void NotificationServer::restoreRecoverySnapshot() {
+	auto stream = QDataStream(this->recovered);
+	auto notifications = QList<RecoveredNotification>();
+	quint32 nextId = 0;
+	stream >> nextId >> notifications;
+	this->recovered.clear();
+
+	if (stream.status() != QDataStream::Ok) return;
+
+	// Keep ids from the crashed instance valid so senders can still replace and close them.
+	this->nextId = qMax(this->nextId, nextId);
+
+	for (const auto& data: notifications) {
+		if (data.id == 0 || this->idMap.contains(data.id)) continue;
+
+		auto* notification = new Notification(data.id, this);
+		QQmlEngine::setObjectOwnership(notification, QQmlEngine::CppOwnership);
+
+		notification->updateProperties(
+		    data.appName,
+		    data.appIcon,
+		    data.summary,
+		    data.body,
+		    data.actions,
+		    data.hints,
+		    data.expireTimeout
+		);
+
+		notification->setHistoryKey(data.historyKey);
+		this->idMap.insert(data.id, notification);
+		this->mNotifications.insertObject(notification);
+	}
+
+	qCDebug(logNotifications) << "Restored" << notifications.length()
+	                          << "notifications from before a crash";
+}
+
 void NotificationServer::tryRegister() {
 	auto bus = QDBusConnection::sessionBus();
 	auto success = bus.registerService("org.freedesktop.Notifications");
@@ -191,11 +443,16 @@ uint NotificationServer::Notify(
 	}
 
 	notification->updateProperties(appName, appIcon, summary, body, actions, hints, expireTimeout);
+	this->recordHistory(notification);
 
 	if (!old) {
 		emit this->notification(notification);
 
 		if (!notification->isTracked()) {
+			if (notification->historyKey() != 0) {
+				this->store.setCloseReason(notification->historyKey(), notification->closeReason());
+			}
+
 			emit this->NotificationClosed(notification->id(), notification->closeReason());
 			delete notification;
 		} else {
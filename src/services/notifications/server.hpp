@@ -2,15 +2,19 @@
 
 #include <functional>
 
+#include <qbytearray.h>
 #include <qcontainerfwd.h>
 #include <qdbusservicewatcher.h>
 #include <qhash.h>
 #include <qobject.h>
+#include <qpointer.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
 #include "../../core/model.hpp"
 #include "notification.hpp"
+#include "store.hpp"
 
 namespace qs::service::notifications {
 
@@ -37,6 +41,16 @@ public:
 	ObjectModel<Notification>* trackedNotifications();
 	void deleteNotification(Notification* notification, NotificationCloseReason::Enum reason);
 
+	void setHistoryEnabled(bool enabled);
+	void setHistoryLimit(qsizetype limit);
+	[[nodiscard]] const NotificationStore& history() const { return this->store; }
+	// Returns the live notification for key if there is one, otherwise a history entry
+	// owned by the javascript engine.
+	Notification* historyEntry(quint64 key);
+	QList<Notification*> historyEntries(const QList<quint64>& keys);
+	void removeFromHistory(quint64 key);
+	void clearHistory();
+
 	// NOLINTBEGIN
 	void CloseNotification(uint id);
 	QStringList GetCapabilities() const;
@@ -57,6 +71,7 @@ public:
 
 signals:
 	void notification(Notification* notification);
+	void historyChanged();
 
 	// NOLINTBEGIN
 	void NotificationClosed(quint32 id, quint32 reason);
@@ -66,16 +81,27 @@ signals:
 
 private slots:
 	static void onServiceUnregistered(const QString& service);
+	void evictUnusedImages();
 
 private:
 	explicit NotificationServer();
 
 	static void tryRegister();
+	void recordHistory(Notification* notification);
+	[[nodiscard]] QByteArray saveRecoverySnapshot() const;
+	void restoreRecoverySnapshot();
 
 	QDBusServiceWatcher serviceWatcher;
 	quint32 nextId = 1;
 	QHash<quint32, Notification*> idMap;
 	ObjectModel<Notification> mNotifications {this};
+
+	bool historyEnabled = false;
+	NotificationStore store;
+	QHash<quint64, QPointer<Notification>> historyObjects;
+	// tracked notifications from before a crash, restored once the server is configured
+	QByteArray recovered;
+	QTimer imageEvictionTimer;
 };
 
 } // namespace qs::service::notifications
@@ -0,0 +1,437 @@
+#include "store.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include <qbuffer.h>
+#include <qcontainerfwd.h>
+#include <qdatastream.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qiodevice.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qminmax.h>
+#include <qsavefile.h>
+#include <qstringbuilder.h>
+#include <qtypes.h>
+
+#include "../../core/logcat.hpp"
+
+namespace qs::service::notifications {
+
+// NOLINTNEXTLINE(misc-use-internal-linkage)
+QS_DECLARE_LOGGING_CATEGORY(logNotifications); // server.cpp
+
+namespace {
+
+constexpr quint32 JOURNAL_MAGIC = 0x514e534a; // QNSJ
+constexpr quint32 JOURNAL_VERSION = 1;
+constexpr qsizetype JOURNAL_HEADER_SIZE = sizeof(JOURNAL_MAGIC) + sizeof(JOURNAL_VERSION);
+// Pinned so the journal format does not depend on the Qt version quickshell was built against.
+constexpr auto JOURNAL_STREAM_VERSION = QDataStream::Qt_6_6;
+
+QByteArray journalHeader() {
+	auto header = QByteArray();
+	auto stream = QDataStream(&header, QIODevice::WriteOnly);
+	stream.setVersion(JOURNAL_STREAM_VERSION);
+	stream << JOURNAL_MAGIC << JOURNAL_VERSION;
+	return header;
+}
+
+} // namespace
+
+QDataStream& operator<<(QDataStream& stream, const NotificationRecord& record) {
+	stream << record.key << record.id << record.timestamp << record.appName << record.appIcon
+	       << record.summary << record.body << record.desktopEntry << record.image << record.urgency
+	       << record.closeReason;
+
+	return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, NotificationRecord& record) {
+	stream >> record.key >> record.id >> record.timestamp >> record.appName >> record.appIcon
+	    >> record.summary >> record.body >> record.desktopEntry >> record.image >> record.urgency
+	    >> record.closeReason;
+
+	return stream;
+}
+
+NotificationStore::~NotificationStore() { this->close(); }
+
+bool NotificationStore::open(const QString& path) {
+	this->close();
+	this->applyClear();
+	if (path.isEmpty()) return true;
+
+	QDir().mkpath(QFileInfo(path).path());
+	this->journal.setFileName(path);
+
+	if (!this->journal.open(QIODevice::ReadWrite)) {
+		qCWarning(logNotifications) << "Could not open notification history journal at" << path
+		                            << this->journal.errorString();
+		return false;
+	}
+
+	this->replay();
+	this->maybeCompact();
+	return true;
+}
+
+void NotificationStore::close() {
+	if (this->journal.isOpen()) this->journal.close();
+	this->journalEntries = 0;
+}
+
+void NotificationStore::setLimit(qsizetype limit) {
+	this->mLimit = qMax(static_cast<qsizetype>(0), limit);
+	this->enforceLimit();
+	this->maybeCompact();
+}
+
+quint64 NotificationStore::insert(NotificationRecord record) {
+	if (record.key == 0) record.key = this->nextKey;
+
+	auto entry = QByteArray();
+	auto stream = QDataStream(&entry, QIODevice::WriteOnly);
+	stream.setVersion(JOURNAL_STREAM_VERSION);
+	stream << static_cast<quint8>(Op::Insert) << record;
+
+	auto key = record.key;
+	this->applyInsert(std::move(record));
+	this->append(entry);
+	this->enforceLimit();
+	this->maybeCompact();
+
+	return key;
+}
+
+void NotificationStore::setCloseReason(quint64 key, quint8 reason) {
+	if (!this->records.contains(key)) return;
+
+	auto entry = QByteArray();
+	auto stream = QDataStream(&entry, QIODevice::WriteOnly);
+	stream.setVersion(JOURNAL_STREAM_VERSION);
+	stream << static_cast<quint8>(Op::Close) << key << reason;
+
+	this->applyClose(key, reason);
+	this->append(entry);
+}
+
+bool NotificationStore::remove(quint64 key) {
+	if (!this->applyRemove(key)) return false;
+
+	auto entry = QByteArray();
+	auto stream = QDataStream(&entry, QIODevice::WriteOnly);
+	stream.setVersion(JOURNAL_STREAM_VERSION);
+	stream << static_cast<quint8>(Op::Remove) << key;
+
+	this->append(entry);
+	this->maybeCompact();
+	return true;
+}
+
+void NotificationStore::clear() {
+	this->applyClear();
+	// nothing worth keeping in the journal either
+	this->compact();
+}
+
+const NotificationRecord* NotificationStore::record(quint64 key) const {
+	auto it = this->records.constFind(key);
+	return it == this->records.constEnd() ? nullptr : &*it;
+}
+
+QList<quint64> NotificationStore::keys(qsizetype offset, qsizetype count) const {
+	auto keys = QList<quint64>();
+	if (offset < 0 || count <= 0 || offset >= this->records.size()) return keys;
+
+	auto it = this->records.constEnd();
+	std::advance(it, -offset);
+
+	while (it != this->records.constBegin() && keys.length() < count) {
+		--it;
+		keys.append(it.key());
+	}
+
+	return keys;
+}
+
+QList<quint64> NotificationStore::keysForApp(const QString& appName, qsizetype count) const {
+	auto keys = QList<quint64>();
+	const auto appKeys = this->byApp.value(appName);
+
+	for (auto it = appKeys.crbegin(); it != appKeys.crend() && keys.length() < count; ++it) {
+		keys.append(*it);
+	}
+
+	return keys;
+}
+
+QList<QString> NotificationStore::apps() const {
+	auto apps = this->byApp.keys();
+	std::ranges::sort(apps);
+	return apps;
+}
+
+QList<quint64> NotificationStore::search(const QString& query, qsizetype count) const {
+	const auto words = NotificationStore::tokenize(query);
+	if (words.isEmpty() || count <= 0) return {};
+
+	auto matches = QSet<quint64>();
+
+	for (auto i = 0; i != words.length(); i++) {
+		const auto& word = words.at(i);
+		auto wordMatches = QSet<quint64>();
+
+		if (i == words.length() - 1) {
+			for (auto it = this->terms.lowerBound(word);
+			     it != this->terms.constEnd() && it.key().startsWith(word);
+			     ++it)
+			{
+				wordMatches.unite(it.value());
+			}
+		} else {
+			wordMatches = this->terms.value(word);
+		}
+
+		if (i == 0) matches = std::move(wordMatches);
+		else matches.intersect(wordMatches);
+
+		if (matches.isEmpty()) return {};
+	}
+
+	auto keys = QList<quint64>(matches.begin(), matches.end());
+	std::ranges::sort(keys, std::greater());
+	if (keys.length() > count) keys.resize(count);
+
+	return keys;
+}
+
+QList<QString> NotificationStore::tokenize(const QString& text) {
+	auto tokens = QList<QString>();
+	qsizetype start = -1;
+
+	for (qsizetype i = 0; i <= text.length(); i++) {
+		auto isWordChar = i != text.length() && text.at(i).isLetterOrNumber();
+
+		if (isWordChar && start == -1) {
+			start = i;
+		} else if (!isWordChar && start != -1) {
+			auto token = text.sliced(start, i - start).toLower();
+			if (!tokens.contains(token)) tokens.append(token);
+			start = -1;
+		}
+	}
+
+	return tokens;
+}
+
+void NotificationStore::applyInsert(NotificationRecord record) {
+	if (auto existing = this->records.find(record.key); existing != this->records.end()) {
+		this->unindex(*existing);
+		this->records.erase(existing);
+	}
+
+	this->nextKey = qMax(this->nextKey, record.key + 1);
+	this->mMaxId = qMax(this->mMaxId, record.id);
+
+	this->index(record);
+	this->records.insert(record.key, std::move(record));
+}
+
+void NotificationStore::applyClose(quint64 key, quint8 reason) {
+	auto it = this->records.find(key);
+	if (it != this->records.end()) it->closeReason = reason;
+}
+
+bool NotificationStore::applyRemove(quint64 key) {
+	auto it = this->records.find(key);
+	if (it == this->records.end()) return false;
+
+	this->unindex(*it);
+	this->records.erase(it);
+	return true;
+}
+
+void NotificationStore::applyClear() {
+	this->records.clear();
+	this->byApp.clear();
+	this->terms.clear();
+}
+
+void NotificationStore::enforceLimit() {
+	// evicted records are dropped from the journal on the next compaction
+	while (this->records.size() > this->mLimit) {
+		this->unindex(this->records.first());
+		this->records.erase(this->records.begin());
+	}
+}
+
+void NotificationStore::index(const NotificationRecord& record) {
+	// replaced records keep their original position
+	auto& appKeys = this->byApp[record.appName];
+	appKeys.insert(std::ranges::lower_bound(appKeys, record.key), record.key);
+
+	auto text = record.appName % ' ' % record.summary % ' ' % record.body;
+	for (const auto& token: NotificationStore::tokenize(text)) {
+		this->terms[token].insert(record.key);
+	}
+}
+
+void NotificationStore::unindex(const NotificationRecord& record) {
+	auto app = this->byApp.find(record.appName);
+	if (app != this->byApp.end()) {
+		app->removeOne(record.key);
+		if (app->isEmpty()) this->byApp.erase(app);
+	}
+
+	auto text = record.appName % ' ' % record.summary % ' ' % record.body;
+	for (const auto& token: NotificationStore::tokenize(text)) {
+		auto term = this->terms.find(token);
+		if (term == this->terms.end()) continue;
+
+		term->remove(record.key);
+		if (term->isEmpty()) this->terms.erase(term);
+	}
+}
+
+void NotificationStore::replay() {
+	auto data = this->journal.readAll();
+
+	if (data.isEmpty()) {
+		this->journal.write(journalHeader());
+		this->journal.flush();
+		return;
+	}
+
+	auto buffer = QBuffer(&data);
+	buffer.open(QIODevice::ReadOnly);
+	auto stream = QDataStream(&buffer);
+	stream.setVersion(JOURNAL_STREAM_VERSION);
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	stream >> magic >> version;
+
+	if (magic != JOURNAL_MAGIC || version != JOURNAL_VERSION) {
+		qCWarning(logNotifications) << "Discarding notification history journal"
+		                            << this->journal.fileName() << "with unknown format.";
+		this->compact();
+		return;
+	}
+
+	auto validEnd = JOURNAL_HEADER_SIZE;
+
+	while (!stream.atEnd()) {
+		auto entry = QByteArray();
+		stream >> entry;
+		if (stream.status() != QDataStream::Ok) break;
+
+		auto entryStream = QDataStream(entry);
+		entryStream.setVersion(JOURNAL_STREAM_VERSION);
+		quint8 op = 0;
+		entryStream >> op;
+
+		switch (static_cast<Op>(op)) {
+		case Op::Insert: {
+			auto record = NotificationRecord();
+			entryStream >> record;
+			if (entryStream.status() == QDataStream::Ok) this->applyInsert(std::move(record));
+		} break;
+		case Op::Close: {
+			quint64 key = 0;
+			quint8 reason = 0;
+			entryStream >> key >> reason;
+			if (entryStream.status() == QDataStream::Ok) this->applyClose(key, reason);
+		} break;
+		case Op::Remove: {
+			quint64 key = 0;
+			entryStream >> key;
+			if (entryStream.status() == QDataStream::Ok) this->applyRemove(key);
+		} break;
+		default: break;
+		}
+
+		this->enforceLimit();
+		this->journalEntries++;
+		validEnd = buffer.pos();
+	}
+
+	// A crash mid-write leaves a partial entry at the end, which would corrupt later appends.
+	if (validEnd != data.size()) {
+		qCWarning(logNotifications) << "Dropping truncated entry at the end of notification history"
+		                            << "journal" << this->journal.fileName();
+		this->journal.resize(validEnd);
+	}
+
+	this->journal.seek(validEnd);
+}
+
+void NotificationStore::append(const QByteArray& entry) {
+	if (!this->journal.isOpen()) return;
+
+	auto data = QByteArray();
+	auto stream = QDataStream(&data, QIODevice::WriteOnly);
+	stream.setVersion(JOURNAL_STREAM_VERSION);
+	stream << entry;
+
+	this->journal.seek(this->journal.size());
+
+	if (this->journal.write(data) != data.size() || !this->journal.flush()) {
+		qCWarning(logNotifications) << "Failed to write notification history journal"
+		                            << this->journal.fileName() << this->journal.errorString();
+		return;
+	}
+
+	this->journalEntries++;
+}
+
+void NotificationStore::maybeCompact() {
+	if (this->journalEntries > this->records.size() * 2 + 64) this->compact();
+}
+
+void NotificationStore::compact() {
+	if (!this->journal.isOpen()) return;
+
+	auto path = this->journal.fileName();
+	auto file = QSaveFile(path);
+
+	if (!file.open(QIODevice::WriteOnly)) {
+		qCWarning(logNotifications) << "Could not compact notification history journal" << path
+		                            << file.errorString();
+		return;
+	}
+
+	auto stream = QDataStream(&file);
+	stream.setVersion(JOURNAL_STREAM_VERSION);
+	stream << JOURNAL_MAGIC << JOURNAL_VERSION;
+
+	for (const auto& record: this->records) {
+		auto entry = QByteArray();
+		auto entryStream = QDataStream(&entry, QIODevice::WriteOnly);
+		entryStream.setVersion(JOURNAL_STREAM_VERSION);
+		entryStream << static_cast<quint8>(Op::Insert) << record;
+		stream << entry;
+	}
+
+	if (!file.commit()) {
+		qCWarning(logNotifications) << "Could not compact notification history journal" << path
+		                            << file.errorString();
+		return;
+	}
+
+	// the old file handle points at the replaced inode
+	this->journal.close();
+	if (!this->journal.open(QIODevice::ReadWrite)) {
+		qCWarning(logNotifications) << "Could not reopen notification history journal" << path
+		                            << this->journal.errorString();
+		return;
+	}
+
+	this->journalEntries = this->records.size();
+}
+
+} // namespace qs::service::notifications
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qdatastream.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qmap.h>
+#include <qset.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtypes.h>
+
+namespace qs::service::notifications {
+
+// A notification as kept in history. Image data is deliberately not stored,
+// only references to images (icon names or file paths).
+struct NotificationRecord {
+	quint64 key = 0;
+	quint32 id = 0;
+	qint64 timestamp = 0;
+	QString appName;
+	QString appIcon;
+	QString summary;
+	QString body;
+	QString desktopEntry;
+	QString image;
+	quint8 urgency = 0;
+	quint8 closeReason = 0;
+};
+
+QDataStream& operator<<(QDataStream& stream, const NotificationRecord& record);
+QDataStream& operator>>(QDataStream& stream, NotificationRecord& record);
+
+// Bounded notification history backed by an append-only journal.
+//
+// Records are indexed by app name and by the words of their app name, summary and body.
+// The journal is replayed on open and rewritten once it holds mostly dead entries.
+class NotificationStore {
+public:
+	NotificationStore() = default;
+	~NotificationStore();
+	Q_DISABLE_COPY_MOVE(NotificationStore);
+
+	// Replays the journal at path, creating it if it does not exist.
+	// An empty path keeps the store in memory only.
+	bool open(const QString& path);
+	void close();
+	[[nodiscard]] bool isOpen() const { return this->journal.isOpen(); }
+
+	void setLimit(qsizetype limit);
+	[[nodiscard]] qsizetype limit() const { return this->mLimit; }
+
+	// Inserts a record, or replaces the record with the same key. A key of 0 assigns a new key.
+	quint64 insert(NotificationRecord record);
+	void setCloseReason(quint64 key, quint8 reason);
+	bool remove(quint64 key);
+	void clear();
+
+	[[nodiscard]] qsizetype count() const { return this->records.size(); }
+	[[nodiscard]] const NotificationRecord* record(quint64 key) const;
+	[[nodiscard]] quint32 maxId() const { return this->mMaxId; }
+
+	// All query results are ordered newest first.
+	[[nodiscard]] QList<quint64> keys(qsizetype offset, qsizetype count) const;
+	[[nodiscard]] QList<quint64> keysForApp(const QString& appName, qsizetype count) const;
+	[[nodiscard]] QList<QString> apps() const;
+	// Matches records containing every word of the query, with the last word matched as a prefix.
+	[[nodiscard]] QList<quint64> search(const QString& query, qsizetype count) const;
+
+	static QList<QString> tokenize(const QString& text);
+
+private:
+	enum class Op : quint8 {
+		Insert = 1,
+		Close = 2,
+		Remove = 3,
+	};
+
+	void applyInsert(NotificationRecord record);
+	void applyClose(quint64 key, quint8 reason);
+	bool applyRemove(quint64 key);
+	void applyClear();
+	void enforceLimit();
+
+	void index(const NotificationRecord& record);
+	void unindex(const NotificationRecord& record);
+
+	void replay();
+	void append(const QByteArray& entry);
+	void maybeCompact();
+	void compact();
+
+	QFile journal;
+	qsizetype journalEntries = 0;
+	qsizetype mLimit = 1000;
+	quint64 nextKey = 1;
+	quint32 mMaxId = 0;
+
+	QMap<quint64, NotificationRecord> records;
+	QHash<QString, QList<quint64>> byApp;
+	// ordered so prefix matches are a range scan
+	QMap<QString, QSet<quint64>> terms;
+};
+
+} // namespace qs::service::notifications
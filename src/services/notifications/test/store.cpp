@@ -0,0 +1,189 @@
+#include "store.hpp"
+
+#include <qcontainerfwd.h>
+#include <qfile.h>
+#include <qiodevice.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qstring.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../../../core/logcat.hpp"
+#include "../store.hpp"
+
+namespace qs::service::notifications {
+// Defined in server.cpp in the shell.
+// NOLINTNEXTLINE(misc-use-internal-linkage)
+QS_LOGGING_CATEGORY(logNotifications, "quickshell.service.notifications", QtWarningMsg);
+} // namespace qs::service::notifications
+
+using namespace qs::service::notifications;
+
+namespace {
+
+NotificationRecord
+notification(quint32 id, const QString& appName, const QString& summary, const QString& body = {}) {
+	return {.id = id, .appName = appName, .summary = summary, .body = body};
+}
+
+} // namespace
+
+void TestNotificationStore::queriesNewestFirst() {
+	auto store = NotificationStore();
+	QVERIFY(store.open(QString()));
+
+	auto first = store.insert(notification(1, "mail", "New message"));
+	auto second = store.insert(notification(2, "chat", "Ping"));
+	auto third = store.insert(notification(3, "mail", "Another message"));
+
+	QCOMPARE(store.count(), 3);
+	QCOMPARE(store.maxId(), 3);
+	QCOMPARE(store.keys(0, 10), QList<quint64>({third, second, first}));
+	QCOMPARE(store.keys(1, 1), QList<quint64>({second}));
+	QCOMPARE(store.keysForApp("mail", 10), QList<quint64>({third, first}));
+	QCOMPARE(store.apps(), QList<QString>({"chat", "mail"}));
+
+	QVERIFY(store.remove(second));
+	QVERIFY(!store.remove(second));
+	QCOMPARE(store.apps(), QList<QString>({"mail"}));
+
+	store.setLimit(1);
+	QCOMPARE(store.keys(0, 10), QList<quint64>({third}));
+}
+
+void TestNotificationStore::searchesByPrefix() {
+	auto store = NotificationStore();
+	QVERIFY(store.open(QString()));
+
+	auto build = store.insert(notification(1, "ci", "Build failed", "pipeline main"));
+	auto deploy = store.insert(notification(2, "ci", "Deploy finished", "pipeline release"));
+
+	QCOMPARE(store.search("pipe", 10), QList<quint64>({deploy, build}));
+	QCOMPARE(store.search("pipeline rel", 10), QList<quint64>({deploy}));
+	QCOMPARE(store.search("FAILED", 10), QList<quint64>({build}));
+	QCOMPARE(store.search("failed pipeline", 10), QList<quint64>({build}));
+	QVERIFY(store.search("deploy main", 10).isEmpty());
+
+	// replaced records are reindexed
+	auto replaced = notification(3, "ci", "Build fixed");
+	replaced.key = build;
+	store.insert(replaced);
+	QVERIFY(store.search("failed", 10).isEmpty());
+	QCOMPARE(store.search("fix", 10), QList<quint64>({build}));
+}
+
+void TestNotificationStore::replaysJournal() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("history/journal");
+
+	quint64 kept = 0;
+	quint64 closed = 0;
+
+	{
+		auto store = NotificationStore();
+		QVERIFY(store.open(path));
+
+		kept = store.insert(notification(4, "mail", "Kept"));
+		closed = store.insert(notification(7, "chat", "Closed"));
+		auto removed = store.insert(notification(9, "chat", "Removed"));
+
+		store.setCloseReason(closed, 2);
+		store.remove(removed);
+	}
+
+	auto store = NotificationStore();
+	QVERIFY(store.open(path));
+
+	QCOMPARE(store.keys(0, 10), QList<quint64>({closed, kept}));
+	QCOMPARE(store.record(kept)->summary, "Kept");
+	QCOMPARE(store.record(closed)->closeReason, 2);
+	QCOMPARE(store.maxId(), 9);
+
+	// keys of removed records are not reused
+	QVERIFY(store.insert(notification(10, "mail", "New")) > closed + 1);
+}
+
+void TestNotificationStore::repairsTruncatedTail() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("journal");
+
+	{
+		auto store = NotificationStore();
+		QVERIFY(store.open(path));
+		store.insert(notification(1, "mail", "Complete"));
+		store.insert(notification(2, "mail", "Partially written"));
+	}
+
+	{
+		auto file = QFile(path);
+		QVERIFY(file.open(QIODevice::ReadWrite));
+		QVERIFY(file.resize(file.size() - 5));
+	}
+
+	{
+		auto store = NotificationStore();
+		QVERIFY(store.open(path));
+		QCOMPARE(store.count(), 1);
+		QCOMPARE(store.record(store.keys(0, 1).first())->summary, "Complete");
+
+		// appends after the repair must not be hidden behind the partial entry
+		store.insert(notification(3, "mail", "After repair"));
+	}
+
+	auto store = NotificationStore();
+	QVERIFY(store.open(path));
+	QCOMPARE(store.count(), 2);
+	QCOMPARE(store.record(store.keys(0, 1).first())->summary, "After repair");
+}
+
+void TestNotificationStore::compactsJournal() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("journal");
+
+	{
+		auto store = NotificationStore();
+		QVERIFY(store.open(path));
+		store.setLimit(5);
+
+		for (auto i = 1; i != 501; i++) {
+			store.insert(notification(i, "spam", QString("Message %1").arg(i)));
+		}
+	}
+
+	// 500 insert entries take around 50KiB without compaction
+	QVERIFY(QFile(path).size() < 16 * 1024);
+
+	auto store = NotificationStore();
+	QVERIFY(store.open(path));
+	store.setLimit(5);
+
+	QCOMPARE(store.count(), 5);
+	QCOMPARE(store.record(store.keys(0, 1).first())->summary, "Message 500");
+	QCOMPARE(store.maxId(), 500);
+}
+
+void TestNotificationStore::discardsUnknownFormat() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("journal");
+
+	{
+		auto file = QFile(path);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		file.write("not a notification journal");
+	}
+
+	auto store = NotificationStore();
+	QVERIFY(store.open(path));
+	QCOMPARE(store.count(), 0);
+
+	store.insert(notification(1, "mail", "Fresh"));
+	store.close();
+
+	QVERIFY(store.open(path));
+	QCOMPARE(store.count(), 1);
+}
+
+QTEST_MAIN(TestNotificationStore);
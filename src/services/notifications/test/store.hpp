@@ -0,0 +1,16 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestNotificationStore: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void queriesNewestFirst();
+	static void searchesByPrefix();
+	static void replaysJournal();
+	static void repairsTruncatedTail();
+	static void compactsJournal();
+	static void discardsUnknownFormat();
+};
@@ -1,5 +1,6 @@
 #include "conversation.hpp"
 
+#include <qelapsedtimer.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
@@ -13,10 +14,15 @@
 #endif
 
 #include "../../core/logcat.hpp"
+#include "helper.hpp"
 #include "ipc.hpp"
 
 QS_LOGGING_CATEGORY(logPam, "quickshell.service.pam", QtWarningMsg);
 
+namespace {
+QS_LOGGING_CATEGORY(logPamTiming, "quickshell.service.pam.timing", QtWarningMsg);
+}
+
 QString PamError::toString(PamError::Enum value) {
 	switch (value) {
 	case StartFailed: return "Failed to start the PAM session";
@@ -39,13 +45,29 @@ QString PamResult::toString(PamResult::Enum value) {
 PamConversation::~PamConversation() { this->abort(); }
 
 void PamConversation::start(const QString& configDir, const QString& config, const QString& user) {
-	this->childPid = PamConversation::createSubprocess(&this->pipes, configDir, config, user);
+	this->startElapsed.start();
+
+	if (auto* helper = PamHelper::instance()) {
+		this->childPid = helper->spawn(&this->pipes, configDir, config, user);
+		this->ownsChild = false;
+	}
+
 	if (this->childPid == 0) {
+		this->childPid = PamConversation::createSubprocess(&this->pipes, configDir, config, user);
+		this->ownsChild = true;
+	}
+
+	if (this->childPid <= 0) {
+		this->childPid = 0;
 		qCCritical(logPam) << "Failed to create pam subprocess.";
 		emit this->error(PamError::InternalError);
 		return;
 	}
 
+	qCDebug(logPamTiming).nospace() << "Started subprocess for " << this << " in "
+	                                << this->startElapsed.nsecsElapsed() / 1000 << "us"
+	                                << (this->ownsChild ? " by forking" : " from the pam helper");
+
 	QObject::connect(&this->notifier, &QSocketNotifier::activated, this, &PamConversation::onMessage);
 	this->notifier.setSocket(this->pipes.fdIn);
 	this->notifier.setEnabled(true);
@@ -53,23 +75,35 @@ void PamConversation::start(const QString& configDir, const QString& config, con
 
 void PamConversation::abort() {
 	if (this->childPid != 0) {
-		qCDebug(logPam) << "Killing subprocess for" << this;
-		kill(this->childPid, SIGKILL); // NOLINT (include)
-		waitpid(this->childPid, nullptr, 0);
-		this->childPid = 0;
+		this->killChild();
 	}
 }
 
 void PamConversation::internalError() {
 	if (this->childPid != 0) {
-		qCDebug(logPam) << "Killing subprocess for" << this;
-		kill(this->childPid, SIGKILL); // NOLINT (include)
-		waitpid(this->childPid, nullptr, 0);
-		this->childPid = 0;
+		this->killChild();
 		emit this->error(PamError::InternalError);
 	}
 }
 
+void PamConversation::killChild() {
+	qCDebug(logPam) << "Killing subprocess for" << this;
+
+	if (this->ownsChild) {
+		kill(this->childPid, SIGKILL); // NOLINT (include)
+	} else if (auto* helper = PamHelper::instance()) {
+		// the helper may have reaped the subprocess already, so only it can signal it safely
+		helper->killSubprocess(this->childPid);
+	}
+
+	this->reapChild();
+}
+
+void PamConversation::reapChild() {
+	if (this->ownsChild) waitpid(this->childPid, nullptr, 0);
+	this->childPid = 0;
+}
+
 void PamConversation::respond(const QString& response) {
 	qCDebug(logPam) << "Sending response for" << this;
 	if (!this->pipes.writeString(response.toStdString())) {
@@ -82,6 +116,12 @@ void PamConversation::onMessage() {
 	{
 		qCDebug(logPam) << "Got message from subprocess.";
 
+		if (this->startElapsed.isValid()) {
+			qCDebug(logPamTiming).nospace() << "First message from subprocess for " << this << " after "
+			                                << this->startElapsed.elapsed() << "ms";
+			this->startElapsed.invalidate();
+		}
+
 		auto type = PamIpcEvent::Exit;
 
 		auto ok = this->pipes.readBytes(reinterpret_cast<char*>(&type), sizeof(PamIpcEvent));
@@ -106,8 +146,7 @@ void PamConversation::onMessage() {
 			case PamIpcExitCode::OtherError: emit this->error(PamError::InternalError); break;
 			}
 
-			waitpid(this->childPid, nullptr, 0);
-			this->childPid = 0;
+			this->reapChild();
 		} else if (type == PamIpcEvent::Request) {
 			PamIpcRequestFlags flags {};
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <qelapsedtimer.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
@@ -93,8 +94,13 @@ private:
 	);
 
 	void internalError();
+	void killChild();
+	void reapChild();
 
 	pid_t childPid = 0;
+	// Subprocesses started by the PamHelper are reaped by the helper instead.
+	bool ownsChild = true;
+	QElapsedTimer startElapsed;
 	PamIpcPipes pipes;
 	QSocketNotifier notifier {QSocketNotifier::Read};
 };
@@ -0,0 +1,337 @@
+#include "helper.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qstring.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "conversation.hpp"
+#include "ipc.hpp"
+#include "subprocess.hpp"
+
+namespace {
+
+// Large enough for any reasonable config directory, config name and user.
+constexpr size_t MAX_REQUEST_SIZE = 16384;
+constexpr int HELPER_FD = 3;
+
+PamHelper* helperInstance = nullptr; // NOLINT
+
+// The first byte of every request.
+enum class RequestType : char {
+	// Followed by the log flag and the nul terminated config dir, config and user,
+	// with both subprocess pipe ends attached. Answered with the subprocess pid.
+	Spawn = 0,
+	// Followed by the pid of a subprocess to kill. Not answered.
+	Kill = 1,
+};
+
+bool sendRequest(int fd, const std::string& request, std::array<int, 2> fds) {
+	auto iov = iovec {
+	    .iov_base = const_cast<char*>(request.data()), // NOLINT
+	    .iov_len = request.size(),
+	};
+
+	alignas(cmsghdr) auto control = std::array<char, CMSG_SPACE(sizeof(int) * 2)>();
+
+	auto message = msghdr {};
+	message.msg_iov = &iov;
+	message.msg_iovlen = 1;
+	message.msg_control = control.data();
+	message.msg_controllen = control.size();
+
+	auto* cmsg = CMSG_FIRSTHDR(&message);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int) * 2);
+	memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * 2);
+
+	ssize_t result = 0;
+	do {
+		result = sendmsg(fd, &message, MSG_NOSIGNAL);
+	} while (result == -1 && errno == EINTR);
+
+	return result == static_cast<ssize_t>(request.size());
+}
+
+// Returns the request length, 0 if the shell has exited, -1 if the request was truncated,
+// -2 if the socket failed or -3 if a signal was received first.
+ssize_t
+receiveRequest(int fd, std::array<char, MAX_REQUEST_SIZE>& buffer, std::array<int, 2>* fds) {
+	auto iov = iovec {.iov_base = buffer.data(), .iov_len = buffer.size()};
+	alignas(cmsghdr) auto control = std::array<char, CMSG_SPACE(sizeof(int) * 2)>();
+
+	auto message = msghdr {};
+	message.msg_iov = &iov;
+	message.msg_iovlen = 1;
+	message.msg_control = control.data();
+	message.msg_controllen = control.size();
+
+	auto length = recvmsg(fd, &message, 0);
+	if (length == -1 && errno == EINTR) return -3;
+	if (length <= 0) return length == 0 ? 0 : -2;
+
+	auto received = 0;
+	for (auto* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+		if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+
+		auto count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+		for (size_t i = 0; i != count; i++) {
+			int receivedFd = -1;
+			memcpy(&receivedFd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int)); // NOLINT
+
+			if (received < 2) (*fds)[received++] = receivedFd; // NOLINT
+			else close(receivedFd);
+		}
+	}
+
+	if ((message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0) return -1;
+	return length;
+}
+
+// The helper is forked after the platform connection and other shell fds have been opened,
+// none of which it should keep alive.
+void closeInheritedFds(int from) {
+#ifdef __FreeBSD__
+	closefrom(from);
+#else
+#ifdef SYS_close_range
+	if (syscall(SYS_close_range, from, ~0U, 0) == 0) return;
+#endif
+	auto max = sysconf(_SC_OPEN_MAX);
+	for (auto fd = from; fd < max; fd++) {
+		close(fd);
+	}
+#endif
+}
+
+} // namespace
+
+PamHelper::~PamHelper() {
+	if (this->fd != -1) {
+		// The helper exits once its socket is closed.
+		close(this->fd);
+		waitpid(this->pid, nullptr, 0);
+	}
+}
+
+void PamHelper::init() {
+	if (helperInstance != nullptr || qEnvironmentVariableIntValue("QS_PAM_HELPER") != 1) return;
+
+	auto fds = std::array<int, 2>();
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds.data()) == -1) {
+		qCWarning(logPam) << "Failed to create pam helper socket:" << qt_error_string();
+		return;
+	}
+
+	auto pid = fork();
+
+	if (pid < 0) {
+		qCWarning(logPam) << "Failed to fork pam helper:" << qt_error_string();
+		close(fds[0]);
+		close(fds[1]);
+		return;
+	} else if (pid == 0) {
+		close(fds[0]);
+		PamHelper::run(fds[1]);
+	}
+
+	close(fds[1]);
+	helperInstance = new PamHelper(pid, fds[0]);
+	qCDebug(logPam) << "Started pam helper with pid" << pid;
+}
+
+PamHelper* PamHelper::instance() {
+	return helperInstance != nullptr && helperInstance->fd != -1 ? helperInstance : nullptr;
+}
+
+pid_t PamHelper::spawn(
+    PamIpcPipes* pipes,
+    const QString& configDir,
+    const QString& config,
+    const QString& user
+) {
+	auto toSubprocess = std::array<int, 2>();
+	auto fromSubprocess = std::array<int, 2>();
+
+	if (pipe(toSubprocess.data()) == -1) {
+		qCDebug(logPam) << "Failed to create pipes for subprocess.";
+		return 0;
+	}
+
+	if (pipe(fromSubprocess.data()) == -1) {
+		qCDebug(logPam) << "Failed to create pipes for subprocess.";
+		close(toSubprocess[0]);
+		close(toSubprocess[1]);
+		return 0;
+	}
+
+	auto request = std::string {
+	    static_cast<char>(RequestType::Spawn),
+	    static_cast<char>(logPam().isDebugEnabled()),
+	};
+
+	for (const auto* arg: {&configDir, &config, &user}) {
+		request += arg->toStdString();
+		request.push_back('\0');
+	}
+
+	auto sent = sendRequest(this->fd, request, {toSubprocess[0], fromSubprocess[1]});
+
+	// the helper has its own copies of the subprocess ends now
+	close(toSubprocess[0]);
+	close(fromSubprocess[1]);
+
+	pid_t pid = -1;
+	ssize_t received = 0;
+
+	if (sent) {
+		do {
+			received = recv(this->fd, &pid, sizeof(pid_t), 0);
+		} while (received == -1 && errno == EINTR);
+	}
+
+	auto connected = received == static_cast<ssize_t>(sizeof(pid_t));
+
+	if (!connected) {
+		qCWarning(logPam) << "Lost connection to pam helper, falling back to forking the shell.";
+		close(this->fd);
+		this->fd = -1;
+		waitpid(this->pid, nullptr, 0);
+	}
+
+	if (!connected || pid <= 0) {
+		close(toSubprocess[1]);
+		close(fromSubprocess[0]);
+		return 0;
+	}
+
+	pipes->fdIn = fromSubprocess[0];
+	pipes->fdOut = toSubprocess[1];
+	return pid;
+}
+
+void PamHelper::killSubprocess(pid_t pid) {
+	auto request = std::string(1, static_cast<char>(RequestType::Kill));
+	request.append(reinterpret_cast<const char*>(&pid), sizeof(pid_t)); // NOLINT
+
+	ssize_t sent = 0;
+	do {
+		sent = send(this->fd, request.data(), request.size(), MSG_NOSIGNAL);
+	} while (sent == -1 && errno == EINTR);
+
+	if (sent != static_cast<ssize_t>(request.size())) {
+		qCWarning(logPam) << "Failed to ask pam helper to kill subprocess" << pid;
+	}
+}
+
+void PamHelper::run(int fd) {
+	if (fd != HELPER_FD) {
+		dup2(fd, HELPER_FD);
+		close(fd);
+	}
+
+	closeInheritedFds(HELPER_FD + 1);
+
+	// Subprocesses are reaped here rather than ignoring SIGCHLD so their pids stay reserved
+	// until the helper has waited on them, which makes kill requests for subprocesses that
+	// already exited harmless. The handler only exists to interrupt recvmsg.
+	// The shell only learns about their exit through the exit code sent over the pipes.
+	struct sigaction action {};
+	action.sa_handler = [](int) {};
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGCHLD, &action, nullptr);
+
+	auto children = std::vector<pid_t>();
+	auto buffer = std::array<char, MAX_REQUEST_SIZE>();
+
+	while (true) {
+		pid_t exited = 0;
+		while ((exited = waitpid(-1, nullptr, WNOHANG)) > 0) {
+			std::erase(children, exited);
+		}
+
+		auto fds = std::array<int, 2> {-1, -1};
+		auto length = receiveRequest(HELPER_FD, buffer, &fds);
+
+		if (length == 0) _exit(0);
+		if (length == -2) _exit(1);
+		if (length == -3) continue;
+
+		auto type = static_cast<RequestType>(buffer[0]);
+
+		if (type == RequestType::Kill && length == static_cast<ssize_t>(1 + sizeof(pid_t))) {
+			pid_t pid = 0;
+			memcpy(&pid, &buffer[1], sizeof(pid_t)); // NOLINT
+
+			// pids are only released once reaped above, so this can't hit an unrelated process
+			if (std::ranges::find(children, pid) != children.end()) kill(pid, SIGKILL);
+
+			if (fds[0] != -1) close(fds[0]);
+			if (fds[1] != -1) close(fds[1]);
+			continue;
+		}
+
+		// request layout: type, log flag, then nul terminated config dir, config and user
+		auto args = std::array<const char*, 3>();
+		size_t argCount = 0;
+
+		if (type == RequestType::Spawn && length > 1 && fds[0] != -1 && fds[1] != -1) {
+			ssize_t start = 2;
+			for (ssize_t i = 2; i < length && argCount != args.size(); i++) {
+				if (buffer[i] != '\0') continue;   // NOLINT
+				args[argCount++] = &buffer[start]; // NOLINT
+				start = i + 1;
+			}
+		}
+
+		pid_t pid = -1;
+
+		if (argCount == args.size()) {
+			pid = fork();
+
+			if (pid == 0) {
+				close(HELPER_FD);
+				// pam modules may wait on their own children
+				signal(SIGCHLD, SIG_DFL); // NOLINT
+
+				{
+					auto subprocess = PamSubprocess(buffer[1] != 0, fds[0], fds[1]);
+					auto code = subprocess.exec(args[0], args[1], args[2]);
+					subprocess.sendCode(code);
+				}
+
+				_exit(0);
+			} else if (pid > 0) {
+				children.push_back(pid);
+			} else {
+				logIf(true) << "pam helper failed to fork subprocess: " << strerror(errno) << std::endl;
+				pid = -1;
+			}
+		} else {
+			logIf(true) << "pam helper received an invalid request" << std::endl;
+		}
+
+		if (fds[0] != -1) close(fds[0]);
+		if (fds[1] != -1) close(fds[1]);
+
+		if (send(HELPER_FD, &pid, sizeof(pid_t), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(pid_t))) {
+			_exit(1);
+		}
+	}
+}
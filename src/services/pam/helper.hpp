@@ -0,0 +1,41 @@
+#pragma once
+
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <sys/types.h>
+
+#include "ipc.hpp"
+
+// A small process forked from quickshell before the QML engine is started, which forks pam
+// subprocesses on request. Forking the helper is much cheaper than forking the full shell
+// once it has loaded a config, which keeps the time between starting a conversation and
+// the first pam message low on large shells.
+//
+// Requests carry the pam arguments and both ends of the subprocess's PamIpcPipes, which are
+// passed over a unix socket. The helper reaps its own children, so they must not be waited on
+// or signalled directly, as their pids may already have been reused.
+class PamHelper {
+public:
+	~PamHelper();
+	Q_DISABLE_COPY_MOVE(PamHelper);
+
+	// Forks the helper if QS_PAM_HELPER=1 is set. Must be called before any QML is loaded.
+	static void init();
+	// Returns the running helper, or nullptr if it was not started or has exited.
+	static PamHelper* instance();
+
+	// Starts a pam subprocess connected to the given pipes, returning its pid, or 0 on failure.
+	pid_t
+	spawn(PamIpcPipes* pipes, const QString& configDir, const QString& config, const QString& user);
+
+	// Asks the helper to SIGKILL a subprocess returned by spawn, if it has not exited yet.
+	void killSubprocess(pid_t pid);
+
+private:
+	explicit PamHelper(pid_t pid, int fd): pid(pid), fd(fd) {}
+
+	[[noreturn]] static void run(int fd);
+
+	pid_t pid;
+	int fd;
+};
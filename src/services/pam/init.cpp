@@ -0,0 +1,15 @@
+#include "../../core/plugin.hpp"
+#include "helper.hpp"
+
+namespace {
+
+class PamPlugin: public QsEnginePlugin {
+	QString name() override { return "pam"; }
+
+	// Forked before the QML engine starts so the helper stays small.
+	void init() override { PamHelper::init(); }
+};
+
+QS_REGISTER_PLUGIN(PamPlugin);
+
+} // namespace
@@ -17,6 +17,11 @@
 
 ///! Connection to pam.
 /// Connection to pam. See [the module documentation](../) for pam configuration advice.
+///
+/// Each authentication runs pam in a subprocess forked from quickshell. On shells using a lot
+/// of memory, setting `QS_PAM_HELPER=1` (for example with `//@ pragma Env QS_PAM_HELPER = 1`)
+/// makes quickshell fork a small helper process at startup which subprocesses are forked from
+/// instead, reducing the delay before pam sends its first message.
 class PamContext
     : public QObject
     , public QQmlParserStatus {
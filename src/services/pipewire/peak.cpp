@@ -26,6 +26,7 @@
 #include <spa/pod/pod.h>
 
 #include "../../core/logcat.hpp"
+#include "../../core/powerstate.hpp"
 #include "connection.hpp"
 #include "core.hpp"
 #include "node.hpp"
@@ -299,7 +300,14 @@ void PwPeakStream::handleProcess() {
 	this->monitor->updatePeaks(this->channelPeaks, maxPeak);
 }
 
-PwNodePeakMonitor::PwNodePeakMonitor(QObject* parent): QObject(parent) {}
+PwNodePeakMonitor::PwNodePeakMonitor(QObject* parent): QObject(parent) {
+	QObject::connect(
+	    PowerState::instance(),
+	    &PowerState::liveContentPausedChanged,
+	    this,
+	    &PwNodePeakMonitor::rebuildStream
+	);
+}
 
 PwNodePeakMonitor::~PwNodePeakMonitor() {
 	delete this->mStream;
@@ -381,7 +389,7 @@ void PwNodePeakMonitor::rebuildStream() {
 	this->mStream = nullptr;
 
 	auto* node = this->mNodeRef.object();
-	if (!this->mEnabled || node == nullptr) {
+	if (!this->mEnabled || node == nullptr || PowerState::instance()->liveContentPaused()) {
 		this->clearPeaks();
 		return;
 	}
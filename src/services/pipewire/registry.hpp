@@ -13,6 +13,7 @@
 #include <qtypes.h>
 
 #include "../../core/logcat.hpp"
+#include "../../core/memorystats.hpp"
 #include "../../core/util.hpp"
 #include "core.hpp"
 
@@ -61,6 +62,9 @@ protected:
 	quint32 refcount = 0;
 	pw_proxy* object = nullptr;
 	PwRegistry* registry = nullptr;
+
+private:
+	LiveObjectCount<"PwBindableObject"> liveCount;
 };
 
 QDebug operator<<(QDebug debug, const PwBindableObject* object);
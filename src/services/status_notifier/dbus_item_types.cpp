@@ -3,14 +3,16 @@
 #include <qdbusargument.h>
 #include <qdebug.h>
 #include <qendian.h>
+#include <qhashfunctions.h>
 #include <qimage.h>
 #include <qlogging.h>
 #include <qmetatype.h>
-#include <qsysinfo.h>
 #include <qtypes.h>
 
 bool DBusSniIconPixmap::operator==(const DBusSniIconPixmap& other) const {
-	return this->width == other.width && this->height == other.height && this->data == other.data;
+	if (this->width != other.width || this->height != other.height) return false;
+	if (this->hashed && other.hashed && this->hash != other.hash) return false;
+	return this->data == other.data;
 }
 
 bool DBusSniTooltip::operator==(const DBusSniTooltip& other) const {
@@ -19,31 +21,36 @@ bool DBusSniTooltip::operator==(const DBusSniTooltip& other) const {
 }
 
 QImage DBusSniIconPixmap::createImage() const {
-	// fix byte order if on a little endian machine
-	if (QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
-		auto* newbuf = new quint32[this->data.size()];
-		const auto* oldbuf = reinterpret_cast<const quint32*>(this->data.constData());
-
-		for (uint i = 0; i < this->data.size() / sizeof(quint32); ++i) {
-			newbuf[i] = qFromBigEndian(oldbuf[i]); // NOLINT
-		}
-
-		return QImage(
-		    reinterpret_cast<const uchar*>(newbuf),
-		    this->width,
-		    this->height,
-		    QImage::Format_ARGB32,
-		    [](void* ptr) { delete[] reinterpret_cast<quint32*>(ptr); },
-		    newbuf
-		);
-	} else {
-		return QImage(
-		    reinterpret_cast<const uchar*>(this->data.constData()),
-		    this->width,
-		    this->height,
-		    QImage::Format_ARGB32
-		);
+	if (!this->image.isNull()) return this->image;
+
+	if (this->width <= 0 || this->height <= 0
+	    || this->data.size() < static_cast<qsizetype>(this->width) * this->height * 4)
+	{
+		return QImage();
+	}
+
+	auto image = QImage(this->width, this->height, QImage::Format_ARGB32);
+
+	// Pixels are sent as network byte order ARGB. qFromBigEndian over a whole
+	// buffer is vectorized by Qt, and is a plain copy on big endian machines.
+	// QImage scanlines for ARGB32 are always packed, so this can be done in one pass.
+	qFromBigEndian<quint32>(
+	    this->data.constData(),
+	    static_cast<qsizetype>(this->width) * this->height,
+	    image.bits()
+	);
+
+	this->image = image;
+	return image;
+}
+
+size_t DBusSniIconPixmap::contentHash() const {
+	if (!this->hashed) {
+		this->hash = qHashMulti(0, this->width, this->height, this->data);
+		this->hashed = true;
 	}
+
+	return this->hash;
 }
 
 const QDBusArgument& operator>>(const QDBusArgument& argument, DBusSniIconPixmap& pixmap) {
@@ -52,6 +59,8 @@ const QDBusArgument& operator>>(const QDBusArgument& argument, DBusSniIconPixmap
 	argument >> pixmap.height;
 	argument >> pixmap.data;
 	argument.endStructure();
+	pixmap.image = QImage();
+	pixmap.hashed = false;
 	return argument;
 }
 
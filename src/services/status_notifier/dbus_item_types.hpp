@@ -2,6 +2,7 @@
 
 #include <qdbusargument.h>
 #include <qdebug.h>
+#include <qimage.h>
 #include <qlist.h>
 
 struct DBusSniIconPixmap {
@@ -9,10 +10,18 @@ struct DBusSniIconPixmap {
 	qint32 height = 0;
 	QByteArray data;
 
-	// valid only for the lifetime of the pixmap
+	// Decoded once and shared with copies of the pixmap made after decoding.
 	[[nodiscard]] QImage createImage() const;
+	[[nodiscard]] size_t contentHash() const;
 
 	bool operator==(const DBusSniIconPixmap& other) const;
+
+private:
+	mutable QImage image;
+	mutable size_t hash = 0;
+	mutable bool hashed = false;
+
+	friend const QDBusArgument& operator>>(const QDBusArgument& argument, DBusSniIconPixmap& pixmap);
 };
 
 using DBusSniIconPixmapList = QList<DBusSniIconPixmap>;
@@ -1,12 +1,15 @@
 #include "host.hpp"
 
 #include <qcontainerfwd.h>
+#include <qcoreevent.h>
 #include <qdbusconnection.h>
 #include <qdbuserror.h>
 #include <qdbusservicewatcher.h>
+#include <qguiapplication.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qnamespace.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
 #include <unistd.h>
@@ -25,6 +28,10 @@ namespace qs::service::sni {
 StatusNotifierHost::StatusNotifierHost(QObject* parent): QObject(parent) {
 	StatusNotifierWatcher::instance(); // ensure at least one watcher exists
 
+	// ThemeChange is delivered to each window rather than the application, so it is
+	// picked up with an application wide filter.
+	QGuiApplication::instance()->installEventFilter(this);
+
 	auto bus = QDBusConnection::sessionBus();
 
 	if (!bus.isConnected()) {
@@ -184,6 +191,25 @@ void StatusNotifierHost::onItemReady() {
 	}
 }
 
+bool StatusNotifierHost::eventFilter(QObject* /*watched*/, QEvent* event) {
+	// Every window receives its own copy of the event, so coalesce them into one reload.
+	if (event->type() == QEvent::ThemeChange && !this->themeChangePending) {
+		this->themeChangePending = true;
+		QMetaObject::invokeMethod(this, &StatusNotifierHost::onThemeChanged, Qt::QueuedConnection);
+	}
+
+	return false;
+}
+
+void StatusNotifierHost::onThemeChanged() {
+	this->themeChangePending = false;
+	qCDebug(logStatusNotifierHost) << "Icon theme changed, dropping cached tray pixmaps";
+
+	for (auto* item: this->mItems) {
+		item->invalidatePixmaps();
+	}
+}
+
 StatusNotifierHost* StatusNotifierHost::instance() {
 	static StatusNotifierHost* instance = nullptr; // NOLINT
 	if (instance == nullptr) instance = new StatusNotifierHost();
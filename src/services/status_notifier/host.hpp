@@ -1,6 +1,7 @@
 #pragma once
 
 #include <qcontainerfwd.h>
+#include <qcoreevent.h>
 #include <qdbusservicewatcher.h>
 #include <qhash.h>
 #include <qlist.h>
@@ -28,6 +29,8 @@ public:
 
 	static StatusNotifierHost* instance();
 
+	bool eventFilter(QObject* watched, QEvent* event) override;
+
 signals:
 	void itemRegistered(StatusNotifierItem* item);
 	void itemReady(StatusNotifierItem* item);
@@ -39,12 +42,14 @@ private slots:
 	void onItemRegistered(const QString& item);
 	void onItemUnregistered(const QString& item);
 	void onItemReady();
+	void onThemeChanged();
 
 private:
 	QString hostId;
 	QDBusServiceWatcher serviceWatcher;
 	DBusStatusNotifierWatcher* watcher = nullptr;
 	QHash<QString, StatusNotifierItem*> mItems;
+	bool themeChangePending = false;
 };
 
 } // namespace qs::service::sni
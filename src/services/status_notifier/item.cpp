@@ -5,9 +5,11 @@
 #include <qdbusmetatype.h>
 #include <qdbuspendingcall.h>
 #include <qdbuspendingreply.h>
+#include <qhashfunctions.h>
 #include <qicon.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qminmax.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qpainter.h>
@@ -132,7 +134,26 @@ bool StatusNotifierItem::isReady() const { return this->mReady; }
 
 QPixmap StatusNotifierItem::createPixmap(const QSize& size) const {
 	auto needsAttention = this->bStatus.value() == Status::NeedsAttention;
+	auto key = TrayPixmapCacheKey {this->iconContentHash, size, needsAttention};
 
+	if (auto* pixmap = this->pixmapCache.object(key)) return *pixmap;
+
+	auto pixmap = this->renderPixmap(size, needsAttention);
+
+	if (!pixmap.isNull()) {
+		auto cost = qMax(1, pixmap.width() * pixmap.height() * 4 / 1024);
+		this->pixmapCache.insert(key, new QPixmap(pixmap), cost);
+	}
+
+	return pixmap;
+}
+
+void StatusNotifierItem::invalidatePixmaps() {
+	this->pixmapCache.clear();
+	this->pixmapIndex = this->pixmapIndex + 1;
+}
+
+QPixmap StatusNotifierItem::renderPixmap(const QSize& size, bool needsAttention) const {
 	auto closestPixmap = [](const QSize& size, const DBusSniIconPixmapList& pixmaps) {
 		const DBusSniIconPixmap* ret = nullptr;
 
@@ -267,7 +288,35 @@ void StatusNotifierItem::scroll(qint32 delta, bool horizontal) const {
 	this->item->Scroll(delta, horizontal ? "horizontal" : "vertical");
 }
 
-void StatusNotifierItem::updatePixmapIndex() { this->pixmapIndex = this->pixmapIndex + 1; }
+size_t StatusNotifierItem::computeIconContentHash() const {
+	auto hash = qHashMulti(
+	    0,
+	    this->bIconThemePath.value(),
+	    this->bIconName.value(),
+	    this->bOverlayIconName.value(),
+	    this->bAttentionIconName.value()
+	);
+
+	auto hashPixmaps = [&hash](const DBusSniIconPixmapList& pixmaps) {
+		hash = qHashMulti(hash, pixmaps.length());
+		for (const auto& pixmap: pixmaps) hash = qHashMulti(hash, pixmap.contentHash());
+	};
+
+	hashPixmaps(this->bIconPixmaps.value());
+	hashPixmaps(this->bOverlayIconPixmaps.value());
+	hashPixmaps(this->bAttentionIconPixmaps.value());
+
+	return hash;
+}
+
+void StatusNotifierItem::updatePixmapIndex() {
+	// Items commonly resend an identical icon, which should not cause a reload.
+	auto hash = this->computeIconContentHash();
+	if (hash == this->iconContentHash) return;
+
+	this->iconContentHash = hash;
+	this->pixmapIndex = this->pixmapIndex + 1;
+}
 
 DBusMenuHandle* StatusNotifierItem::menuHandle() {
 	return this->bMenuPath.value().path().isEmpty() ? nullptr : &this->mMenuHandle;
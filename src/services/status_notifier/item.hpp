@@ -1,12 +1,15 @@
 #pragma once
 
+#include <qcache.h>
 #include <qdbusextratypes.h>
 #include <qdbuspendingcall.h>
+#include <qhashfunctions.h>
 #include <qicon.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
 #include <qpixmap.h>
 #include <qproperty.h>
+#include <qsize.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
@@ -82,6 +85,18 @@ namespace qs::service::sni {
 
 class StatusNotifierItem;
 
+struct TrayPixmapCacheKey {
+	size_t contentHash = 0;
+	QSize size;
+	bool needsAttention = false;
+
+	[[nodiscard]] bool operator==(const TrayPixmapCacheKey& other) const = default;
+};
+
+inline size_t qHash(const TrayPixmapCacheKey& key, size_t seed = 0) {
+	return qHashMulti(seed, key.contentHash, key.size.width(), key.size.height(), key.needsAttention);
+}
+
 class TrayImageHandle: public QsImageHandle {
 public:
 	explicit TrayImageHandle(StatusNotifierItem* item);
@@ -139,6 +154,8 @@ public:
 	[[nodiscard]] bool isReady() const;
 	[[nodiscard]] QBindable<QString> bindableIcon() const { return &this->bIcon; }
 	[[nodiscard]] QPixmap createPixmap(const QSize& size) const;
+	// Drops rendered pixmaps, which may contain theme icons, and makes consumers reload them.
+	void invalidatePixmaps();
 
 	[[nodiscard]] dbus::dbusmenu::DBusMenuHandle* menuHandle();
 
@@ -172,11 +189,18 @@ private:
 	void updateMenuState();
 	void updatePixmapIndex();
 	void onMenuPathChanged();
+	[[nodiscard]] size_t computeIconContentHash() const;
+	[[nodiscard]] QPixmap renderPixmap(const QSize& size, bool needsAttention) const;
 
 	DBusStatusNotifierItem* item = nullptr;
 	TrayImageHandle imageHandle {this};
 	bool mReady = false;
 
+	// Animated items tend to cycle between a few frames, so rendered pixmaps are kept
+	// by content instead of being dropped on every icon change. Cost is in KiB.
+	size_t iconContentHash = 0;
+	mutable QCache<TrayPixmapCacheKey, QPixmap> pixmapCache {1024};
+
 	dbus::dbusmenu::DBusMenuHandle mMenuHandle {this};
 
 	QString watcherId;
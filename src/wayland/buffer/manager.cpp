@@ -9,6 +9,7 @@
 #include <qmatrix4x4.h>
 #include <qnamespace.h>
 #include <qquickwindow.h>
+#include <qsgnode.h>
 #include <qtenvironmentvariables.h>
 #include <qtmetamacros.h>
 #include <qvectornd.h>
@@ -44,7 +45,15 @@ WlBuffer* WlBufferSwapchain::createBackbuffer(const WlBufferRequest& request, bo
 	static const bool noReuse = qEnvironmentVariableIsSet("QS_NO_BUFFER_REUSE");
 	auto& buffer = this->presentSecondBuffer ? this->buffer1 : this->buffer2;
 
-	if (!buffer || !buffer->isCompatible(request) || noReuse) {
+	if (this->shmOnly) {
+		auto shmRequest = request;
+		shmRequest.dmabuf = {};
+
+		if (!buffer || !buffer->isCompatible(shmRequest) || noReuse) {
+			buffer.reset(WlBufferManager::instance()->createBuffer(shmRequest));
+			if (newBuffer) *newBuffer = true;
+		}
+	} else if (!buffer || !buffer->isCompatible(request) || noReuse) {
 		buffer.reset(WlBufferManager::instance()->createBuffer(request));
 		if (newBuffer) *newBuffer = true;
 	}
@@ -125,7 +134,7 @@ bool WlBufferManager::isReady() const {
 		return nullptr;
 	}
 
-	if (!dmabufDisabled && !this->p->mRenderFormatsFailed) {
+	if (!dmabufDisabled && !this->p->mRenderFormatsFailed && !request.dmabuf.formats.isEmpty()) {
 		if (auto* buf = this->p->dmabuf.createDmabuf(request)) return buf;
 		qCWarning(logBuffer) << "DMA buffer creation failed, falling back to SHM.";
 	}
@@ -196,6 +205,9 @@ void WlBufferQSGDisplayNode::syncSwapchain(const WlBufferSwapchain& swapchain) {
 	}
 
 	this->imageNode->setTexture(texture.second->texture());
+
+	// Textures may be updated in place, which setTexture will not pick up.
+	this->imageNode->markDirty(QSGNode::DirtyMaterial);
 }
 
 } // namespace qs::wayland::buffer
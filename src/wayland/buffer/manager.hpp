@@ -2,11 +2,14 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 
 #include <qhash.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qmatrix4x4.h>
 #include <qobject.h>
+#include <qrect.h>
 #include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 #include <qvariant.h>
@@ -88,10 +91,33 @@ public:
 	// Must be called from render thread.
 	[[nodiscard]] virtual WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const = 0;
 
+	// Returns an image referencing the buffer's memory, or a null image if the buffer is
+	// not CPU accessible. The image is only valid while the buffer is alive and unchanged.
+	[[nodiscard]] virtual QImage image() const { return QImage(); }
+
+	// Record that new content was written to the buffer. If damage is given, it must cover
+	// every pixel that differs from the buffer's previous content, and may be empty if
+	// nothing changed. Without damage the whole buffer is considered changed.
+	void markWritten(std::optional<QRect> damage = std::nullopt) {
+		this->contentSerial++;
+		this->contentDamage = damage;
+	}
+
+	// Incremented on every write. Textures compare it against the serial they last
+	// synced to decide if only the damaged region needs to be uploaded.
+	[[nodiscard]] quint64 serial() const { return this->contentSerial; }
+
+	// Region changed by the last write, or nullopt if it is unknown.
+	[[nodiscard]] std::optional<QRect> damage() const { return this->contentDamage; }
+
 	WlBufferTransform transform;
 
 protected:
 	explicit WlBuffer() = default;
+
+private:
+	quint64 contentSerial = 0;
+	std::optional<QRect> contentDamage;
 };
 
 class WlBufferSwapchain {
@@ -99,7 +125,16 @@ public:
 	[[nodiscard]] WlBuffer*
 	createBackbuffer(const WlBufferRequest& request, bool* newBuffer = nullptr);
 
-	void swapBuffers() { this->presentSecondBuffer = !this->presentSecondBuffer; }
+	// If set, only CPU accessible shm buffers will be created.
+	void setShmOnly(bool shmOnly) { this->shmOnly = shmOnly; }
+
+	// Presents the backbuffer. If given, damage is the region of the backbuffer changed by the
+	// last capture into it, which is empty if nothing changed. Otherwise the whole buffer is
+	// considered changed.
+	void swapBuffers(std::optional<QRect> damage = std::nullopt) {
+		if (auto* buffer = this->backbuffer()) buffer->markWritten(damage);
+		this->presentSecondBuffer = !this->presentSecondBuffer;
+	}
 
 	[[nodiscard]] WlBuffer* backbuffer() const {
 		return this->presentSecondBuffer ? this->buffer1.get() : this->buffer2.get();
@@ -113,6 +148,7 @@ private:
 	std::unique_ptr<WlBuffer> buffer1;
 	std::unique_ptr<WlBuffer> buffer2;
 	bool presentSecondBuffer = false;
+	bool shmOnly = false;
 
 	friend class WlBufferQSGDisplayNode;
 };
@@ -1,5 +1,6 @@
 #include "shm.hpp"
 #include <algorithm>
+#include <atomic>
 #include <memory>
 
 #include <private/qwaylanddisplay_p.h>
@@ -7,20 +8,27 @@
 #include <private/qwaylandshm_p.h>
 #include <private/qwaylandshmbackingstore_p.h>
 #include <qdebug.h>
+#include <qimage.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qpoint.h>
 #include <qquickwindow.h>
+#include <qrect.h>
 #include <qsize.h>
+#include <qtypes.h>
+#include <rhi/qrhi.h>
 #include <wayland-client-protocol.h>
 
 #include "../../core/logcat.hpp"
+#include "../../core/uploadstats.hpp"
 #include "manager.hpp"
 
 namespace qs::wayland::buffer::shm {
 
 namespace {
 QS_LOGGING_CATEGORY(logShm, "quickshell.wayland.buffer.shm", QtWarningMsg);
-}
+QS_LOGGING_CATEGORY(logShmUpload, "quickshell.wayland.buffer.shm.upload", QtWarningMsg);
+} // namespace
 
 bool WlShmBuffer::isCompatible(const WlBufferRequest& request) const {
 	if (QSize(static_cast<int>(request.width), static_cast<int>(request.height)) != this->size()) {
@@ -58,16 +66,117 @@ WlBufferQSGTexture* WlShmBuffer::createQsgTexture(QQuickWindow* window) const {
 	// in the render thread.
 	texture->shmBuffer = this->shmBuffer;
 
-	texture->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
-	texture->sync(this, window);
+	// The software renderer has no RHI, and can only consume image backed textures.
+	if (window->rhi()) {
+		texture->rhiTexture = new WlShmRhiTexture(this->shmBuffer);
+		texture->qsgTexture.reset(texture->rhiTexture);
+	} else {
+		texture->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
+	}
+
+	texture->syncedSerial = this->serial();
 	return texture;
 }
 
-void WlShmBufferQSGTexture::sync(const WlBuffer* /*unused*/, QQuickWindow* window) {
-	// This is both dumb and expensive. We should use an RHI texture and render images into
-	// it more intelligently, but shm buffers are already a horribly slow fallback path,
-	// to the point where it barely matters.
-	this->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
+std::atomic<quint64> WlShmBufferQSGTexture::UPLOADED_BYTES = 0; // NOLINT
+
+void WlShmBufferQSGTexture::sync(const WlBuffer* buffer, QQuickWindow* window) {
+	if (!this->rhiTexture) {
+		this->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
+		return;
+	}
+
+	// Damage is relative to the previous write, so it can only be used if the texture
+	// has seen that write. Otherwise the whole buffer is reuploaded.
+	if (buffer->serial() == this->syncedSerial + 1) {
+		// An empty damage rect means the write changed nothing, so no upload is needed.
+		if (auto damage = buffer->damage()) this->rhiTexture->markDirty(*damage);
+		else this->rhiTexture->markAllDirty();
+	} else if (buffer->serial() != this->syncedSerial) {
+		this->rhiTexture->markAllDirty();
+	}
+
+	this->syncedSerial = buffer->serial();
+}
+
+WlShmRhiTexture::~WlShmRhiTexture() { delete this->mTexture; }
+
+qint64 WlShmRhiTexture::comparisonKey() const {
+	return static_cast<qint64>(reinterpret_cast<quintptr>(this)); // NOLINT
+}
+
+QSize WlShmRhiTexture::textureSize() const { return this->shmBuffer->size(); }
+
+bool WlShmRhiTexture::hasAlphaChannel() const {
+	return this->shmBuffer->image()->hasAlphaChannel();
+}
+
+void WlShmRhiTexture::markDirty(const QRect& rect) {
+	if (!rect.isEmpty()) this->dirtyRect = this->dirtyRect.united(rect);
+}
+
+void WlShmRhiTexture::markAllDirty() { this->dirtyRect = QRect(QPoint(), this->textureSize()); }
+
+void WlShmRhiTexture::commitTextureOperations(QRhi* rhi, QRhiResourceUpdateBatch* resourceUpdates) {
+	const auto& image = *this->shmBuffer->image();
+
+	if (!this->mTexture) {
+		auto format = QRhiTexture::RGBA8;
+
+		switch (image.format()) {
+		case QImage::Format_RGB32:
+		case QImage::Format_ARGB32:
+		case QImage::Format_ARGB32_Premultiplied:
+			if (rhi->isTextureFormatSupported(QRhiTexture::BGRA8)) {
+				format = QRhiTexture::BGRA8;
+			} else {
+				this->convertOnUpload = true;
+			}
+			break;
+		case QImage::Format_RGBX8888:
+		case QImage::Format_RGBA8888:
+		case QImage::Format_RGBA8888_Premultiplied: break;
+		default: this->convertOnUpload = true; break;
+		}
+
+		this->mTexture = rhi->newTexture(format, image.size());
+
+		if (!this->mTexture->create()) {
+			qCWarning(logShm) << "Failed to create RHI texture for" << this;
+			delete this->mTexture;
+			this->mTexture = nullptr;
+			return;
+		}
+
+		qCDebug(logShm) << "Created RHI texture for" << this << "(converted:" << this->convertOnUpload
+		                << ')';
+
+		this->dirtyRect = image.rect();
+	}
+
+	auto rect = this->dirtyRect.intersected(image.rect());
+	this->dirtyRect = QRect();
+	if (rect.isEmpty()) return;
+
+	auto upload = QRhiTextureSubresourceUploadDescription();
+
+	if (this->convertOnUpload) {
+		upload.setImage(image.copy(rect).convertToFormat(QImage::Format_RGBA8888_Premultiplied));
+	} else {
+		upload.setImage(image);
+		upload.setSourceTopLeft(rect.topLeft());
+		upload.setSourceSize(rect.size());
+	}
+
+	upload.setDestinationTopLeft(rect.topLeft());
+	resourceUpdates->uploadTexture(this->mTexture, QRhiTextureUploadEntry(0, 0, upload));
+
+	auto bytes = static_cast<quint64>(rect.width()) * rect.height() * 4;
+	auto total = WlShmBufferQSGTexture::UPLOADED_BYTES += bytes;
+	TextureUploadStats::add(bytes);
+
+	qCDebug(logShmUpload) << "Uploaded" << bytes << "bytes in" << rect << "for" << this << "(total"
+	                      << total << "bytes)";
 }
 
 WlBuffer* ShmbufManager::createShmbuf(const WlBufferRequest& request) {
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <utility>
 
 #include <private/qwaylandshmbackingstore_p.h>
+#include <qimage.h>
 #include <qquickwindow.h>
+#include <qrect.h>
 #include <qsgtexture.h>
 #include <qsize.h>
 #include <qtclasshelpermacros.h>
+#include <qtypes.h>
+#include <rhi/qrhi.h>
 #include <wayland-client-protocol.h>
 
 #include "manager.hpp"
@@ -23,6 +29,7 @@ public:
 	[[nodiscard]] QSize size() const override { return this->shmBuffer->size(); }
 	[[nodiscard]] bool isCompatible(const WlBufferRequest& request) const override;
 	[[nodiscard]] WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const override;
+	[[nodiscard]] QImage image() const override { return *this->shmBuffer->image(); }
 
 private:
 	WlShmBuffer(QtWaylandClient::QWaylandShmBuffer* shmBuffer, uint32_t format)
@@ -39,18 +46,54 @@ private:
 
 QDebug& operator<<(QDebug& debug, const WlShmBuffer* buffer);
 
+// Scenegraph texture backed by a persistent RHI texture, which is only updated in
+// the regions of the shm buffer that changed since the last upload.
+class WlShmRhiTexture: public QSGTexture {
+public:
+	explicit WlShmRhiTexture(std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer)
+	    : shmBuffer(std::move(shmBuffer)) {}
+
+	~WlShmRhiTexture() override;
+	Q_DISABLE_COPY_MOVE(WlShmRhiTexture);
+
+	[[nodiscard]] qint64 comparisonKey() const override;
+	[[nodiscard]] QRhiTexture* rhiTexture() const override { return this->mTexture; }
+	[[nodiscard]] QSize textureSize() const override;
+	[[nodiscard]] bool hasAlphaChannel() const override;
+	[[nodiscard]] bool hasMipmaps() const override { return false; }
+	void commitTextureOperations(QRhi* rhi, QRhiResourceUpdateBatch* resourceUpdates) override;
+
+	// Marks a region for upload on the next commit.
+	void markDirty(const QRect& rect);
+	void markAllDirty();
+
+private:
+	std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer;
+	QRhiTexture* mTexture = nullptr;
+	QRect dirtyRect;
+	bool convertOnUpload = false;
+};
+
 class WlShmBufferQSGTexture: public WlBufferQSGTexture {
 public:
 	[[nodiscard]] QSGTexture* texture() const override { return this->qsgTexture.get(); }
 	void sync(const WlBuffer* buffer, QQuickWindow* window) override;
 
+	// Total bytes uploaded to shm textures, for debugging.
+	[[nodiscard]] static quint64 uploadedBytes() { return UPLOADED_BYTES.load(); }
+
 private:
 	WlShmBufferQSGTexture() = default;
 
+	static std::atomic<quint64> UPLOADED_BYTES; // NOLINT
+
 	std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer;
 	std::unique_ptr<QSGTexture> qsgTexture;
+	WlShmRhiTexture* rhiTexture = nullptr;
+	quint64 syncedSerial = 0;
 
 	friend class WlShmBuffer;
+	friend class WlShmRhiTexture;
 };
 
 class ShmbufManager {
@@ -3,10 +3,13 @@
 #include <functional>
 #include <utility>
 
+#include <qbytearray.h>
 #include <qbytearrayview.h>
 #include <qcontainerfwd.h>
+#include <qdatastream.h>
 #include <qdir.h>
 #include <qfileinfo.h>
+#include <qiodevice.h>
 #include <qjsonarray.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
@@ -24,6 +27,7 @@
 #include "../../../core/logcat.hpp"
 #include "../../../core/model.hpp"
 #include "../../../core/qmlscreen.hpp"
+#include "../../../core/recovery.hpp"
 #include "../../toplevel/wlr_toplevel.hpp"
 #include "hyprland_toplevel.hpp"
 #include "monitor.hpp"
@@ -74,6 +78,8 @@ HyprlandIpc::HyprlandIpc() {
 
 	// clang-format on
 
+	this->restoreRecoverySnapshot();
+
 	this->makeRequest("j/status", [&, this](bool success, QByteArray resp) {
 		if (success) {
 			this->bUsingLua = [&]() {
@@ -622,63 +628,68 @@ void HyprlandIpc::refreshWorkspaces(bool canCreate) {
 		this->requestingWorkspaces = false;
 		if (!success) return;
 
-		qCDebug(logHyprlandIpc) << "Parsing workspaces response";
-		auto json = QJsonDocument::fromJson(resp).array();
+		this->lastWorkspaces = resp;
+		this->applyWorkspaces(resp, canCreate);
+	});
+}
 
-		const auto& mList = this->mWorkspaces.valueList();
-		auto ids = QVector<quint32>();
+void HyprlandIpc::applyWorkspaces(const QByteArray& resp, bool canCreate) {
+	qCDebug(logHyprlandIpc) << "Parsing workspaces response";
+	auto json = QJsonDocument::fromJson(resp).array();
 
-		for (auto entry: json) {
-			auto object = entry.toObject().toVariantMap();
+	const auto& mList = this->mWorkspaces.valueList();
+	auto ids = QVector<quint32>();
 
-			auto id = object.value("id").toInt();
+	for (auto entry: json) {
+		auto object = entry.toObject().toVariantMap();
 
-			auto workspaceIter = std::ranges::find_if(mList, [&](HyprlandWorkspace* m) {
-				return m->bindableId().value() == id;
-			});
+		auto id = object.value("id").toInt();
 
-			// Only fall back to name-based filtering as a last resort, for workspaces where
-			// no ID has been determined yet.
-			if (workspaceIter == mList.end()) {
-				auto name = object.value("name").toString();
+		auto workspaceIter = std::ranges::find_if(mList, [&](HyprlandWorkspace* m) {
+			return m->bindableId().value() == id;
+		});
 
-				workspaceIter = std::ranges::find_if(mList, [&](HyprlandWorkspace* m) {
-					return m->bindableId().value() == -1 && m->bindableName().value() == name;
-				});
-			}
+		// Only fall back to name-based filtering as a last resort, for workspaces where
+		// no ID has been determined yet.
+		if (workspaceIter == mList.end()) {
+			auto name = object.value("name").toString();
 
-			auto* workspace = workspaceIter == mList.end() ? nullptr : *workspaceIter;
-			auto existed = workspace != nullptr;
+			workspaceIter = std::ranges::find_if(mList, [&](HyprlandWorkspace* m) {
+				return m->bindableId().value() == -1 && m->bindableName().value() == name;
+			});
+		}
 
-			if (!existed) {
-				if (!canCreate) continue;
-				workspace = new HyprlandWorkspace(this);
-			}
+		auto* workspace = workspaceIter == mList.end() ? nullptr : *workspaceIter;
+		auto existed = workspace != nullptr;
 
-			workspace->updateFromObject(object);
+		if (!existed) {
+			if (!canCreate) continue;
+			workspace = new HyprlandWorkspace(this);
+		}
 
-			if (!existed) {
-				this->mWorkspaces.insertObjectSorted(workspace, &HyprlandIpc::compareWorkspaces);
-			}
+		workspace->updateFromObject(object);
 
-			ids.push_back(id);
+		if (!existed) {
+			this->mWorkspaces.insertObjectSorted(workspace, &HyprlandIpc::compareWorkspaces);
 		}
 
-		if (canCreate) {
-			auto removedWorkspaces = QVector<HyprlandWorkspace*>();
+		ids.push_back(id);
+	}
 
-			for (auto* workspace: mList) {
-				if (!ids.contains(workspace->bindableId().value())) {
-					removedWorkspaces.push_back(workspace);
-				}
-			}
+	if (canCreate) {
+		auto removedWorkspaces = QVector<HyprlandWorkspace*>();
 
-			for (auto* workspace: removedWorkspaces) {
-				this->mWorkspaces.removeObject(workspace);
-				delete workspace;
+		for (auto* workspace: mList) {
+			if (!ids.contains(workspace->bindableId().value())) {
+				removedWorkspaces.push_back(workspace);
 			}
 		}
-	});
+
+		for (auto* workspace: removedWorkspaces) {
+			this->mWorkspaces.removeObject(workspace);
+			delete workspace;
+		}
+	}
 }
 
 HyprlandToplevel* HyprlandIpc::findToplevelByAddress(quint64 address, bool createIfMissing) {
@@ -807,51 +818,79 @@ void HyprlandIpc::refreshMonitors(bool canCreate) {
 		if (!success) return;
 
 		this->monitorsRequested = true;
+		this->lastMonitors = resp;
+		this->applyMonitors(resp, canCreate);
+	});
+}
 
-		qCDebug(logHyprlandIpc) << "parsing monitors response";
-		auto json = QJsonDocument::fromJson(resp).array();
-
-		const auto& mList = this->mMonitors.valueList();
-		auto names = QVector<QString>();
+void HyprlandIpc::applyMonitors(const QByteArray& resp, bool canCreate) {
+	qCDebug(logHyprlandIpc) << "parsing monitors response";
+	auto json = QJsonDocument::fromJson(resp).array();
 
-		for (auto entry: json) {
-			auto object = entry.toObject().toVariantMap();
-			auto name = object.value("name").toString();
+	const auto& mList = this->mMonitors.valueList();
+	auto names = QVector<QString>();
 
-			auto monitorIter = std::ranges::find_if(mList, [name](HyprlandMonitor* m) {
-				return m->bindableName().value() == name;
-			});
+	for (auto entry: json) {
+		auto object = entry.toObject().toVariantMap();
+		auto name = object.value("name").toString();
 
-			auto* monitor = monitorIter == mList.end() ? nullptr : *monitorIter;
-			auto existed = monitor != nullptr;
+		auto monitorIter = std::ranges::find_if(mList, [name](HyprlandMonitor* m) {
+			return m->bindableName().value() == name;
+		});
 
-			if (monitor == nullptr) {
-				if (!canCreate) continue;
-				monitor = new HyprlandMonitor(this);
-			}
+		auto* monitor = monitorIter == mList.end() ? nullptr : *monitorIter;
+		auto existed = monitor != nullptr;
 
-			monitor->updateFromObject(object);
+		if (monitor == nullptr) {
+			if (!canCreate) continue;
+			monitor = new HyprlandMonitor(this);
+		}
 
-			if (!existed) {
-				this->mMonitors.insertObject(monitor);
-			}
+		monitor->updateFromObject(object);
 
-			names.push_back(name);
+		if (!existed) {
+			this->mMonitors.insertObject(monitor);
 		}
 
-		auto removedMonitors = QVector<HyprlandMonitor*>();
+		names.push_back(name);
+	}
 
-		for (auto* monitor: mList) {
-			if (!names.contains(monitor->bindableName().value())) {
-				removedMonitors.push_back(monitor);
-			}
-		}
+	auto removedMonitors = QVector<HyprlandMonitor*>();
 
-		for (auto* monitor: removedMonitors) {
-			this->mMonitors.removeObject(monitor);
-			// see comment in onEvent
-			monitor->deleteLater();
+	for (auto* monitor: mList) {
+		if (!names.contains(monitor->bindableName().value())) {
+			removedMonitors.push_back(monitor);
 		}
+	}
+
+	for (auto* monitor: removedMonitors) {
+		this->mMonitors.removeObject(monitor);
+		// see comment in onEvent
+		monitor->deleteLater();
+	}
+}
+
+void HyprlandIpc::restoreRecoverySnapshot() {
+	auto* recovery = RecoverySnapshot::instance();
+	auto stream = QDataStream(recovery->take("hyprland"));
+	auto monitors = QByteArray();
+	auto workspaces = QByteArray();
+	stream >> monitors >> workspaces;
+
+	// Replaced by the responses to the requests made on connection.
+	if (stream.status() == QDataStream::Ok) {
+		qCDebug(logHyprlandIpc) << "Restoring monitors and workspaces from before a crash";
+		this->applyMonitors(monitors, true);
+		this->applyWorkspaces(workspaces, true);
+	}
+
+	recovery->addSource("hyprland", [this]() {
+		if (this->lastMonitors.isEmpty()) return QByteArray();
+
+		auto data = QByteArray();
+		auto stream = QDataStream(&data, QIODevice::WriteOnly);
+		stream << this->lastMonitors << this->lastWorkspaces;
+		return data;
 	});
 }
 
@@ -2,6 +2,7 @@
 
 #include <functional>
 
+#include <qbytearray.h>
 #include <qbytearrayview.h>
 #include <qcontainerfwd.h>
 #include <qhash.h>
@@ -136,6 +137,9 @@ private:
 	explicit HyprlandIpc();
 
 	void onEvent(HyprlandIpcEvent* event);
+	void applyMonitors(const QByteArray& resp, bool canCreate);
+	void applyWorkspaces(const QByteArray& resp, bool canCreate);
+	void restoreRecoverySnapshot();
 
 	static bool compareWorkspaces(HyprlandWorkspace* a, HyprlandWorkspace* b);
 
@@ -148,6 +152,9 @@ private:
 	bool requestingWorkspaces = false;
 	bool requestingToplevels = false;
 	bool monitorsRequested = false;
+	// last full responses, kept for recovery snapshots
+	QByteArray lastMonitors;
+	QByteArray lastWorkspaces;
 
 	ObjectModel<HyprlandMonitor> mMonitors {this};
 	ObjectModel<HyprlandWorkspace> mWorkspaces {this};
@@ -5,11 +5,15 @@
 #include <qscopeguard.h>
 #include <qtypes.h>
 
+#include "../../core/powerstate.hpp"
 #include "proto.hpp"
 
 namespace qs::wayland::idle_notify {
 
-IdleMonitor::~IdleMonitor() { delete this->bNotification.value(); }
+IdleMonitor::~IdleMonitor() {
+	if (this->holdingIdle) PowerState::instance()->releaseIdleHold();
+	delete this->bNotification.value();
+}
 
 void IdleMonitor::onPostReload() {
 	this->bParams.setBinding([this] {
@@ -24,6 +28,10 @@ void IdleMonitor::onPostReload() {
 		auto* notification = this->bNotification.value();
 		return notification ? notification->bIsIdle.value() : false;
 	});
+
+	this->bHoldsIdle.setBinding([this] {
+		return this->bPauseLiveContent.value() && this->bIsIdle.value();
+	});
 }
 
 void IdleMonitor::updateNotification() {
@@ -49,4 +57,13 @@ void IdleMonitor::updateNotification() {
 	}
 }
 
+void IdleMonitor::updateIdleHold() {
+	auto holdsIdle = this->bHoldsIdle.value();
+	if (holdsIdle == this->holdingIdle) return;
+	this->holdingIdle = holdsIdle;
+
+	if (holdsIdle) PowerState::instance()->acquireIdleHold();
+	else PowerState::instance()->releaseIdleHold();
+}
+
 } // namespace qs::wayland::idle_notify
@@ -34,6 +34,10 @@ class IdleMonitor: public PostReloadHook {
 	/// This property is true if the user has been idle for at least @@timeout.
 	/// What is considered to be idle is influenced by @@respectInhibitors.
 	Q_PROPERTY(bool isIdle READ default NOTIFY isIdleChanged BINDABLE bindableIsIdle);
+	/// When set to true, live content such as @@Quickshell.Wayland.ScreencopyView and
+	/// @@Quickshell.Services.Pipewire.PwNodePeakMonitor will be paused while @@isIdle is true
+	/// and @@Quickshell.Quickshell.powerSaving is enabled. Defaults to false.
+	Q_PROPERTY(bool pauseLiveContent READ default WRITE default NOTIFY pauseLiveContentChanged BINDABLE bindablePauseLiveContent);
 	// clang-format on
 
 public:
@@ -49,15 +53,18 @@ public:
 	[[nodiscard]] QBindable<qreal> bindableTimeout() { return &this->bTimeout; }
 	[[nodiscard]] QBindable<bool> bindableRespectInhibitors() { return &this->bRespectInhibitors; }
 	[[nodiscard]] QBindable<bool> bindableIsIdle() const { return &this->bIsIdle; }
+	[[nodiscard]] QBindable<bool> bindablePauseLiveContent() { return &this->bPauseLiveContent; }
 
 signals:
 	void enabledChanged();
 	void timeoutChanged();
 	void respectInhibitorsChanged();
 	void isIdleChanged();
+	void pauseLiveContentChanged();
 
 private:
 	void updateNotification();
+	void updateIdleHold();
 
 	struct Params {
 		bool enabled;
@@ -72,7 +79,11 @@ private:
 	Q_OBJECT_BINDABLE_PROPERTY(IdleMonitor, Params, bParams, &IdleMonitor::updateNotification);
 	Q_OBJECT_BINDABLE_PROPERTY(IdleMonitor, impl::IdleNotification*, bNotification);
 	Q_OBJECT_BINDABLE_PROPERTY(IdleMonitor, bool, bIsIdle, &IdleMonitor::isIdleChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(IdleMonitor, bool, bPauseLiveContent, &IdleMonitor::pauseLiveContentChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(IdleMonitor, bool, bHoldsIdle, &IdleMonitor::updateIdleHold);
 	// clang-format on
+
+	bool holdingIdle = false;
 };
 
 } // namespace qs::wayland::idle_notify
@@ -17,6 +17,7 @@ void installPopupPositioner();  // NOLINT(misc-use-internal-linkage)
 namespace {
 
 class WaylandPlugin: public QsEnginePlugin {
+	QString name() override { return "wayland"; }
 	QList<QString> dependencies() override { return {"window"}; }
 
 	bool applies() override {
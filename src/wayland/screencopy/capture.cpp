@@ -0,0 +1,280 @@
+#include "capture.hpp"
+#include <utility>
+
+#include <qbuffer.h>
+#include <qbytearray.h>
+#include <qfileinfo.h>
+#include <qimage.h>
+#include <qimagewriter.h>
+#include <qiodevice.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qobjectdefs.h>
+#include <qqmlinfo.h>
+#include <qrect.h>
+#include <qsavefile.h>
+#include <qthreadpool.h>
+#include <qtmetamacros.h>
+#include <qtransform.h>
+
+#include "../../core/logcat.hpp"
+#include "../buffer/manager.hpp"
+#include "manager.hpp"
+#include "qoi.hpp"
+
+namespace qs::wayland::screencopy {
+
+namespace {
+QS_LOGGING_CATEGORY(logScreencopyCapture, "quickshell.wayland.screencopy.capture", QtWarningMsg);
+}
+
+ScreencopyEncodeOperation::ScreencopyEncodeOperation(
+    QImage image,
+    buffer::WlBufferTransform transform,
+    QRect region,
+    QString path,
+    QByteArray format
+)
+    : image(std::move(image))
+    , transform(transform)
+    , region(region)
+    , path(std::move(path))
+    , format(std::move(format)) {
+	this->setAutoDelete(false);
+}
+
+void ScreencopyEncodeOperation::run() {
+	if (!this->shouldCancel.loadAcquire()) {
+		auto image = std::move(this->image);
+
+		// Matches the transform applied by WlBufferQSGDisplayNode.
+		if (this->transform.degrees() != 0) {
+			image = image.transformed(QTransform().rotate(this->transform.degrees()));
+		}
+
+		if (this->transform.flip()) {
+			image = image.mirrored(true, false);
+		}
+
+		if (!this->region.isEmpty()) {
+			image = image.copy(this->region.intersected(image.rect()));
+		}
+
+		if (this->path.isEmpty()) {
+			auto buffer = QBuffer(&this->data);
+			buffer.open(QIODevice::WriteOnly);
+			this->encode(image, &buffer);
+		} else {
+			auto file = QSaveFile(this->path);
+
+			if (!file.open(QIODevice::WriteOnly)) {
+				this->error = file.errorString();
+			} else {
+				this->encode(image, &file);
+
+				if (this->error.isEmpty() && !file.commit()) {
+					this->error = file.errorString();
+				}
+			}
+		}
+	}
+
+	QMetaObject::invokeMethod(this, &ScreencopyEncodeOperation::finished, Qt::QueuedConnection);
+}
+
+void ScreencopyEncodeOperation::encode(const QImage& image, QIODevice* device) {
+	if (this->format == "qoi") {
+		if (device->write(encodeQoi(image)) == -1) this->error = device->errorString();
+	} else {
+		auto writer = QImageWriter(device, this->format);
+		if (!writer.write(image)) this->error = writer.errorString();
+	}
+}
+
+void ScreencopyEncodeOperation::finished() {
+	emit this->done(this->path, this->data, this->error);
+	delete this;
+}
+
+void ScreencopyEncodeOperation::tryCancel() { this->shouldCancel.storeRelease(true); }
+
+ScreencopyCapture::~ScreencopyCapture() {
+	if (this->liveOperation) {
+		QObject::disconnect(this->liveOperation, nullptr, this, nullptr);
+		this->liveOperation->tryCancel();
+	}
+
+	this->destroyContext();
+}
+
+void ScreencopyCapture::setCaptureSource(QObject* captureSource) {
+	if (captureSource == this->mCaptureSource) return;
+
+	if (this->mCaptureSource) {
+		QObject::disconnect(this->mCaptureSource, nullptr, this, nullptr);
+	}
+
+	this->mCaptureSource = captureSource;
+
+	if (captureSource) {
+		QObject::connect(
+		    captureSource,
+		    &QObject::destroyed,
+		    this,
+		    &ScreencopyCapture::onCaptureSourceDestroyed
+		);
+	}
+
+	emit this->captureSourceChanged();
+}
+
+void ScreencopyCapture::onCaptureSourceDestroyed() {
+	this->mCaptureSource = nullptr;
+
+	if (this->context) {
+		this->destroyContext();
+		this->finish("The capture source was destroyed.");
+	}
+}
+
+void ScreencopyCapture::setPaintCursors(bool paintCursors) {
+	if (paintCursors == this->mPaintCursors) return;
+	this->mPaintCursors = paintCursors;
+	emit this->paintCursorsChanged();
+}
+
+void ScreencopyCapture::setRegion(QRect region) {
+	if (region == this->mRegion) return;
+	this->mRegion = region;
+	emit this->regionChanged();
+}
+
+void ScreencopyCapture::resetRegion() { this->setRegion(QRect()); }
+
+void ScreencopyCapture::captureToFile(const QString& path) {
+	this->startCapture(path, QFileInfo(path).suffix());
+}
+
+void ScreencopyCapture::captureToData(const QString& format) {
+	this->startCapture(QString(), format);
+}
+
+void ScreencopyCapture::startCapture(const QString& path, const QString& format) {
+	if (this->bBusy) {
+		qmlWarning(this) << "Cannot capture a frame while a capture is already in progress.";
+		return;
+	}
+
+	if (!this->mCaptureSource) {
+		qmlWarning(this) << "Cannot capture a frame without a capture source.";
+		return;
+	}
+
+	this->context = ScreencopyManager::createContext(this->mCaptureSource, this->mPaintCursors);
+
+	if (!this->context) {
+		qmlWarning(this) << "Capture source set to non captureable object.";
+		return;
+	}
+
+	// Frames are read back on the CPU, which is only possible with shm buffers.
+	this->context->swapchain().setShmOnly(true);
+
+	// clang-format off
+	QObject::connect(this->context, &ScreencopyContext::frameCaptured, this, &ScreencopyCapture::onFrameCaptured);
+	QObject::connect(this->context, &ScreencopyContext::stopped, this, &ScreencopyCapture::onStopped);
+	// clang-format on
+
+	if (path.isEmpty()) {
+		qCDebug(logScreencopyCapture) << "Capturing" << this->mCaptureSource << "to memory as"
+		                              << format;
+	} else {
+		qCDebug(logScreencopyCapture) << "Capturing" << this->mCaptureSource << "to" << path;
+	}
+
+	this->pendingPath = path;
+	this->pendingFormat = format.toLower().toUtf8();
+	this->bBusy = true;
+	this->context->captureFrame();
+}
+
+void ScreencopyCapture::onFrameCaptured() {
+	const auto* buffer = this->context->swapchain().frontbuffer();
+
+	// The buffer is owned by the context, so its pixels are copied before it is destroyed.
+	// Everything else happens in the encode operation.
+	auto image = buffer->image().copy();
+	auto transform = buffer->transform;
+	this->destroyContext();
+
+	if (image.isNull()) {
+		this->finish("The captured buffer could not be read.");
+		return;
+	}
+
+	this->liveOperation = new ScreencopyEncodeOperation(
+	    std::move(image),
+	    transform,
+	    this->mRegion,
+	    this->pendingPath,
+	    this->pendingFormat
+	);
+
+	QObject::connect(
+	    this->liveOperation,
+	    &ScreencopyEncodeOperation::done,
+	    this,
+	    &ScreencopyCapture::onEncodeDone
+	);
+
+	QThreadPool::globalInstance()->start(this->liveOperation);
+}
+
+void ScreencopyCapture::onStopped() {
+	this->destroyContext();
+	this->finish("The compositor stopped the capture.");
+}
+
+void ScreencopyCapture::onEncodeDone(
+    const QString& path,
+    const QByteArray& data,
+    const QString& error
+) {
+	this->liveOperation = nullptr;
+
+	if (path.isEmpty()) {
+		qCDebug(logScreencopyCapture) << "Finished encoding capture into" << data.size() << "bytes";
+	} else {
+		qCDebug(logScreencopyCapture) << "Finished writing capture to" << path;
+	}
+
+	this->finish(error, data);
+}
+
+void ScreencopyCapture::destroyContext() {
+	if (!this->context) return;
+
+	QObject::disconnect(this->context, nullptr, this, nullptr);
+	ScreencopyManager::releaseContext(this->context);
+	this->context = nullptr;
+}
+
+void ScreencopyCapture::finish(const QString& error, const QByteArray& data) {
+	auto path = this->pendingPath;
+	this->pendingPath.clear();
+	this->pendingFormat.clear();
+	this->bBusy = false;
+
+	if (!error.isEmpty()) {
+		qmlWarning(this) << "Failed to capture frame:" << error;
+		emit this->failed(error);
+	} else if (path.isEmpty()) {
+		emit this->dataCaptured(data);
+	} else {
+		emit this->saved(path);
+	}
+}
+
+} // namespace qs::wayland::screencopy
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <qatomic.h>
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qiodevice.h>
+#include <qobject.h>
+#include <qproperty.h>
+#include <qqmlintegration.h>
+#include <qrect.h>
+#include <qrunnable.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtmetamacros.h>
+
+#include "../buffer/manager.hpp"
+#include "manager.hpp"
+
+namespace qs::wayland::screencopy {
+
+class ScreencopyEncodeOperation
+    : public QObject
+    , public QRunnable {
+	Q_OBJECT;
+
+public:
+	// Writes the image to path if set, otherwise encodes it into memory.
+	explicit ScreencopyEncodeOperation(
+	    QImage image,
+	    buffer::WlBufferTransform transform,
+	    QRect region,
+	    QString path,
+	    QByteArray format
+	);
+
+	void run() override;
+	void tryCancel();
+
+signals:
+	void done(const QString& path, const QByteArray& data, const QString& error);
+
+private slots:
+	void finished();
+
+private:
+	void encode(const QImage& image, QIODevice* device);
+
+	QAtomicInteger<bool> shouldCancel = false;
+	QImage image;
+	buffer::WlBufferTransform transform;
+	QRect region;
+	QString path;
+	QByteArray format;
+	QByteArray data;
+	QString error;
+};
+
+///! Captures still images without displaying them.
+/// ScreencopyCapture captures single frames from the same sources as @@ScreencopyView
+/// and writes them to a file or encodes them in memory, without requiring a visible window.
+///
+/// Frames are copied through shared memory and encoded off the main thread.
+///
+/// #### Example
+/// ```qml
+/// ScreencopyCapture {
+///   id: capture
+///   captureSource: Quickshell.screens[0]
+///   onSaved: path => console.log(`Screenshot saved to ${path}`)
+/// }
+///
+/// // elsewhere
+/// capture.captureToFile("/tmp/screenshot.qoi");
+/// ```
+///
+/// Encoded images can also be kept in memory, for example to send them to another
+/// process or upload them somewhere, with @@captureToData().
+class ScreencopyCapture: public QObject {
+	Q_OBJECT;
+	QML_ELEMENT;
+	// clang-format off
+	/// The object to capture from. Accepts the same objects as @@ScreencopyView.captureSource.
+	Q_PROPERTY(QObject* captureSource READ captureSource WRITE setCaptureSource NOTIFY captureSourceChanged);
+	/// If true, the system cursor will be painted on the image. Defaults to false.
+	Q_PROPERTY(bool paintCursor READ paintCursors WRITE setPaintCursors NOTIFY paintCursorsChanged);
+	/// The region of the captured image to keep, in image pixels. If empty, the whole
+	/// image is kept.
+	///
+	/// Can be set to `undefined` to reset.
+	Q_PROPERTY(QRect region READ region WRITE setRegion RESET resetRegion NOTIFY regionChanged);
+	/// If true, a capture is currently in progress.
+	Q_PROPERTY(bool busy READ default NOTIFY busyChanged BINDABLE bindableBusy);
+	// clang-format on
+
+public:
+	explicit ScreencopyCapture(QObject* parent = nullptr): QObject(parent) {}
+	~ScreencopyCapture() override;
+	Q_DISABLE_COPY_MOVE(ScreencopyCapture);
+
+	/// Capture a single frame and write it to `path`.
+	///
+	/// The image format is chosen from the file extension. `qoi` is supported in addition
+	/// to the formats supported by Qt, such as `png` and `jpg`. QOI is considerably
+	/// faster to encode than PNG for full screen captures.
+	///
+	/// Has no effect if a capture is already in progress.
+	Q_INVOKABLE void captureToFile(const QString& path);
+	/// Capture a single frame and encode it in memory, emitting @@dataCaptured(s) with the result.
+	///
+	/// `format` accepts the same formats as the file extensions of @@captureToFile().
+	///
+	/// Has no effect if a capture is already in progress.
+	Q_INVOKABLE void captureToData(const QString& format = QStringLiteral("png"));
+
+	[[nodiscard]] QObject* captureSource() const { return this->mCaptureSource; }
+	void setCaptureSource(QObject* captureSource);
+
+	[[nodiscard]] bool paintCursors() const { return this->mPaintCursors; }
+	void setPaintCursors(bool paintCursors);
+
+	[[nodiscard]] QRect region() const { return this->mRegion; }
+	void setRegion(QRect region);
+	void resetRegion();
+
+	[[nodiscard]] QBindable<bool> bindableBusy() { return &this->bBusy; }
+
+signals:
+	/// The captured image was written to `path`.
+	void saved(const QString& path);
+	/// The captured image was encoded by @@captureToData().
+	void dataCaptured(const QByteArray& data);
+	/// The capture failed, or the image could not be written.
+	void failed(const QString& error);
+
+	void captureSourceChanged();
+	void paintCursorsChanged();
+	void regionChanged();
+	void busyChanged();
+
+private slots:
+	void onCaptureSourceDestroyed();
+	void onFrameCaptured();
+	void onStopped();
+	void onEncodeDone(const QString& path, const QByteArray& data, const QString& error);
+
+private:
+	void startCapture(const QString& path, const QString& format);
+	void destroyContext();
+	void finish(const QString& error, const QByteArray& data = QByteArray());
+
+	QObject* mCaptureSource = nullptr;
+	bool mPaintCursors = false;
+	QRect mRegion;
+	QString pendingPath;
+	QByteArray pendingFormat;
+	ScreencopyContext* context = nullptr;
+	ScreencopyEncodeOperation* liveOperation = nullptr;
+
+	Q_OBJECT_BINDABLE_PROPERTY(ScreencopyCapture, bool, bBusy, &ScreencopyCapture::busyChanged);
+};
+
+} // namespace qs::wayland::screencopy
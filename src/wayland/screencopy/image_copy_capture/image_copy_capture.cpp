@@ -1,5 +1,6 @@
 #include "image_copy_capture.hpp"
 #include <cstdint>
+#include <optional>
 
 #include <private/qwaylandscreen_p.h>
 #include <qlogging.h>
@@ -138,6 +139,8 @@ void IccScreencopyContext::doCapture() {
 
 		// We don't care about partial damage if the whole buffer was replaced.
 		this->lastDamage = QRect();
+		this->repairDamage = QRect();
+		this->fullRepair = true;
 	} else if (!this->lastDamage.isEmpty()) {
 		// If buffers were swapped between the last frame and the current one, request a repaint
 		// of the backbuffer in the same places that changes to the frontbuffer were recorded.
@@ -149,6 +152,7 @@ void IccScreencopyContext::doCapture() {
 		);
 
 		// We don't need to do this more than once per buffer swap.
+		this->repairDamage = this->lastDamage;
 		this->lastDamage = QRect();
 	}
 
@@ -171,9 +175,18 @@ void IccScreencopyContext::ext_image_copy_capture_frame_v1_damage(
 void IccScreencopyContext::ext_image_copy_capture_frame_v1_ready() {
 	this->IccCaptureFrame::destroy();
 
-	this->mSwapchain.swapBuffers();
+	// The compositor repainted the repaired region as well as the new damage, so together
+	// they cover everything that changed since this buffer was last presented.
+	// An empty region is passed on as is, as the frame did not change anything.
+	auto bufferDamage = this->fullRepair ? std::nullopt
+	                                     : std::optional(this->damage.united(this->repairDamage));
+
+	this->mSwapchain.swapBuffers(bufferDamage);
+
 	this->lastDamage = this->damage;
 	this->damage = QRect();
+	this->repairDamage = QRect();
+	this->fullRepair = false;
 
 	emit this->frameCaptured();
 }
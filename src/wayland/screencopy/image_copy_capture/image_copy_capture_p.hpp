@@ -46,6 +46,8 @@ private:
 	bool capturePending = false;
 	QRect damage;
 	QRect lastDamage;
+	QRect repairDamage;
+	bool fullRepair = false;
 };
 
 } // namespace qs::wayland::screencopy::icc
@@ -1,6 +1,11 @@
 #include "manager.hpp"
+#include <cmath>
 
+#include <qhash.h>
 #include <qobject.h>
+#include <qpair.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "build.hpp"
 
@@ -23,6 +28,100 @@
 
 namespace qs::wayland::screencopy {
 
+namespace {
+
+using SharedContextKey = QPair<QObject*, bool>;
+
+QHash<SharedContextKey, ScreencopyContext*>& sharedContexts() {
+	static auto contexts = QHash<SharedContextKey, ScreencopyContext*>();
+	return contexts;
+}
+
+} // namespace
+
+ScreencopyContext::ScreencopyContext() {
+	this->pacingTimer.setSingleShot(true);
+
+	QObject::connect(
+	    &this->pacingTimer,
+	    &QTimer::timeout,
+	    this,
+	    &ScreencopyContext::onPacingTimeout
+	);
+}
+
+void ScreencopyContext::requestFrame(qreal maxFrameRate) {
+	if (maxFrameRate <= 0 || !this->lastCapture.isValid()) {
+		this->startCapture();
+		return;
+	}
+
+	auto interval = 1000.0 / maxFrameRate;
+	auto elapsed = static_cast<qreal>(this->lastCapture.elapsed());
+
+	if (elapsed >= interval) {
+		this->startCapture();
+	} else {
+		// When shared, the most frequent requester determines the capture rate.
+		auto remaining = static_cast<int>(std::ceil(interval - elapsed));
+
+		if (!this->pacingTimer.isActive() || this->pacingTimer.remainingTime() > remaining) {
+			this->pacingTimer.start(remaining);
+		}
+	}
+}
+
+void ScreencopyContext::onPacingTimeout() { this->startCapture(); }
+
+void ScreencopyContext::startCapture() {
+	this->pacingTimer.stop();
+	this->lastCapture.start();
+	this->captureFrame();
+}
+
+ScreencopyContext* ScreencopyManager::acquireSharedContext(QObject* object, bool paintCursors) {
+	auto key = SharedContextKey(object, paintCursors);
+	auto& contexts = sharedContexts();
+	auto* context = contexts.value(key);
+
+	if (!context) {
+		context = ScreencopyManager::createContext(object, paintCursors);
+		if (!context) return nullptr;
+
+		contexts.insert(key, context);
+
+		// A stopped context stays alive until its users release it, but must not be
+		// handed out to new users.
+		QObject::connect(context, &ScreencopyContext::stopped, context, [key, context]() {
+			auto& contexts = sharedContexts();
+			auto iter = contexts.find(key);
+			if (iter != contexts.end() && *iter == context) contexts.erase(iter);
+		});
+	}
+
+	context->refcount++;
+	return context;
+}
+
+void ScreencopyManager::releaseContext(ScreencopyContext* context) {
+	if (!context) return;
+
+	if (context->refcount > 1) {
+		context->refcount--;
+		return;
+	}
+
+	auto& contexts = sharedContexts();
+	for (auto iter = contexts.begin(); iter != contexts.end(); ++iter) {
+		if (*iter == context) {
+			contexts.erase(iter);
+			break;
+		}
+	}
+
+	delete context;
+}
+
 ScreencopyContext* ScreencopyManager::createContext(QObject* object, bool paintCursors) {
 	if (auto* screen = qobject_cast<QuickshellScreenInfo*>(object)) {
 #if SCREENCOPY_ICC
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <qelapsedtimer.h>
 #include <qobject.h>
 #include <qtclasshelpermacros.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../buffer/manager.hpp"
 
@@ -15,19 +18,43 @@ public:
 	[[nodiscard]] buffer::WlBufferSwapchain& swapchain() { return this->mSwapchain; }
 	virtual void captureFrame() = 0;
 
+	// Capture a frame, delaying it if needed so frames are not captured more than
+	// maxFrameRate times per second. A maxFrameRate of 0 captures immediately.
+	void requestFrame(qreal maxFrameRate = 0);
+
 signals:
 	void frameCaptured();
 	void stopped();
 
 protected:
-	ScreencopyContext() = default;
+	ScreencopyContext();
 
 	buffer::WlBufferSwapchain mSwapchain;
+
+private slots:
+	void onPacingTimeout();
+
+private:
+	void startCapture();
+
+	QElapsedTimer lastCapture;
+	QTimer pacingTimer;
+	quint32 refcount = 0;
+
+	friend class ScreencopyManager;
 };
 
 class ScreencopyManager {
 public:
 	static ScreencopyContext* createContext(QObject* object, bool paintCursors);
+
+	// Returns a context shared between all callers capturing the same object with the same
+	// options. Must be released with releaseContext.
+	static ScreencopyContext* acquireSharedContext(QObject* object, bool paintCursors);
+
+	// Releases a context from createContext or acquireSharedContext, destroying it
+	// if it has no other users.
+	static void releaseContext(ScreencopyContext* context);
 };
 
 } // namespace qs::wayland::screencopy
@@ -0,0 +1,133 @@
+#include "qoi.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qtypes.h>
+
+namespace qs::wayland::screencopy {
+
+namespace {
+
+constexpr quint8 QOI_OP_INDEX = 0x00;
+constexpr quint8 QOI_OP_DIFF = 0x40;
+constexpr quint8 QOI_OP_LUMA = 0x80;
+constexpr quint8 QOI_OP_RUN = 0xc0;
+constexpr quint8 QOI_OP_RGB = 0xfe;
+constexpr quint8 QOI_OP_RGBA = 0xff;
+constexpr int QOI_MAX_RUN = 62;
+
+struct QoiPixel {
+	quint8 r = 0;
+	quint8 g = 0;
+	quint8 b = 0;
+	quint8 a = 0;
+
+	[[nodiscard]] bool operator==(const QoiPixel& other) const = default;
+
+	[[nodiscard]] quint8 hash() const {
+		return (this->r * 3 + this->g * 5 + this->b * 7 + this->a * 11) % 64;
+	}
+};
+
+void appendU32(QByteArray& out, quint32 value) {
+	out.append(static_cast<char>(value >> 24));
+	out.append(static_cast<char>(value >> 16));
+	out.append(static_cast<char>(value >> 8));
+	out.append(static_cast<char>(value));
+}
+
+} // namespace
+
+QByteArray encodeQoi(const QImage& source) {
+	auto image = source.convertToFormat(QImage::Format_RGBA8888);
+	auto width = image.width();
+	auto height = image.height();
+
+	auto out = QByteArray();
+	// Screen content usually compresses well, so reserve 1 byte per pixel instead of the worst case.
+	out.reserve(14 + static_cast<qsizetype>(width) * height + 8);
+
+	out.append("qoif");
+	appendU32(out, width);
+	appendU32(out, height);
+	out.append(static_cast<char>(4)); // channels
+	out.append(static_cast<char>(0)); // sRGB with linear alpha
+
+	auto index = std::array<QoiPixel, 64>();
+	auto prev = QoiPixel {.r = 0, .g = 0, .b = 0, .a = 255};
+	auto run = 0;
+
+	for (auto y = 0; y != height; ++y) {
+		const auto* line = image.constScanLine(y);
+
+		for (auto x = 0; x != width; ++x) {
+			const auto* data = line + static_cast<ptrdiff_t>(x) * 4;                    // NOLINT
+			auto px = QoiPixel {.r = data[0], .g = data[1], .b = data[2], .a = data[3]}; // NOLINT
+
+			if (px == prev) {
+				if (++run == QOI_MAX_RUN) {
+					out.append(static_cast<char>(QOI_OP_RUN | (run - 1)));
+					run = 0;
+				}
+
+				continue;
+			}
+
+			if (run != 0) {
+				out.append(static_cast<char>(QOI_OP_RUN | (run - 1)));
+				run = 0;
+			}
+
+			auto hash = px.hash();
+
+			if (index[hash] == px) {
+				out.append(static_cast<char>(QOI_OP_INDEX | hash));
+			} else {
+				index[hash] = px;
+
+				if (px.a == prev.a) {
+					auto dr = static_cast<int8_t>(px.r - prev.r);
+					auto dg = static_cast<int8_t>(px.g - prev.g);
+					auto db = static_cast<int8_t>(px.b - prev.b);
+					auto drdg = dr - dg;
+					auto dbdg = db - dg;
+
+					if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+						auto diff = (dr + 2) << 4 | (dg + 2) << 2 | (db + 2);
+						out.append(static_cast<char>(QOI_OP_DIFF | diff));
+					} else if (drdg > -9 && drdg < 8 && dg > -33 && dg < 32 && dbdg > -9 && dbdg < 8)
+					{
+						out.append(static_cast<char>(QOI_OP_LUMA | (dg + 32)));
+						out.append(static_cast<char>((drdg + 8) << 4 | (dbdg + 8)));
+					} else {
+						out.append(static_cast<char>(QOI_OP_RGB));
+						out.append(static_cast<char>(px.r));
+						out.append(static_cast<char>(px.g));
+						out.append(static_cast<char>(px.b));
+					}
+				} else {
+					out.append(static_cast<char>(QOI_OP_RGBA));
+					out.append(static_cast<char>(px.r));
+					out.append(static_cast<char>(px.g));
+					out.append(static_cast<char>(px.b));
+					out.append(static_cast<char>(px.a));
+				}
+			}
+
+			prev = px;
+		}
+	}
+
+	if (run != 0) out.append(static_cast<char>(QOI_OP_RUN | (run - 1)));
+
+	// end marker
+	out.append(7, '\0');
+	out.append('\x01');
+
+	return out;
+}
+
+} // namespace qs::wayland::screencopy
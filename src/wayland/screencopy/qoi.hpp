@@ -0,0 +1,12 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qimage.h>
+
+namespace qs::wayland::screencopy {
+
+// Encodes an image in the QOI format (https://qoiformat.org), which is much
+// faster to write than PNG for large screen captures.
+QByteArray encodeQoi(const QImage& image);
+
+} // namespace qs::wayland::screencopy
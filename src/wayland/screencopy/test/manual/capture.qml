@@ -0,0 +1,24 @@
+// Does not open any windows, so it can be run against a headless compositor:
+// WLR_BACKENDS=headless sway -c /dev/null & WAYLAND_DISPLAY=wayland-1 qs -p capture.qml
+import QtQuick
+import Quickshell
+import Quickshell.Wayland
+
+ShellRoot {
+	ScreencopyCapture {
+		id: capture
+		captureSource: Quickshell.screens[0]
+
+		onSaved: path => {
+			console.log(`Saved capture to ${path}`);
+			Qt.quit();
+		}
+
+		onFailed: error => {
+			console.log(`Capture failed: ${error}`);
+			Qt.exit(1);
+		}
+	}
+
+	Component.onCompleted: capture.captureToFile(`${Quickshell.cacheDir}/capture.qoi`)
+}
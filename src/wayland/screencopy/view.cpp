@@ -2,11 +2,13 @@
 
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qobjectdefs.h>
 #include <qqmlinfo.h>
 #include <qquickitem.h>
 #include <qsize.h>
 #include <qtmetamacros.h>
 
+#include "../../core/powerstate.hpp"
 #include "../buffer/manager.hpp"
 #include "../buffer/qsg.hpp"
 #include "manager.hpp"
@@ -28,6 +30,13 @@ ScreencopyView::ScreencopyView(QQuickItem* parent): QQuickItem(parent) {
 
 		return size;
 	});
+
+	QObject::connect(
+	    PowerState::instance(),
+	    &PowerState::liveContentPausedChanged,
+	    this,
+	    &ScreencopyView::onLiveContentPausedChanged
+	);
 }
 
 void ScreencopyView::setCaptureSource(QObject* captureSource) {
@@ -66,25 +75,40 @@ void ScreencopyView::setPaintCursors(bool paintCursors) {
 
 void ScreencopyView::setLive(bool live) {
 	if (live == this->mLive) return;
+	this->mLive = live;
 
-	if (live && !this->mLive && this->context) {
-		this->context->captureFrame();
+	// Only live views share captures, as a still image must not be replaced by
+	// frames requested by other views.
+	if (this->completed && this->context) {
+		this->createContext();
 	}
 
-	this->mLive = live;
 	emit this->liveChanged();
 }
 
+void ScreencopyView::setMaxFrameRate(qreal maxFrameRate) {
+	if (maxFrameRate < 0) maxFrameRate = 0;
+	if (maxFrameRate == this->mMaxFrameRate) return;
+	this->mMaxFrameRate = maxFrameRate;
+	emit this->maxFrameRateChanged();
+}
+
 void ScreencopyView::createContext() {
 	this->destroyContext(false);
-	this->context = ScreencopyManager::createContext(this->mCaptureSource, this->mPaintCursors);
+
+	if (this->mLive) {
+		this->context =
+		    ScreencopyManager::acquireSharedContext(this->mCaptureSource, this->mPaintCursors);
+	} else {
+		this->context = ScreencopyManager::createContext(this->mCaptureSource, this->mPaintCursors);
+	}
 
 	if (!this->context) {
 		qmlWarning(this) << "Capture source set to non captureable object.";
 		return;
 	}
 
-	this->context->setParent(this);
+	this->contextShared = this->mLive;
 
 	QObject::connect(
 	    this->context,
@@ -100,13 +124,24 @@ void ScreencopyView::createContext() {
 	    &ScreencopyView::onFrameCaptured
 	);
 
-	this->context->captureFrame();
+	// A shared context may already hold a frame from another view.
+	if (this->contextShared && this->context->swapchain().frontbuffer()) {
+		this->onFrameCaptured();
+	}
+
+	this->context->requestFrame(this->mLive ? this->mMaxFrameRate : 0);
 }
 
 void ScreencopyView::destroyContext(bool update) {
 	auto hadContext = this->context != nullptr;
-	delete this->context;
+
+	if (this->context) {
+		QObject::disconnect(this->context, nullptr, this, nullptr);
+		ScreencopyManager::releaseContext(this->context);
+	}
+
 	this->context = nullptr;
+	this->contextShared = false;
 	this->bHasContent = false;
 	this->bSourceSize = QSize();
 	if (hadContext && update) this->update();
@@ -171,10 +206,28 @@ QSGNode* ScreencopyView::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*
 	node->setRect(this->boundingRect());
 	node->setFiltering(QSGTexture::Linear); // NOLINT (misc-include-cleaner)
 
-	if (this->mLive) this->context->captureFrame();
+	// Called from the render thread. Shared contexts may be used by views in other windows,
+	// so the next frame is requested from the gui thread.
+	if (this->mLive) {
+		QMetaObject::invokeMethod(this, &ScreencopyView::requestLiveFrame, Qt::QueuedConnection);
+	}
+
 	return node;
 }
 
+void ScreencopyView::requestLiveFrame() {
+	if (!this->context || !this->mLive) return;
+
+	// The last frame stays displayed while paused, and capture resumes once unpaused.
+	if (PowerState::instance()->liveContentPaused()) return;
+
+	this->context->requestFrame(this->mMaxFrameRate);
+}
+
+void ScreencopyView::onLiveContentPausedChanged() {
+	if (!PowerState::instance()->liveContentPaused()) this->requestLiveFrame();
+}
+
 void ScreencopyView::updateImplicitSize() {
 	auto size = this->bImplicitSize.value();
 	this->setImplicitSize(size.width(), size.height());
@@ -5,6 +5,7 @@
 #include <qqmlintegration.h>
 #include <qquickitem.h>
 #include <qsgnode.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 
 #include "manager.hpp"
@@ -31,6 +32,12 @@ class ScreencopyView: public QQuickItem {
 	/// If true, a live video feed from the capture source will be displayed instead of a still image.
 	/// Defaults to false.
 	Q_PROPERTY(bool live READ live WRITE setLive NOTIFY liveChanged);
+	/// The maximum number of frames per second to capture when @@live is true.
+	/// Defaults to 0, which captures as fast as the view can display frames.
+	///
+	/// Live views of the same capture source share a single capture, which runs at
+	/// the highest frame rate requested among them.
+	Q_PROPERTY(qreal maxFrameRate READ maxFrameRate WRITE setMaxFrameRate NOTIFY maxFrameRateChanged);
 	/// If true, the view has content ready to display. Content is not always immediately available,
 	/// and this property can be used to avoid displaying it until ready.
 	Q_PROPERTY(bool hasContent READ default NOTIFY hasContentChanged BINDABLE bindableHasContent);
@@ -43,6 +50,8 @@ class ScreencopyView: public QQuickItem {
 
 public:
 	explicit ScreencopyView(QQuickItem* parent = nullptr);
+	~ScreencopyView() override { this->destroyContext(false); }
+	Q_DISABLE_COPY_MOVE(ScreencopyView);
 
 	void componentComplete() override;
 
@@ -58,6 +67,9 @@ public:
 	[[nodiscard]] bool live() const { return this->mLive; }
 	void setLive(bool live);
 
+	[[nodiscard]] qreal maxFrameRate() const { return this->mMaxFrameRate; }
+	void setMaxFrameRate(qreal maxFrameRate);
+
 	[[nodiscard]] QBindable<bool> bindableHasContent() { return &this->bHasContent; }
 	[[nodiscard]] QBindable<QSize> bindableSourceSize() { return &this->bSourceSize; }
 	[[nodiscard]] QBindable<QSizeF> bindableConstraintSize() { return &this->bConstraintSize; }
@@ -69,6 +81,7 @@ signals:
 	void captureSourceChanged();
 	void paintCursorsChanged();
 	void liveChanged();
+	void maxFrameRateChanged();
 	void hasContentChanged();
 	void sourceSizeChanged();
 	void constraintSizeChanged();
@@ -81,6 +94,8 @@ private slots:
 	void onFrameCaptured();
 	void destroyContextWithUpdate() { this->destroyContext(); }
 	void onBuffersReady();
+	void requestLiveFrame();
+	void onLiveContentPausedChanged();
 
 private:
 	void destroyContext(bool update = true);
@@ -97,7 +112,9 @@ private:
 	QObject* mCaptureSource = nullptr;
 	bool mPaintCursors = false;
 	bool mLive = false;
+	qreal mMaxFrameRate = 0;
 	ScreencopyContext* context = nullptr;
+	bool contextShared = false;
 	bool completed = false;
 };
 
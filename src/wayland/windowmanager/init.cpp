@@ -11,6 +11,7 @@ void installWmProvider();
 namespace {
 
 class WaylandWmPlugin: public QsEnginePlugin {
+	QString name() override { return "wayland-wm"; }
 	QList<QString> dependencies() override { return {"window"}; }
 
 	bool applies() override { return QGuiApplication::platformName() == "wayland"; }
@@ -0,0 +1,214 @@
+#include "framestats.hpp"
+
+#include <private/qquickitem_p.h>
+#include <private/qquickwindow_p.h>
+#include <qcontainerfwd.h>
+#include <qmutex.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qquickitem.h>
+#include <qquickwindow.h>
+#include <qtypes.h>
+#include <qvariant.h>
+
+#include "../core/ringbuf.hpp"
+#include "../core/uploadstats.hpp"
+
+namespace {
+
+constexpr qsizetype HISTORY_SIZE = 240;
+constexpr int REFRESH_INTERVAL = 250;
+// refresh once more after frames stop so framesPerSecond settles
+constexpr int IDLE_REFRESH_INTERVAL = 1000;
+
+qreal toMs(qint64 ns) { return static_cast<qreal>(ns) / 1000000.0; }
+
+} // namespace
+
+FrameStatsCollector::FrameStatsCollector(QQuickWindow* window)
+    : QObject(window)
+    , window(window)
+    , history(HISTORY_SIZE) {
+	this->clock.start();
+
+	// clang-format off
+	QObject::connect(window, &QQuickWindow::beforeSynchronizing, this, &FrameStatsCollector::onBeforeSynchronizing, Qt::DirectConnection);
+	QObject::connect(window, &QQuickWindow::afterSynchronizing, this, &FrameStatsCollector::onAfterSynchronizing, Qt::DirectConnection);
+	QObject::connect(window, &QQuickWindow::beforeRendering, this, &FrameStatsCollector::onBeforeRendering, Qt::DirectConnection);
+	QObject::connect(window, &QQuickWindow::afterRendering, this, &FrameStatsCollector::onAfterRendering, Qt::DirectConnection);
+	QObject::connect(window, &QQuickWindow::frameSwapped, this, &FrameStatsCollector::onFrameSwapped, Qt::DirectConnection);
+	// clang-format on
+}
+
+void FrameStatsCollector::onBeforeSynchronizing() {
+	this->pending.syncStart = this->clock.nsecsElapsed();
+	this->pending.uploadStart = TextureUploadStats::threadTotal();
+
+	// The gui thread is blocked during sync, and dirty items are processed right after this
+	// signal is emitted.
+	auto count = 0;
+	auto* item = QQuickWindowPrivate::get(this->window)->dirtyItemList;
+	while (item != nullptr) {
+		count++;
+		item = QQuickItemPrivate::get(item)->nextDirtyItem;
+	}
+
+	this->pending.itemsUpdated = count;
+}
+
+void FrameStatsCollector::onAfterSynchronizing() {
+	this->pending.syncEnd = this->clock.nsecsElapsed();
+}
+
+void FrameStatsCollector::onBeforeRendering() {
+	this->pending.renderStart = this->clock.nsecsElapsed();
+
+	// The basic render loop renders every window on the same thread, so uploads are only
+	// counted from the start of this window's frame.
+	if (this->pending.syncStart == 0) this->pending.uploadStart = TextureUploadStats::threadTotal();
+}
+
+void FrameStatsCollector::onAfterRendering() {
+	this->pending.renderEnd = this->clock.nsecsElapsed();
+}
+
+void FrameStatsCollector::onFrameSwapped() {
+	auto now = this->clock.nsecsElapsed();
+	auto& pending = this->pending;
+
+	auto frame = FrameTiming {
+	    .endNs = now,
+	    .syncNs = pending.syncEnd - pending.syncStart,
+	    .renderNs = pending.renderEnd - pending.renderStart,
+	    .swapNs = now - pending.renderEnd,
+	    .itemsUpdated = pending.itemsUpdated,
+	    .uploadBytes = TextureUploadStats::threadTotal() - pending.uploadStart,
+	};
+
+	// Sync stats are left at 0 for frames rendered without a sync.
+	pending = {};
+
+	{
+		auto lock = QMutexLocker(&this->mutex);
+		this->history.emplace(frame);
+		this->frameCount++;
+		this->uploadBytes += frame.uploadBytes;
+	}
+
+	emit this->frameRecorded();
+}
+
+FrameStatsCollector::Snapshot FrameStatsCollector::snapshot() const {
+	auto snapshot = Snapshot {.nowNs = this->clock.nsecsElapsed()};
+
+	auto lock = QMutexLocker(&this->mutex);
+	snapshot.frameCount = this->frameCount;
+	snapshot.uploadBytes = this->uploadBytes;
+	snapshot.history.reserve(this->history.size());
+
+	for (auto i = 0; i < this->history.size(); i++) {
+		snapshot.history.append(this->history.at(i));
+	}
+
+	return snapshot;
+}
+
+void FrameStatsCollector::reset() {
+	auto lock = QMutexLocker(&this->mutex);
+	this->history.clear();
+	this->frameCount = 0;
+	this->uploadBytes = 0;
+}
+
+qint32 framesInLastSecond(const FrameStatsCollector::Snapshot& snapshot) {
+	auto count = 0;
+
+	for (const auto& frame: snapshot.history) {
+		if (snapshot.nowNs - frame.endNs > 1000000000) break;
+		count++;
+	}
+
+	return count;
+}
+
+WindowFrameStats::WindowFrameStats(QObject* parent): QObject(parent) {
+	this->refreshTimer.setSingleShot(true);
+	QObject::connect(&this->refreshTimer, &QTimer::timeout, this, &WindowFrameStats::refresh);
+}
+
+void WindowFrameStats::setCollector(FrameStatsCollector* collector) {
+	if (collector == this->collector) return;
+
+	if (this->collector) QObject::disconnect(this->collector, nullptr, this, nullptr);
+	this->collector = collector;
+
+	if (collector) {
+		QObject::connect(
+		    collector,
+		    &FrameStatsCollector::frameRecorded,
+		    this,
+		    &WindowFrameStats::onFrameRecorded
+		);
+	}
+
+	this->refresh();
+}
+
+void WindowFrameStats::onFrameRecorded() {
+	if (!this->refreshTimer.isActive() || this->refreshTimer.remainingTime() > REFRESH_INTERVAL) {
+		this->refreshTimer.start(REFRESH_INTERVAL);
+	}
+}
+
+void WindowFrameStats::refresh() {
+	this->last = this->collector ? this->collector->snapshot() : FrameStatsCollector::Snapshot();
+	emit this->updated();
+
+	if (this->framesPerSecond() != 0 && !this->refreshTimer.isActive()) {
+		this->refreshTimer.start(IDLE_REFRESH_INTERVAL);
+	}
+}
+
+void WindowFrameStats::reset() {
+	if (this->collector) this->collector->reset();
+	this->refresh();
+}
+
+QVariantList WindowFrameStats::history() const {
+	auto list = QVariantList();
+	list.reserve(this->last.history.size());
+
+	for (const auto& frame: this->last.history) {
+		list.append(QVariantMap {
+		    {"syncTime", toMs(frame.syncNs)},
+		    {"renderTime", toMs(frame.renderNs)},
+		    {"swapTime", toMs(frame.swapNs)},
+		    {"itemsUpdated", frame.itemsUpdated},
+		    {"uploadBytes", static_cast<qint64>(frame.uploadBytes)},
+		});
+	}
+
+	return list;
+}
+
+qint32 WindowFrameStats::framesPerSecond() const { return framesInLastSecond(this->last); }
+
+qreal WindowFrameStats::syncTime() const {
+	return this->last.history.isEmpty() ? 0 : toMs(this->last.history.first().syncNs);
+}
+
+qreal WindowFrameStats::renderTime() const {
+	return this->last.history.isEmpty() ? 0 : toMs(this->last.history.first().renderNs);
+}
+
+qreal WindowFrameStats::swapTime() const {
+	return this->last.history.isEmpty() ? 0 : toMs(this->last.history.first().swapNs);
+}
+
+qint32 WindowFrameStats::itemsUpdated() const {
+	return this->last.history.isEmpty() ? 0 : this->last.history.first().itemsUpdated;
+}
+
+qint64 WindowFrameStats::textureUploadBytes() const {
+	return static_cast<qint64>(this->last.uploadBytes);
+}
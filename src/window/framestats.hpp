@@ -0,0 +1,145 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
+#include <qmutex.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlintegration.h>
+#include <qquickwindow.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+#include <qvariant.h>
+
+#include "../core/ringbuf.hpp"
+
+struct FrameTiming {
+	// end of the frame, relative to the collector's clock
+	qint64 endNs = 0;
+	qint64 syncNs = 0;
+	qint64 renderNs = 0;
+	qint64 swapNs = 0;
+	qint32 itemsUpdated = 0;
+	quint64 uploadBytes = 0;
+};
+
+// Collects frame timings from a window's scenegraph signals.
+//
+// With the threaded render loop the signals are emitted on the render thread, where the gui
+// thread is only blocked during sync, so finished frames are recorded under a lock.
+class FrameStatsCollector: public QObject {
+	Q_OBJECT;
+
+public:
+	explicit FrameStatsCollector(QQuickWindow* window);
+
+	struct Snapshot {
+		qint64 nowNs = 0;
+		quint64 frameCount = 0;
+		quint64 uploadBytes = 0;
+		// newest first
+		QList<FrameTiming> history;
+	};
+
+	[[nodiscard]] Snapshot snapshot() const;
+	void reset();
+
+signals:
+	// Emitted from the render thread once a frame has been recorded.
+	void frameRecorded();
+
+private:
+	void onBeforeSynchronizing();
+	void onAfterSynchronizing();
+	void onBeforeRendering();
+	void onAfterRendering();
+	void onFrameSwapped();
+
+	QQuickWindow* window;
+	QElapsedTimer clock;
+
+	// only touched from the render thread
+	struct {
+		qint64 syncStart = 0;
+		qint64 syncEnd = 0;
+		qint64 renderStart = 0;
+		qint64 renderEnd = 0;
+		qint32 itemsUpdated = 0;
+		quint64 uploadStart = 0;
+	} pending;
+
+	mutable QMutex mutex;
+	RingBuffer<FrameTiming> history;
+	quint64 frameCount = 0;
+	quint64 uploadBytes = 0;
+};
+
+///! Rendering statistics for a window.
+/// Frame timings collected from a window's scenegraph, useful for finding windows that
+/// render more often or take longer to render than expected.
+///
+/// Properties are refreshed at most a few times a second, and only while the window is
+/// rendering. Binding to them from a visible item in the same window will cause that
+/// window to render again each time they change.
+///
+/// Frame stats for every window can also be printed with `qs ipc frames`.
+class WindowFrameStats: public QObject {
+	Q_OBJECT;
+	// clang-format off
+	/// Number of frames rendered by the window since it was created or @@reset() was called.
+	Q_PROPERTY(qint64 frameCount READ frameCount NOTIFY updated);
+	/// Number of frames rendered in the last second.
+	Q_PROPERTY(qint32 framesPerSecond READ framesPerSecond NOTIFY updated);
+	/// Milliseconds spent synchronizing items with the scenegraph in the last frame.
+	/// The gui thread is blocked during this time.
+	Q_PROPERTY(qreal syncTime READ syncTime NOTIFY updated);
+	/// Milliseconds spent rendering the last frame.
+	Q_PROPERTY(qreal renderTime READ renderTime NOTIFY updated);
+	/// Milliseconds between the end of rendering and the last frame being swapped.
+	Q_PROPERTY(qreal swapTime READ swapTime NOTIFY updated);
+	/// Number of items whose scenegraph nodes were updated in the last frame.
+	Q_PROPERTY(qint32 itemsUpdated READ itemsUpdated NOTIFY updated);
+	/// Total bytes uploaded to textures while rendering the window.
+	///
+	/// Only uploads performed by Quickshell, such as screencopy buffers, are counted.
+	Q_PROPERTY(qint64 textureUploadBytes READ textureUploadBytes NOTIFY updated);
+	// clang-format on
+	QML_NAMED_ELEMENT(FrameStats);
+	QML_UNCREATABLE("FrameStats can only be accessed through a window.");
+
+public:
+	explicit WindowFrameStats(QObject* parent = nullptr);
+
+	void setCollector(FrameStatsCollector* collector);
+
+	/// Returns up to the last 240 frames, newest first, as objects containing
+	/// `syncTime`, `renderTime`, `swapTime`, `itemsUpdated` and `uploadBytes`.
+	Q_INVOKABLE [[nodiscard]] QVariantList history() const;
+	/// Clears the collected stats.
+	Q_INVOKABLE void reset();
+
+	[[nodiscard]] qint64 frameCount() const { return static_cast<qint64>(this->last.frameCount); }
+	[[nodiscard]] qint32 framesPerSecond() const;
+	[[nodiscard]] qreal syncTime() const;
+	[[nodiscard]] qreal renderTime() const;
+	[[nodiscard]] qreal swapTime() const;
+	[[nodiscard]] qint32 itemsUpdated() const;
+	[[nodiscard]] qint64 textureUploadBytes() const;
+
+signals:
+	void updated();
+
+private slots:
+	void onFrameRecorded();
+	void refresh();
+
+private:
+	QPointer<FrameStatsCollector> collector;
+	FrameStatsCollector::Snapshot last;
+	QTimer refreshTimer;
+};
+
+// Returns the number of frames in a snapshot's history that ended within the last second.
+qint32 framesInLastSecond(const FrameStatsCollector::Snapshot& snapshot);
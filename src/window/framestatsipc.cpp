@@ -0,0 +1,90 @@
+#include "framestatsipc.hpp"
+
+#include <qcontainerfwd.h>
+#include <qguiapplication.h>
+#include <qminmax.h>
+#include <qobject.h>
+#include <qqmlcontext.h>
+#include <qqmlengine.h>
+#include <qscreen.h>
+#include <qstring.h>
+#include <qtypes.h>
+#include <qwindow.h>
+
+#include "../ipc/framestats.hpp"
+#include "framestats.hpp"
+#include "proxywindow.hpp"
+#include "windowinterface.hpp"
+
+namespace qs::window {
+
+using qs::ipc::WindowFrameSummary;
+
+namespace {
+
+QString describeWindow(ProxyWindowBase* proxy) {
+	// Windows declared in QML are usually wrapped by a WindowInterface.
+	QObject* object = qobject_cast<WindowInterface*>(proxy->parent());
+	if (object == nullptr) object = proxy;
+
+	auto name = QString();
+	if (auto* context = qmlContext(object)) name = context->nameForObject(object);
+
+	auto type = QString(object->metaObject()->className());
+	auto qmlTypeIndex = type.indexOf("_QMLTYPE_");
+	if (qmlTypeIndex != -1) type.truncate(qmlTypeIndex);
+
+	auto description = name.isEmpty() ? type : QStringLiteral("%1 (%2)").arg(name, type);
+	if (auto* screen = proxy->qscreen()) description += QStringLiteral(" on ") + screen->name();
+
+	return description;
+}
+
+QVector<WindowFrameSummary> summarizeWindows(bool reset) {
+	auto windows = QVector<WindowFrameSummary>();
+
+	for (auto* window: QGuiApplication::allWindows()) {
+		auto* proxied = qobject_cast<ProxiedWindow*>(window);
+		if (proxied == nullptr || proxied->proxy() == nullptr) continue;
+
+		auto* collector = proxied->frameStats();
+		if (reset) collector->reset();
+
+		auto snapshot = collector->snapshot();
+		auto stats = WindowFrameSummary {
+		    .name = describeWindow(proxied->proxy()),
+		    .frameCount = snapshot.frameCount,
+		    .framesPerSecond = framesInLastSecond(snapshot),
+		    .historyFrames = static_cast<qint32>(snapshot.history.size()),
+		    .uploadBytes = snapshot.uploadBytes,
+		};
+
+		if (!snapshot.history.isEmpty()) {
+			qint64 items = 0;
+
+			for (const auto& frame: snapshot.history) {
+				stats.avgSyncNs += frame.syncNs;
+				stats.avgRenderNs += frame.renderNs;
+				stats.avgSwapNs += frame.swapNs;
+				stats.maxFrameNs = qMax(stats.maxFrameNs, frame.syncNs + frame.renderNs + frame.swapNs);
+				items += frame.itemsUpdated;
+			}
+
+			auto count = snapshot.history.size();
+			stats.avgSyncNs /= count;
+			stats.avgRenderNs /= count;
+			stats.avgSwapNs /= count;
+			stats.avgItemsUpdated = static_cast<qint32>(items / count);
+		}
+
+		windows.append(stats);
+	}
+
+	return windows;
+}
+
+} // namespace
+
+void registerFrameStatsIpc() { qs::ipc::setFrameStatsProvider(&summarizeWindows); }
+
+} // namespace qs::window
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace qs::window {
+
+// Makes frame stats of every window available to `qs ipc frames`.
+void registerFrameStatsIpc();
+
+} // namespace qs::window
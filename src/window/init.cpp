@@ -2,6 +2,7 @@
 #include <qstring.h>
 
 #include "../core/plugin.hpp"
+#include "framestatsipc.hpp"
 
 namespace {
 
@@ -10,6 +11,8 @@ class WindowPlugin: public QsEnginePlugin {
 	// will apply in the wrong order.
 	QString name() override { return "window"; }
 
+	void init() override { qs::window::registerFrameStatsIpc(); }
+
 	void registerTypes() override {
 		qmlRegisterModuleImport(
 		    "Quickshell",
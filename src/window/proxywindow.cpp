@@ -4,6 +4,7 @@
 #include <private/qquickwindow_p.h>
 #include <qcontainerfwd.h>
 #include <qcoreevent.h>
+#include <qelapsedtimer.h>
 #include <qevent.h>
 #include <qguiapplication.h>
 #include <qlogging.h>
@@ -20,22 +21,27 @@
 #include <qregion.h>
 #include <qsurfaceformat.h>
 #include <qtenvironmentvariables.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
 #include <qwindow.h>
 
 #include "../core/generation.hpp"
+#include "../core/powerstate.hpp"
 #include "../core/qmlglobal.hpp"
 #include "../core/qmlscreen.hpp"
 #include "../core/region.hpp"
 #include "../core/reload.hpp"
+#include "../core/startuptrace.hpp"
 #include "../debug/lint.hpp"
+#include "framestats.hpp"
 #include "windowinterface.hpp"
 
 ProxyWindowBase::ProxyWindowBase(QObject* parent)
     : Reloadable(parent)
-    , mContentItem(new ProxyWindowContentItem()) {
+    , mContentItem(new ProxyWindowContentItem())
+    , mFrameStats(new WindowFrameStats(this)) {
 	QQmlEngine::setObjectOwnership(this->mContentItem, QQmlEngine::CppOwnership);
 	this->mContentItem->setParent(this);
 
@@ -182,6 +188,7 @@ ProxiedWindow* ProxyWindowBase::disownWindow(bool keepItemOwnership) {
 	if (this->window == nullptr) return nullptr;
 
 	QObject::disconnect(this->window, nullptr, this, nullptr);
+	this->mFrameStats->setCollector(nullptr);
 
 	if (!keepItemOwnership) {
 		this->mContentItem->setParentItem(nullptr);
@@ -205,6 +212,7 @@ void ProxyWindowBase::connectWindow() {
 	}
 
 	this->window->setProxy(this);
+	this->mFrameStats->setCollector(this->window->frameStats());
 
 	// clang-format off
 	QObject::connect(this->window, &QWindow::visibilityChanged, this, &ProxyWindowBase::onVisibleChanged);
@@ -230,7 +238,7 @@ void ProxyWindowBase::completeWindow() {
 	this->trySetHeight(this->implicitHeight());
 	this->setColor(this->mColor);
 	this->updateMask();
-	QQuickWindowPrivate::get(this->window)->updatesEnabled = this->mUpdatesEnabled;
+	this->window->setUpdatesEnabled(this->mUpdatesEnabled);
 
 	// notify initial / post-connection geometry
 	emit this->xChanged();
@@ -493,13 +501,7 @@ void ProxyWindowBase::setUpdatesEnabled(bool updatesEnabled) {
 	if (updatesEnabled == this->mUpdatesEnabled) return;
 	this->mUpdatesEnabled = updatesEnabled;
 
-	if (this->window != nullptr) {
-		QQuickWindowPrivate::get(this->window)->updatesEnabled = updatesEnabled;
-
-		// The render loop discards expose and update requests while updates are disabled,
-		// which can leave the surface without a valid buffer. Render a frame to recover.
-		if (updatesEnabled) this->window->update();
-	}
+	if (this->window != nullptr) this->window->setUpdatesEnabled(updatesEnabled);
 
 	emit this->updatesEnabledChanged();
 }
@@ -620,13 +622,17 @@ namespace {
 QList<std::function<void(QQuickWindow*)>> SCENEGRAPH_INIT_CALLBACKS; // NOLINT
 }
 
-QsQuickWindowBase::QsQuickWindowBase(QWindow* parent): QQuickWindow(parent) {
+QsQuickWindowBase::QsQuickWindowBase(QWindow* parent)
+    : QQuickWindow(parent)
+    , mFrameStats(new FrameStatsCollector(this)) {
 	QObject::connect(
 	    this,
 	    &QQuickWindow::sceneGraphInitialized,
 	    this,
 	    &ProxiedWindow::onSceneGraphInitialized
 	);
+
+	StartupTrace::trackWindow(this);
 }
 
 void QsQuickWindowBase::onSceneGraphInitialized() {
@@ -641,15 +647,78 @@ void QsQuickWindowBase::callOnScenegraphInit(std::function<void(QQuickWindow*)>
 	SCENEGRAPH_INIT_CALLBACKS.emplaceBack(cb);
 }
 
+ProxiedWindow::ProxiedWindow(ProxyWindowBase* proxy, QWindow* parent)
+    : QsQuickWindowBase(parent)
+    , mProxy(proxy) {
+	this->throttleTimer.setSingleShot(true);
+	this->throttleTimer.setTimerType(Qt::PreciseTimer);
+	QObject::connect(&this->throttleTimer, &QTimer::timeout, this, &QWindow::requestUpdate);
+
+	QObject::connect(
+	    PowerState::instance(),
+	    &PowerState::powerSavingChanged,
+	    this,
+	    &ProxiedWindow::updateRenderState
+	);
+}
+
+void ProxiedWindow::setUpdatesEnabled(bool updatesEnabled) {
+	this->mUpdatesEnabled = updatesEnabled;
+	this->updateRenderState();
+}
+
+void ProxiedWindow::updateRenderState() {
+	// Qt only stops rendering unexposed windows. In power saving mode, they also stop
+	// polishing and scheduling frames for animations until exposed again.
+	auto enabled = this->mUpdatesEnabled
+	            && (this->isExposed() || !PowerState::instance()->powerSaving());
+
+	auto* d = QQuickWindowPrivate::get(this);
+	if (enabled == d->updatesEnabled) return;
+	d->updatesEnabled = enabled;
+
+	// The render loop discards expose and update requests while updates are disabled,
+	// which can leave the surface without a valid buffer. Render a frame to recover.
+	if (enabled) this->update();
+}
+
+bool ProxiedWindow::throttleUpdateRequest() {
+	auto* powerState = PowerState::instance();
+
+	if (!powerState->powerSaving() || !this->lastUpdateRequest.isValid()) {
+		this->lastUpdateRequest.start();
+		return false;
+	}
+
+	auto interval = 1000000000 / powerState->maxFrameRate();
+	auto elapsed = this->lastUpdateRequest.nsecsElapsed();
+
+	if (elapsed >= interval) {
+		this->lastUpdateRequest.start();
+		return false;
+	}
+
+	// Animations are advanced by elapsed time, so delaying frames only lowers their frame rate.
+	if (!this->throttleTimer.isActive()) {
+		this->throttleTimer.start(static_cast<int>((interval - elapsed + 999999) / 1000000));
+	}
+
+	return true;
+}
+
 bool ProxiedWindow::event(QEvent* event) {
 	if (event->type() == QEvent::DevicePixelRatioChange) {
 		emit this->devicePixelRatioChanged();
+	} else if (event->type() == QEvent::UpdateRequest && this->throttleUpdateRequest()) {
+		return true;
 	}
 
 	return this->QQuickWindow::event(event);
 }
 
 void ProxiedWindow::exposeEvent(QExposeEvent* event) {
+	// Updates must be enabled before the render loop handles the expose.
+	this->updateRenderState();
 	this->QQuickWindow::exposeEvent(event);
 	emit this->exposed();
 }
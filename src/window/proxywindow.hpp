@@ -4,6 +4,7 @@
 
 #include <qcolor.h>
 #include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
 #include <qevent.h>
 #include <qnamespace.h>
 #include <qobject.h>
@@ -14,6 +15,7 @@
 #include <qquickitem.h>
 #include <qquickwindow.h>
 #include <qsurfaceformat.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
@@ -23,6 +25,7 @@
 #include "../core/qmlscreen.hpp"
 #include "../core/region.hpp"
 #include "../core/reload.hpp"
+#include "framestats.hpp"
 #include "windowinterface.hpp"
 
 class ProxiedWindow;
@@ -60,6 +63,7 @@ class ProxyWindowBase: public Reloadable {
 	Q_PROPERTY(bool backingWindowVisible READ isVisibleDirect NOTIFY backerVisibilityChanged);
 	Q_PROPERTY(QsSurfaceFormat surfaceFormat READ surfaceFormat WRITE setSurfaceFormat NOTIFY surfaceFormatChanged);
 	Q_PROPERTY(bool updatesEnabled READ updatesEnabled WRITE setUpdatesEnabled NOTIFY updatesEnabledChanged);
+	Q_PROPERTY(WindowFrameStats* frameStats READ frameStats CONSTANT);
 	Q_PROPERTY(QQmlListProperty<QObject> data READ data);
 	// clang-format on
 	Q_CLASSINFO("DefaultProperty", "data");
@@ -150,6 +154,8 @@ public:
 
 	[[nodiscard]] QObject* windowTransform() const { return nullptr; } // NOLINT
 
+	[[nodiscard]] WindowFrameStats* frameStats() const { return this->mFrameStats; }
+
 	[[nodiscard]] QQmlListProperty<QObject> data();
 
 signals:
@@ -194,6 +200,7 @@ protected:
 	PendingRegion* mMask = nullptr;
 	ProxiedWindow* window = nullptr;
 	ProxyWindowContentItem* mContentItem = nullptr;
+	WindowFrameStats* mFrameStats = nullptr;
 	bool reloadComplete = false;
 	bool ranLints = false;
 	bool mUpdatesEnabled = true;
@@ -260,21 +267,26 @@ public:
 
 	static void callOnScenegraphInit(std::function<void(QQuickWindow*)> cb);
 
+	[[nodiscard]] FrameStatsCollector* frameStats() const { return this->mFrameStats; }
+
 private slots:
 	void onSceneGraphInitialized();
+
+private:
+	FrameStatsCollector* mFrameStats;
 };
 
 class ProxiedWindow: public QsQuickWindowBase {
 	Q_OBJECT;
 
 public:
-	explicit ProxiedWindow(ProxyWindowBase* proxy, QWindow* parent = nullptr)
-	    : QsQuickWindowBase(parent)
-	    , mProxy(proxy) {}
+	explicit ProxiedWindow(ProxyWindowBase* proxy, QWindow* parent = nullptr);
 
 	[[nodiscard]] ProxyWindowBase* proxy() const { return this->mProxy; }
 	void setProxy(ProxyWindowBase* proxy) { this->mProxy = proxy; }
 
+	void setUpdatesEnabled(bool updatesEnabled);
+
 signals:
 	void exposed();
 	void devicePixelRatioChanged();
@@ -283,8 +295,16 @@ protected:
 	bool event(QEvent* event) override;
 	void exposeEvent(QExposeEvent* event) override;
 
+private slots:
+	void updateRenderState();
+
 private:
+	bool throttleUpdateRequest();
+
 	ProxyWindowBase* mProxy;
+	bool mUpdatesEnabled = true;
+	QElapsedTimer lastUpdateRequest;
+	QTimer throttleTimer;
 };
 
 class ProxyWindowContentItem: public QQuickItem {
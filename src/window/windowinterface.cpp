@@ -8,6 +8,7 @@
 
 #include "../core/qmlscreen.hpp"
 #include "../core/region.hpp"
+#include "framestats.hpp"
 #include "proxywindow.hpp"
 
 QPointF WindowInterface::itemPosition(QQuickItem* item) const {
@@ -39,6 +40,11 @@ QsWindowAttached::QsWindowAttached(QQuickItem* parent): QObject(parent) {
 	QObject::connect(parent, &QQuickItem::windowChanged, this, &QsWindowAttached::updateWindow);
 }
 
+WindowFrameStats* QsWindowAttached::frameStats() const {
+	auto* proxyWindow = this->proxyWindow();
+	return proxyWindow ? proxyWindow->frameStats() : nullptr;
+}
+
 QPointF QsWindowAttached::itemPosition(QQuickItem* item) const {
 	if (auto* proxyWindow = this->proxyWindow()) {
 		return proxyWindow->itemPosition(item);
@@ -130,6 +136,7 @@ void WindowInterface::setSurfaceFormat(QsSurfaceFormat format) const { this->pro
 bool WindowInterface::updatesEnabled() const { return this->proxyWindow()->updatesEnabled(); };
 void WindowInterface::setUpdatesEnabled(bool updatesEnabled) const { this->proxyWindow()->setUpdatesEnabled(updatesEnabled); };
 
+WindowFrameStats* WindowInterface::frameStats() const { return this->proxyWindow()->frameStats(); };
 QQmlListProperty<QObject> WindowInterface::data() const { return this->proxyWindow()->data(); };
 // clang-format on
 
@@ -11,6 +11,7 @@
 #include "../core/qmlscreen.hpp"
 #include "../core/region.hpp"
 #include "../core/reload.hpp"
+#include "framestats.hpp"
 
 class ProxyWindowBase;
 class QsWindowAttached;
@@ -42,6 +43,7 @@ public:
 /// It provides the following properties
 /// - `window` - the `QSWindow` object.
 /// - `contentItem` - the `contentItem` property of the window.
+/// - `frameStats` - the @@FrameStats of the window.
 ///
 /// @@itemPosition(), @@itemRect(), and @@mapFromItem() can also be called directly
 /// on the attached object.
@@ -152,6 +154,8 @@ class WindowInterface: public Reloadable {
 	/// When set back to true, a new frame is rendered, including any changes made
 	/// while updates were disabled.
 	Q_PROPERTY(bool updatesEnabled READ updatesEnabled WRITE setUpdatesEnabled NOTIFY updatesEnabledChanged);
+	/// Rendering statistics for the window.
+	Q_PROPERTY(WindowFrameStats* frameStats READ frameStats CONSTANT);
 	Q_PROPERTY(QQmlListProperty<QObject> data READ data);
 	// clang-format on
 	Q_CLASSINFO("DefaultProperty", "data");
@@ -243,6 +247,8 @@ public:
 	[[nodiscard]] bool updatesEnabled() const;
 	void setUpdatesEnabled(bool updatesEnabled) const;
 
+	[[nodiscard]] WindowFrameStats* frameStats() const;
+
 	[[nodiscard]] QQmlListProperty<QObject> data() const;
 
 	static QsWindowAttached* qmlAttachedProperties(QObject* object);
@@ -280,12 +286,14 @@ class QsWindowAttached: public QObject {
 	Q_OBJECT;
 	Q_PROPERTY(QObject* window READ window NOTIFY windowChanged);
 	Q_PROPERTY(QQuickItem* contentItem READ contentItem NOTIFY windowChanged);
+	Q_PROPERTY(WindowFrameStats* frameStats READ frameStats NOTIFY windowChanged);
 	QML_ANONYMOUS;
 
 public:
 	[[nodiscard]] virtual QObject* window() const = 0;
 	[[nodiscard]] virtual ProxyWindowBase* proxyWindow() const = 0;
 	[[nodiscard]] virtual QQuickItem* contentItem() const = 0;
+	[[nodiscard]] WindowFrameStats* frameStats() const;
 
 	Q_INVOKABLE [[nodiscard]] QPointF itemPosition(QQuickItem* item) const;
 	Q_INVOKABLE [[nodiscard]] QRectF itemRect(QQuickItem* item) const;
@@ -140,35 +140,65 @@ void I3Ipc::reconnectIPC() {
 
 QVector<Event> I3Ipc::parseResponse() {
 	QVector<Event> events;
+	const auto headerSize = static_cast<qsizetype>(MAGIC.size() + 2 * sizeof(qint32));
 
 	while (true) {
 		this->eventReader.startTransaction();
-		auto magic = this->eventReader.readBytes(6);
-		auto size = this->eventReader.readI32();
-		auto type = this->eventReader.readI32();
-		auto payload = this->eventReader.readBytes(size);
-		if (!this->eventReader.commitTransaction()) return events;
 
-		if (magic.size() < 6 || strncmp(magic.data(), MAGIC.data(), 6) != 0) {
+		// Views point into the reader's buffer and are invalidated by the next read,
+		// so the header is decoded before the payload is requested.
+		auto header = this->eventReader.readView(headerSize);
+		if (header.size() != headerSize) {
+			this->eventReader.commitTransaction();
+			return events;
+		}
+
+		if (!header.startsWith(QByteArrayView(MAGIC.data(), MAGIC.size()))) {
 			qCWarning(logI3Ipc) << "No magic sequence found in string.";
 			this->reconnectIPC();
 			break;
 		}
 
-		if (I3IpcEvent::intToEvent(type) == EventCode::Unknown) {
+		qint32 size = 0;
+		quint32 type = 0;
+		memcpy(&size, header.data() + MAGIC.size(), sizeof(qint32));                   // NOLINT
+		memcpy(&type, header.data() + MAGIC.size() + sizeof(qint32), sizeof(quint32)); // NOLINT
+
+		if (size < 0) {
+			qCWarning(logI3Ipc) << "Received message with invalid size" << size;
+			this->reconnectIPC();
+			break;
+		}
+
+		auto payload = this->eventReader.readView(size);
+		if (payload.size() != size) {
+			this->eventReader.commitTransaction();
+			return events;
+		}
+
+		auto code = I3IpcEvent::intToEvent(type);
+
+		if (code == EventCode::Unknown) {
 			qCWarning(logI3Ipc) << "Received unknown event";
+			this->eventReader.commitTransaction();
 			break;
 		}
 
 		// Importing this makes CI builds fail for some reason.
 		QJsonParseError e; // NOLINT (misc-include-cleaner)
 
-		auto data = QJsonDocument::fromJson(payload, &e);
+		// fromRawData avoids copying the payload out of the reader's buffer.
+		// The document does not reference the input after parsing.
+		auto data =
+		    QJsonDocument::fromJson(QByteArray::fromRawData(payload.data(), payload.size()), &e);
+
+		this->eventReader.commitTransaction();
+
 		if (e.error != QJsonParseError::NoError) {
 			qCWarning(logI3Ipc) << "Invalid JSON value:" << e.errorString();
 			break;
 		} else {
-			events.push_back(std::tuple(I3IpcEvent::intToEvent(type), data));
+			events.push_back(std::tuple(code, data));
 		}
 	}
 
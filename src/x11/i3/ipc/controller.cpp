@@ -5,6 +5,7 @@
 #include <qbytearrayview.h>
 #include <qcontainerfwd.h>
 #include <qdatastream.h>
+#include <qiodevice.h>
 #include <qjsonarray.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
@@ -12,7 +13,9 @@
 #include <qlocalsocket.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qnamespace.h>
 #include <qobject.h>
+#include <qobjectdefs.h>
 #include <qsysinfo.h>
 #include <qtenvironmentvariables.h>
 #include <qtypes.h>
@@ -20,6 +23,7 @@
 #include "../../../core/logcat.hpp"
 #include "../../../core/model.hpp"
 #include "../../../core/qmlscreen.hpp"
+#include "../../../core/recovery.hpp"
 #include "connection.hpp"
 #include "monitor.hpp"
 #include "workspace.hpp"
@@ -45,6 +49,10 @@ I3IpcController::I3IpcController(): I3Ipc({"workspace", "output"}) {
 }
 
 void I3IpcController::onConnected() {
+	// Responses to requests sent on a previous connection will never arrive.
+	this->workspaceRefreshInFlight = false;
+	this->monitorRefreshInFlight = false;
+
 	// Workspaces must be refreshed before monitors or no focus will be
 	// detected on launch.
 	this->refreshWorkspaces();
@@ -78,6 +86,7 @@ I3IpcController* I3IpcController::instance() {
 
 	if (instance == nullptr) {
 		instance = new I3IpcController();
+		instance->restoreRecoverySnapshot();
 		instance->connect();
 	}
 
@@ -85,11 +94,46 @@ I3IpcController* I3IpcController::instance() {
 }
 
 void I3IpcController::refreshWorkspaces() {
-	this->makeRequest(I3Ipc::buildRequestMessage(EventCode::GetWorkspaces));
+	this->workspaceRefreshPending = true;
+	this->scheduleRefresh();
+}
+
+void I3IpcController::refreshMonitors() {
+	this->monitorRefreshPending = true;
+	this->scheduleRefresh();
+}
+
+void I3IpcController::scheduleRefresh() {
+	if (this->refreshScheduled) return;
+	this->refreshScheduled = true;
+
+	QMetaObject::invokeMethod(this, &I3IpcController::flushRefreshes, Qt::QueuedConnection);
+}
+
+void I3IpcController::flushRefreshes() {
+	this->refreshScheduled = false;
+	if (!this->valid) return;
+
+	// Workspaces are requested first, matching the order required on connection.
+	if (this->workspaceRefreshPending && !this->workspaceRefreshInFlight) {
+		this->workspaceRefreshPending = false;
+		this->workspaceRefreshInFlight = true;
+		this->makeRequest(I3Ipc::buildRequestMessage(EventCode::GetWorkspaces));
+	}
+
+	if (this->monitorRefreshPending && !this->monitorRefreshInFlight) {
+		this->monitorRefreshPending = false;
+		this->monitorRefreshInFlight = true;
+		this->makeRequest(I3Ipc::buildRequestMessage(EventCode::GetOutputs));
+	}
 }
 
 void I3IpcController::handleGetWorkspacesEvent(I3IpcEvent* event) {
+	this->workspaceRefreshInFlight = false;
+	if (this->workspaceRefreshPending) this->scheduleRefresh();
+
 	auto data = event->mData;
+	this->lastWorkspaces = data;
 
 	auto workspaces = data.array();
 
@@ -141,12 +185,12 @@ void I3IpcController::handleGetWorkspacesEvent(I3IpcEvent* event) {
 	}
 }
 
-void I3IpcController::refreshMonitors() {
-	this->makeRequest(I3Ipc::buildRequestMessage(EventCode::GetOutputs));
-}
-
 void I3IpcController::handleGetOutputsEvent(I3IpcEvent* event) {
+	this->monitorRefreshInFlight = false;
+	if (this->monitorRefreshPending) this->scheduleRefresh();
+
 	auto data = event->mData;
+	this->lastOutputs = data;
 
 	auto monitors = data.array();
 	const auto& mList = this->mMonitors.valueList();
@@ -198,6 +242,37 @@ void I3IpcController::handleGetOutputsEvent(I3IpcEvent* event) {
 	}
 }
 
+void I3IpcController::restoreRecoverySnapshot() {
+	auto* recovery = RecoverySnapshot::instance();
+	auto stream = QDataStream(recovery->take("i3"));
+	auto workspaces = QJsonDocument();
+	auto outputs = QJsonDocument();
+	stream >> workspaces >> outputs;
+
+	// Replaced by the responses to the requests made on connection, in the same order.
+	if (stream.status() == QDataStream::Ok) {
+		qCDebug(logI3Ipc) << "Restoring workspaces and outputs from before a crash";
+
+		auto event = I3IpcEvent(nullptr);
+		event.mCode = EventCode::GetWorkspaces;
+		event.mData = workspaces;
+		this->handleGetWorkspacesEvent(&event);
+
+		event.mCode = EventCode::GetOutputs;
+		event.mData = outputs;
+		this->handleGetOutputsEvent(&event);
+	}
+
+	recovery->addSource("i3", [this]() {
+		if (this->lastOutputs.isNull()) return QByteArray();
+
+		auto data = QByteArray();
+		auto stream = QDataStream(&data, QIODevice::WriteOnly);
+		stream << this->lastWorkspaces << this->lastOutputs;
+		return data;
+	});
+}
+
 void I3IpcController::onEvent(I3IpcEvent* event) {
 	switch (event->mCode) {
 	case EventCode::Workspace: this->handleWorkspaceEvent(event); return;
@@ -267,13 +342,20 @@ void I3IpcController::handleWorkspaceEvent(I3IpcEvent* event) {
 		}
 
 		auto* newWorkspace = this->findWorkspaceByName(newName);
+		auto existed = newWorkspace != nullptr;
 
-		if (newWorkspace == nullptr) {
+		if (!existed) {
 			newWorkspace = new I3Workspace(this);
 		}
 
 		newWorkspace->updateFromObject(newData.toObject().toVariantMap());
 
+		// The focus event carries the full workspace object, so a workspace created
+		// without a preceding init event can be added without a full refresh.
+		if (!existed) {
+			this->mWorkspaces.insertObjectSorted(newWorkspace, &I3IpcController::compareWorkspaces);
+		}
+
 		if (newWorkspace->bindableMonitor().value()) {
 			auto* monitor = newWorkspace->bindableMonitor().value();
 			monitor->setActiveWorkspace(newWorkspace);
@@ -292,9 +374,12 @@ void I3IpcController::handleWorkspaceEvent(I3IpcEvent* event) {
 			qCInfo(logI3Ipc) << "Workspace" << name << "has already been deleted";
 		}
 	} else if (change == "move" || change == "rename" || change == "urgent") {
-		auto name = event->mData["current"]["name"].toString();
+		auto workspaceData = event->mData["current"];
+		auto name = workspaceData["name"].toString();
 
-		auto* workspace = this->findWorkspaceByName(name);
+		// A renamed workspace can only be found by its id, as the payload carries the new name.
+		auto* workspace = this->findWorkspaceByID(workspaceData["id"].toInt(-1));
+		if (workspace == nullptr) workspace = this->findWorkspaceByName(name);
 
 		if (workspace != nullptr) {
 			auto data = event->mData["current"].toObject().toVariantMap();
@@ -316,7 +401,7 @@ I3Monitor* I3IpcController::monitorFor(QuickshellScreenInfo* screen) {
 }
 
 I3Workspace* I3IpcController::findWorkspaceByID(qint32 id) {
-	auto list = this->mWorkspaces.valueList();
+	const auto& list = this->mWorkspaces.valueList();
 	auto workspaceIter =
 	    std::ranges::find_if(list, [id](I3Workspace* m) { return m->bindableId().value() == id; });
 
@@ -324,7 +409,7 @@ I3Workspace* I3IpcController::findWorkspaceByID(qint32 id) {
 }
 
 I3Workspace* I3IpcController::findWorkspaceByName(const QString& name) {
-	auto list = this->mWorkspaces.valueList();
+	const auto& list = this->mWorkspaces.valueList();
 	auto workspaceIter = std::ranges::find_if(list, [name](I3Workspace* m) {
 		return m->bindableName().value() == name;
 	});
@@ -333,7 +418,7 @@ I3Workspace* I3IpcController::findWorkspaceByName(const QString& name) {
 }
 
 I3Monitor* I3IpcController::findMonitorByName(const QString& name, bool createIfMissing) {
-	auto list = this->mMonitors.valueList();
+	const auto& list = this->mMonitors.valueList();
 	auto monitorIter = std::ranges::find_if(list, [name](I3Monitor* m) {
 		return m->bindableName().value() == name;
 	});
@@ -67,12 +67,28 @@ private slots:
 private:
 	explicit I3IpcController();
 
+	void scheduleRefresh();
+	void flushRefreshes();
+
 	void handleWorkspaceEvent(I3IpcEvent* event);
 	void handleGetWorkspacesEvent(I3IpcEvent* event);
 	void handleGetOutputsEvent(I3IpcEvent* event);
+	void restoreRecoverySnapshot();
 	static void handleRunCommand(I3IpcEvent* event);
 	static bool compareWorkspaces(I3Workspace* a, I3Workspace* b);
 
+	// Refresh requests made within one event loop turn are coalesced into a single
+	// request, and are not sent again while a previous request is still in flight.
+	bool refreshScheduled = false;
+	bool workspaceRefreshPending = false;
+	bool workspaceRefreshInFlight = false;
+	bool monitorRefreshPending = false;
+	bool monitorRefreshInFlight = false;
+
+	// last full responses, kept for recovery snapshots
+	QJsonDocument lastWorkspaces;
+	QJsonDocument lastOutputs;
+
 	ObjectModel<I3Monitor> mMonitors {this};
 	ObjectModel<I3Workspace> mWorkspaces {this};
 
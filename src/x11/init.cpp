@@ -10,6 +10,7 @@
 namespace {
 
 class X11Plugin: public QsEnginePlugin {
+	QString name() override { return "x11"; }
 	QList<QString> dependencies() override { return {"window"}; }
 
 	bool applies() override { return QGuiApplication::platformName() == "xcb"; }